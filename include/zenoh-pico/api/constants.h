@@ -175,6 +175,17 @@ typedef enum { Z_REPLY_TAG_DATA = 0, Z_REPLY_TAG_FINAL = 1 } z_reply_tag_t;
 typedef enum { Z_CONGESTION_CONTROL_BLOCK = 0, Z_CONGESTION_CONTROL_DROP = 1 } z_congestion_control_t;
 #define Z_CONGESTION_CONTROL_DEFAULT Z_CONGESTION_CONTROL_BLOCK
 
+/**
+ * Drop policy values, applied to the messages with ``DROP`` congestion control when the TX queue is full.
+ *
+ * Enumerators:
+ *     Z_DROP_POLICY_NEWEST: The message being sent is dropped.
+ *     Z_DROP_POLICY_OLDEST: The oldest message of the queue is dropped to make room for the message being sent,
+ *         if it has ``DROP`` congestion control itself. Otherwise, the message being sent is dropped.
+ */
+typedef enum { Z_DROP_POLICY_NEWEST = 0, Z_DROP_POLICY_OLDEST = 1 } zp_drop_policy_t;
+#define Z_DROP_POLICY_DEFAULT Z_DROP_POLICY_NEWEST
+
 /**
  * Priority of Zenoh messages values.
  *
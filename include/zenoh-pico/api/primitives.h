@@ -1266,6 +1266,129 @@ int8_t zp_start_lease_task(z_session_t zs, const zp_task_lease_options_t *option
  */
 int8_t zp_stop_lease_task(z_session_t zs);
 
+/**
+ * Constructs the default values for the session write task.
+ *
+ * Returns:
+ *   Returns the constructed :c:type:`zp_task_write_options_t`.
+ */
+zp_task_write_options_t zp_task_write_options_default(void);
+
+/**
+ * Start a separate task to send the zenoh messages on the network.
+ *
+ * While this task is running, the publishing operations only enqueue their messages and return, and the task
+ * batches them on the link. It is only available on unicast transports, when zenoh-pico is built with ``Z_TX_QUEUE``.
+ * Note that the task can be implemented in form of thread, process, etc. and its implementation is platform-dependent.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` where to start the write task.
+ *   options: The options to apply when starting the write task. If ``NULL`` is passed, the default options will be
+ * applied.
+ *
+ * Returns:
+ *   Returns ``0`` if the write task started successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_start_write_task(z_session_t zs, const zp_task_write_options_t *options);
+
+/**
+ * Stop the write task, once the messages it has been handed over are sent, and wait for it to return.
+ *
+ * This may result in stopping a thread or a process depending on the target platform.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` where to stop the write task.
+ *
+ * Returns:
+ *   Returns ``0`` if the write task stopped successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_stop_write_task(z_session_t zs);
+
+/**
+ * Get the counters of the zenoh messages discarded because of congestion by the TX path of a session.
+ *
+ * Messages are only discarded when the TX queue is full, according to the options given to
+ * :c:func:`zp_start_write_task`, or when they cannot be sent right away while the write task is not running.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` to get the counters from.
+ *   stats: A pointer to the :c:type:`zp_tx_stats_t` where to store the counters.
+ *
+ * Returns:
+ *   Returns ``0`` if the counters are available, or a ``negative value`` otherwise.
+ */
+int8_t zp_tx_stats(z_session_t zs, zp_tx_stats_t *stats);
+
+/**
+ * Constructs the default values for the session executor task.
+ *
+ * Returns:
+ *   Returns the constructed :c:type:`zp_task_executor_options_t`.
+ */
+zp_task_executor_options_t zp_task_executor_options_default(void);
+
+/**
+ * Start a pool of tasks running the callbacks of the subscribers and queryables declared with the ``executor``
+ * option, so that the read task hands their samples and queries over to it instead of waiting for them to be
+ * processed. The callbacks of a given subscriber or queryable are still run one at a time, in reception order.
+ * It is only available when zenoh-pico is built with ``Z_EXECUTOR``.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` where to start the executor task.
+ *   options: The options to apply when starting the executor task. If ``NULL`` is passed, the default options will
+ * be applied.
+ *
+ * Returns:
+ *   Returns ``0`` if the executor task started successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_start_executor_task(z_session_t zs, const zp_task_executor_options_t *options);
+
+/**
+ * Stop the executor task, once the callbacks it has been handed over are run. It must not be called from one of
+ * these callbacks.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` where to stop the executor task.
+ *
+ * Returns:
+ *   Returns ``0`` if the executor task stopped successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_stop_executor_task(z_session_t zs);
+
+/**
+ * Get the counters of the callbacks handed over to the executor of a session.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` to get the counters from.
+ *   stats: A pointer to the :c:type:`zp_executor_stats_t` where to store the counters.
+ *
+ * Returns:
+ *   Returns ``0`` if the counters are available, or a ``negative value`` otherwise.
+ */
+int8_t zp_executor_stats(z_session_t zs, zp_executor_stats_t *stats);
+
+/**
+ * Get the number of samples of a subscriber waiting for the executor to run its callback, or being processed by it.
+ *
+ * Parameters:
+ *   sub: A loaned instance of the the :c:type:`z_subscriber_t` to get the queue depth from.
+ *
+ * Returns:
+ *   Returns the queue depth, always ``0`` for subscribers not declared with the ``executor`` option.
+ */
+size_t zp_subscriber_queue_depth(z_subscriber_t sub);
+
+/**
+ * Get the number of queries of a queryable waiting for the executor to run its callback, or being processed by it.
+ *
+ * Parameters:
+ *   qable: A loaned instance of the the :c:type:`z_queryable_t` to get the queue depth from.
+ *
+ * Returns:
+ *   Returns the queue depth, always ``0`` for queryables not declared with the ``executor`` option.
+ */
+size_t zp_queryable_queue_depth(z_queryable_t qable);
+
 /************* Single Thread helpers **************/
 /**
  * Constructs the default values for the reading procedure.
@@ -1334,4 +1457,26 @@ zp_send_join_options_t zp_send_join_options_default(void);
  */
 int8_t zp_send_join(z_session_t zs, const zp_send_join_options_t *options);
 
+/**
+ * Constructs the default values for the flush operation.
+ *
+ * Returns:
+ *   Returns the constructed :c:type:`zp_flush_options_t`.
+ */
+zp_flush_options_t zp_flush_options_default(void);
+
+/**
+ * Sends the zenoh messages that are currently batched on the session transport.
+ *
+ * Batching is only performed when zenoh-pico is built with ``Z_TX_BATCHING``, otherwise this is a no-op.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` whose pending messages are to be sent.
+ *   options: The options to apply to the flush. If ``NULL`` is passed, the default options will be applied.
+ *
+ * Returns:
+ *   Returns ``0`` if the pending messages were sent successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_flush(z_session_t zs, const zp_flush_options_t *options);
+
 #endif /* ZENOH_PICO_API_PRIMITIVES_H */
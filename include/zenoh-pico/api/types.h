@@ -197,9 +197,12 @@ typedef _z_value_t z_value_t;
  *
  * Members:
  *   z_reliability_t reliability: The subscription reliability.
+ *   _Bool executor: Run the callback on the executor of the session, started via :c:func:`zp_start_executor_task`,
+ *     instead of on the read task. The callback is run inline while the executor is not running.
  */
 typedef struct {
     z_reliability_t reliability;
+    _Bool executor;
 } z_subscriber_options_t;
 
 /**
@@ -231,10 +234,13 @@ typedef struct {
  *   z_congestion_control_t congestion_control: The congestion control to apply when routing messages from this
  * publisher.
  *   z_priority_t priority: The priority of messages issued by this publisher.
+ *   _Bool express: If true, messages issued by this publisher are sent right away, together with the batch
+ * pending on the link if any, instead of waiting for the batch to be full or to expire.
  */
 typedef struct {
     z_congestion_control_t congestion_control;
     z_priority_t priority;
+    _Bool express;
 } z_publisher_options_t;
 
 /**
@@ -243,9 +249,12 @@ typedef struct {
  *
  * Members:
  *   _Bool complete: The completeness of the queryable.
+ *   _Bool executor: Run the callback on the executor of the session, started via :c:func:`zp_start_executor_task`,
+ *     instead of on the read task. The callback is run inline while the executor is not running.
  */
 typedef struct {
     _Bool complete;
+    _Bool executor;
 } z_queryable_options_t;
 
 /**
@@ -267,11 +276,14 @@ typedef struct {
  *   z_encoding_t encoding: The encoding of the payload.
  *   z_congestion_control_t congestion_control: The congestion control to apply when routing this message.
  *   z_priority_t priority: The priority of this message when routed.
+ *   _Bool express: If true, this message is sent right away, together with the batch pending on the link if any,
+ * instead of waiting for the batch to be full or to expire.
  */
 typedef struct {
     z_encoding_t encoding;
     z_congestion_control_t congestion_control;
     z_priority_t priority;
+    _Bool express;
 } z_put_options_t;
 
 /**
@@ -338,6 +350,58 @@ typedef struct {
     uint8_t __dummy;  // Just to avoid empty structures that might cause undefined behavior
 } zp_task_lease_options_t;
 
+/**
+ * Represents the set of options that can be applied to the write task,
+ * whenever issued via :c:func:`zp_start_write_task`.
+ *
+ * Members:
+ *   zp_drop_policy_t drop_policy: The messages to drop when the TX queue is full.
+ *   uint32_t block_timeout: The time in milliseconds a message with ``BLOCK`` congestion control waits for room in
+ *     the TX queue before being discarded. A value of 0 waits indefinitely.
+ */
+typedef struct {
+    zp_drop_policy_t drop_policy;
+    uint32_t block_timeout;
+} zp_task_write_options_t;
+
+/**
+ * Represents the counters of the zenoh messages discarded by the TX path of a session,
+ * as returned by :c:func:`zp_tx_stats`.
+ *
+ * Members:
+ *   size_t dropped: The number of messages with ``DROP`` congestion control dropped because of congestion.
+ *   size_t timed_out: The number of messages with ``BLOCK`` congestion control discarded after waiting for
+ *     ``block_timeout``.
+ */
+typedef struct {
+    size_t dropped;
+    size_t timed_out;
+} zp_tx_stats_t;
+
+/**
+ * Represents the set of options that can be applied to the executor task,
+ * whenever issued via :c:func:`zp_start_executor_task`.
+ *
+ * Members:
+ *   size_t workers: The number of worker threads running the callbacks.
+ */
+typedef struct {
+    size_t workers;
+} zp_task_executor_options_t;
+
+/**
+ * Represents the counters of the callbacks handed over to the executor of a session,
+ * as returned by :c:func:`zp_executor_stats`.
+ *
+ * Members:
+ *   size_t queued: The number of callbacks waiting to be run or running.
+ *   size_t high_water_mark: The highest number of callbacks that have been queued at once.
+ */
+typedef struct {
+    size_t queued;
+    size_t high_water_mark;
+} zp_executor_stats_t;
+
 /**
  * Represents the set of options that can be applied to the read operation,
  * whenever issued via :c:func:`zp_read`.
@@ -362,6 +426,14 @@ typedef struct {
     uint8_t __dummy;  // Just to avoid empty structures that might cause undefined behavior
 } zp_send_join_options_t;
 
+/**
+ * Represents the set of options that can be applied to the flush operation,
+ * whenever issued via :c:func:`zp_flush`.
+ */
+typedef struct {
+    uint8_t __dummy;  // Just to avoid empty structures that might cause undefined behavior
+} zp_flush_options_t;
+
 /**
  * Represents a data sample.
  *
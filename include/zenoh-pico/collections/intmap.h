@@ -30,7 +30,7 @@
  *
  * Members:
  *   size_t key: the hashed key of the value
- *   void *value: the value
+ *   void *value: the value, NULL if the entry is free
  */
 typedef struct {
     size_t _key;
@@ -38,16 +38,20 @@ typedef struct {
 } _z_int_void_map_entry_t;
 
 /**
- * An hashmap with integer keys.
+ * An hashmap with integer keys, whose entries are stored in place with open addressing and linear probing.
+ * The entries are lazily allocated, and reallocated twice as large once they are three quarters full.
+ * The values are released with the free function given to the operations removing them, which receives a pointer
+ * to the value.
  *
  * Members:
- *   z_intmap_t **vals: the linked intmap containing the values
- *   size_t capacity: the capacity of the hashmap
+ *   size_t capacity: the capacity of the hashmap, a power of 2
  *   size_t len: the actual length of the hashmap
+ *   _z_int_void_map_entry_t *vals: the entries of the hashmap
  */
 typedef struct {
     size_t _capacity;
-    _z_list_t **_vals;
+    size_t _len;
+    _z_int_void_map_entry_t *_vals;
 } _z_int_void_map_t;
 
 void _z_int_void_map_init(_z_int_void_map_t *map, size_t capacity);
@@ -66,12 +70,7 @@ void _z_int_void_map_free(_z_int_void_map_t **map, z_element_free_f f);
 
 #define _Z_INT_MAP_DEFINE(name, type)                                                                            \
     typedef _z_int_void_map_entry_t name##_intmap_entry_t;                                                       \
-    static inline void name##_intmap_entry_elem_free(void **e) {                                                 \
-        name##_intmap_entry_t *ptr = (name##_intmap_entry_t *)*e;                                                \
-        name##_elem_free((void **)&ptr->_val);                                                                   \
-        z_free(ptr);                                                                                             \
-        *e = NULL;                                                                                               \
-    }                                                                                                            \
+    static inline void name##_intmap_entry_elem_free(void **e) { name##_elem_free(e); }                          \
     typedef _z_int_void_map_t name##_intmap_t;                                                                   \
     static inline void name##_intmap_init(name##_intmap_t *m) {                                                  \
         _z_int_void_map_init(m, _Z_DEFAULT_INT_MAP_CAPACITY);                                                    \
@@ -228,6 +228,163 @@
 #define Z_BATCH_SIZE_TX 65535
 #endif
 
+/**
+ * Enable batching of zenoh messages on the unicast TX path.
+ * Consecutive zenoh messages with the same reliability are appended to the frame
+ * currently open in the TX buffer, which is then sent when it is full, when
+ * Z_TX_BATCHING_DEADLINE expires, or when explicitly flushed via :c:func:`zp_flush`.
+ */
+#ifndef Z_TX_BATCHING
+#define Z_TX_BATCHING 0
+#endif
+
+/**
+ * Default maximum time in milliseconds a batch is kept open before being sent.
+ * A value of 0 sends every batch right away.
+ */
+#ifndef Z_TX_BATCHING_DEADLINE
+#define Z_TX_BATCHING_DEADLINE 1
+#endif
+
+/**
+ * Decode the zenoh messages of received frames one at a time, each message being dispatched and its storage
+ * recycled before the next one is decoded, instead of decoding the whole frame before dispatching it.
+ * Memory used on reception then no longer depends on the number of messages carried by a frame.
+ */
+#ifndef Z_RX_STREAMING
+#define Z_RX_STREAMING 0
+#endif
+
+/**
+ * Maximum number of out-of-order frames held back per conduit and reliability, until the frames preceding them
+ * have been received so that all of them are handled in SN order. The missing frames are given up on once the window
+ * is full or after Z_RX_REORDER_TIMEOUT. A value of 0 drops any frame not following the last one handled.
+ */
+#ifndef Z_RX_REORDER_WINDOW
+#define Z_RX_REORDER_WINDOW 0
+#endif
+
+/**
+ * Time in milliseconds after which the frames held back by the reorder window are handled, giving up on the frames
+ * still missing before them. It is checked on the reception of the next frame or keep alive message.
+ */
+#ifndef Z_RX_REORDER_TIMEOUT
+#define Z_RX_REORDER_TIMEOUT 100
+#endif
+
+/**
+ * Number of entries of the cache of the subscriptions matching the keys made of a resource ID and a suffix, so that
+ * the samples published on a declared resource are dispatched without expanding nor matching their key again.
+ * It must be a power of 2, and a value of 0 disables the cache. The cached entries are invalidated whenever a
+ * resource or a subscription is declared or undeclared.
+ */
+#ifndef Z_SUBSCRIPTION_CACHE_SIZE
+#define Z_SUBSCRIPTION_CACHE_SIZE 16
+#endif
+
+/**
+ * Dispatch the samples without taking the session mutex: whenever a resource or a subscription is declared or
+ * undeclared, the session publishes an immutable snapshot of its local subscriptions and of the subscriptions matching
+ * each remote resource, which the read task then picks up with a single atomic load. Declarations copy the tables
+ * instead of stalling the reception of samples. Requires Z_MULTI_THREAD and C11 atomics.
+ */
+#ifndef Z_SUBSCRIPTION_SNAPSHOTS
+#define Z_SUBSCRIPTION_SNAPSHOTS 0
+#endif
+
+/**
+ * Enable the reactor: instead of starting a read and a lease task per session, :c:func:`zp_start_read_task` and
+ * :c:func:`zp_start_lease_task` attach the session to a single epoll instance shared by the whole process, whose
+ * Z_REACTOR_WORKERS threads dispatch the reads and run the lease and keep alive timers of all the sessions.
+ * Sessions on links that cannot be watched (e.g. serial) keep their own tasks. Requires Z_MULTI_THREAD and Linux.
+ */
+#ifndef Z_REACTOR
+#define Z_REACTOR 0
+#endif
+
+/**
+ * Number of worker threads of the reactor.
+ */
+#ifndef Z_REACTOR_WORKERS
+#define Z_REACTOR_WORKERS 2
+#endif
+
+/**
+ * Enable the callback executor of the sessions, started via :c:func:`zp_start_executor_task`.
+ * The callbacks of the subscribers and queryables declared with the ``executor`` option are then run by a pool of
+ * worker threads instead of the read task, each of them through its own FIFO queue so that they are still run one
+ * at a time and in reception order. Requires Z_MULTI_THREAD.
+ */
+#ifndef Z_EXECUTOR
+#define Z_EXECUTOR 0
+#endif
+
+/**
+ * Default number of worker threads of the callback executor.
+ */
+#ifndef Z_EXECUTOR_WORKERS
+#define Z_EXECUTOR_WORKERS 2
+#endif
+
+/**
+ * Enable the TX queue on unicast transports, drained by a write task started via :c:func:`zp_start_write_task`.
+ * While the write task is running, publishers only encode their zenoh messages in a slot of a bounded lock-free
+ * queue and return, and the write task batches them on the link. Requires Z_MULTI_THREAD and Z_TX_BATCHING.
+ */
+#ifndef Z_TX_QUEUE
+#define Z_TX_QUEUE 0
+#endif
+
+/**
+ * Number of slots of the TX queue. Must be a power of two.
+ */
+#ifndef Z_TX_QUEUE_SIZE
+#define Z_TX_QUEUE_SIZE 64
+#endif
+
+/**
+ * Default time in milliseconds a message with BLOCK congestion control waits for room in the TX queue
+ * before being discarded. A value of 0 waits indefinitely.
+ */
+#ifndef Z_TX_QUEUE_BLOCK_TIMEOUT
+#define Z_TX_QUEUE_BLOCK_TIMEOUT Z_TRANSPORT_LEASE
+#endif
+
+/**
+ * Size in bytes of the buffer preallocated in each slot of the TX queue.
+ * Larger messages are encoded in a buffer allocated on demand.
+ */
+#ifndef Z_TX_QUEUE_SLOT_SIZE
+#define Z_TX_QUEUE_SLOT_SIZE 1024
+#endif
+
+/**
+ * Maximum number of fragments sent at once on multicast links able to send bursts of datagrams with a single call
+ * (e.g. with sendmmsg and UDP GSO on Linux). The buffers for such bursts are only allocated on those links.
+ */
+#ifndef Z_TX_BURST_SIZE
+#define Z_TX_BURST_SIZE 64
+#endif
+
+/**
+ * Maximum number of datagrams received at once on multicast links able to receive bursts of datagrams with a single
+ * call (e.g. with recvmmsg on Linux). Each of them takes a buffer of the size of the link MTU, only allocated on
+ * those links.
+ */
+#ifndef Z_RX_BURST_SIZE
+#define Z_RX_BURST_SIZE 16
+#endif
+
+/**
+ * Enable QoS on unicast transports, if accepted by the remote peer during the INIT handshake.
+ * Once negotiated, each priority is given its own TX and RX conduit, with separate sequence numbers,
+ * TX batch and defragmentation buffers. Note that this multiplies the memory required by such buffers
+ * by the number of priorities.
+ */
+#ifndef Z_TRANSPORT_QOS
+#define Z_TRANSPORT_QOS 0
+#endif
+
 /**
  * Defaulf maximum size for fragmented messages.
  */
@@ -236,7 +393,8 @@
 #endif
 
 /**
- * Enable dynamic memory allocation.
+ * Enable dynamic memory allocation: the defragmentation buffers start empty and are grown on demand, up to
+ * Z_FRAG_MAX_SIZE, instead of being allocated at Z_FRAG_MAX_SIZE when a transport or a peer is set up.
  */
 #ifndef Z_DYNAMIC_MEMORY_ALLOCATION
 #define Z_DYNAMIC_MEMORY_ALLOCATION 0
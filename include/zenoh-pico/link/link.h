@@ -46,17 +46,23 @@
  *     Z_LINK_CAPABILITY_RELIEABLE: Bitmask to define and check if link is reliable.
  *     Z_LINK_CAPABILITY_STREAMED: Bitmask to define and check if link is streamed.
  *     Z_LINK_CAPABILITY_MULTICAST: Bitmask to define and check if link is multicast.
+ *     Z_LINK_CAPABILITY_BURST: Bitmask to define and check if link can send several messages with a single call.
  */
 typedef enum {
     Z_LINK_CAPABILITY_NONE = 0x00,       // 0
     Z_LINK_CAPABILITY_RELIEABLE = 0x01,  // 1 << 0
     Z_LINK_CAPABILITY_STREAMED = 0x02,   // 1 << 1
-    Z_LINK_CAPABILITY_MULTICAST = 0x04   // 1 << 2
+    Z_LINK_CAPABILITY_MULTICAST = 0x04,  // 1 << 2
+    Z_LINK_CAPABILITY_BURST = 0x08       // 1 << 3
 } _z_link_capabilities_t;
 
 #define _Z_LINK_IS_RELIABLE(X) ((X & Z_LINK_CAPABILITY_RELIEABLE) == Z_LINK_CAPABILITY_RELIEABLE)
 #define _Z_LINK_IS_STREAMED(X) ((X & Z_LINK_CAPABILITY_STREAMED) == Z_LINK_CAPABILITY_STREAMED)
 #define _Z_LINK_IS_MULTICAST(X) ((X & Z_LINK_CAPABILITY_MULTICAST) == Z_LINK_CAPABILITY_MULTICAST)
+#define _Z_LINK_IS_BURST(X) ((X & Z_LINK_CAPABILITY_BURST) == Z_LINK_CAPABILITY_BURST)
+
+// Maximum size of the address of the sender of a datagram, i.e. an IPv6 address and a port
+#define _Z_LINK_ADDR_MAX_SIZE 18
 
 struct _z_link_t;  // Forward declaration to be used in _z_f_link_*
 
@@ -65,7 +71,10 @@ typedef int8_t (*_z_f_link_listen)(struct _z_link_t *self);
 typedef void (*_z_f_link_close)(struct _z_link_t *self);
 typedef size_t (*_z_f_link_write)(const struct _z_link_t *self, const uint8_t *ptr, size_t len);
 typedef size_t (*_z_f_link_write_all)(const struct _z_link_t *self, const uint8_t *ptr, size_t len);
+typedef size_t (*_z_f_link_writev)(const struct _z_link_t *self, const _z_wbuf_t *wbf);
+typedef size_t (*_z_f_link_write_burst)(const struct _z_link_t *self, const _z_wbuf_t *wbfs, size_t n);
 typedef size_t (*_z_f_link_read)(const struct _z_link_t *self, uint8_t *ptr, size_t len, _z_bytes_t *addr);
+typedef size_t (*_z_f_link_read_burst)(const struct _z_link_t *self, _z_zbuf_t *zbfs, _z_bytes_t *addrs, size_t n);
 typedef size_t (*_z_f_link_read_exact)(const struct _z_link_t *self, uint8_t *ptr, size_t len, _z_bytes_t *addr);
 typedef void (*_z_f_link_free)(struct _z_link_t *self);
 
@@ -92,7 +101,10 @@ typedef struct _z_link_t {
     _z_f_link_close _close_f;
     _z_f_link_write _write_f;
     _z_f_link_write_all _write_all_f;
+    _z_f_link_writev _writev_f;            // Optional, NULL if not supported by the platform
+    _z_f_link_write_burst _write_burst_f;  // Only set if the link has Z_LINK_CAPABILITY_BURST
     _z_f_link_read _read_f;
+    _z_f_link_read_burst _read_burst_f;  // Optional, NULL if not supported by the platform
     _z_f_link_read_exact _read_exact_f;
     _z_f_link_free _free_f;
 
@@ -107,8 +119,19 @@ void _z_link_free(_z_link_t **zn);
 _z_link_p_result_t _z_open_link(const char *locator);
 _z_link_p_result_t _z_listen_link(const char *locator);
 
+/**
+ * Check if a wbuf made of several ioslices is delivered as a single message on the link,
+ * either because the link is streamed or because all ioslices are sent at once.
+ */
+_Bool _z_link_is_scatter_gather(const _z_link_t *link);
 int8_t _z_link_send_wbuf(const _z_link_t *link, const _z_wbuf_t *wbf);
+int8_t _z_link_send_wbuf_burst(const _z_link_t *link, const _z_wbuf_t *wbfs, size_t n);
 size_t _z_link_recv_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, _z_bytes_t *addr);
+size_t _z_link_recv_zbuf_burst(const _z_link_t *link, _z_zbuf_t *zbfs, _z_bytes_t *addrs, size_t n);
+#if defined(_Z_SYS_WAKER)
+const _z_sys_net_socket_t *_z_link_get_rx_socket(const _z_link_t *link);
+_Bool _z_link_wait_readable(const _z_link_t *link, const _z_waker_t *waker);
+#endif
 size_t _z_link_recv_exact_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, size_t len, _z_bytes_t *addr);
 
 #endif /* ZENOH_PICO_LINK_H */
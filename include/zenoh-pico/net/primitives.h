@@ -77,12 +77,15 @@ int8_t _z_undeclare_resource(_z_session_t *zn, const _z_zint_t rid);
  *     zn: The zenoh-net session. The caller keeps its ownership.
  *     keyexpr:  The resource key to publish. The callee gets the ownership
  *              of any allocated value.
+ *     congestion_control: The congestion control of the writes of this publisher.
+ *     priority: The priority of the writes of this publisher.
+ *     is_express: If the writes of this publisher are sent right away, rather than batched.
  *
  * Returns:
  *    The created :c:type:`_z_publisher_t` or null if the declaration failed.
  */
 _z_publisher_t *_z_declare_publisher(_z_session_t *zn, _z_keyexpr_t keyexpr, z_congestion_control_t congestion_control,
-                                     z_priority_t priority);
+                                     z_priority_t priority, _Bool is_express);
 
 /**
  * Undeclare a :c:type:`_z_publisher_t`.
@@ -106,12 +109,14 @@ int8_t _z_undeclare_publisher(_z_publisher_t *pub);
  *               The callee gets the ownership of any allocated value.
  *     callback: The callback function that will be called each time a data matching the subscribed resource is
  * received. arg: A pointer that will be passed to the **callback** on each call.
+ *     is_executed: Run the **callback** on the executor of the session while it is started, instead of inline.
  *
  * Returns:
  *    The created :c:type:`_z_subscriber_t` or null if the declaration failed.
  */
 _z_subscriber_t *_z_declare_subscriber(_z_session_t *zn, _z_keyexpr_t keyexpr, _z_subinfo_t sub_info,
-                                       _z_data_handler_t callback, _z_drop_handler_t dropper, void *arg);
+                                       _z_data_handler_t callback, _z_drop_handler_t dropper, void *arg,
+                                       _Bool is_executed);
 
 /**
  * Undeclare a :c:type:`_z_subscriber_t`.
@@ -134,12 +139,14 @@ int8_t _z_undeclare_subscriber(_z_subscriber_t *sub);
  *     complete: The complete of :c:type:`_z_queryable_t`.
  *     callback: The callback function that will be called each time a matching query is received.
  *     arg: A pointer that will be passed to the **callback** on each call.
+ *     is_executed: Run the **callback** on the executor of the session while it is started, instead of inline.
  *
  * Returns:
  *    The created :c:type:`_z_queryable_t` or null if the declaration failed.
  */
 _z_queryable_t *_z_declare_queryable(_z_session_t *zn, _z_keyexpr_t keyexpr, _Bool complete,
-                                     _z_questionable_handler_t callback, _z_drop_handler_t dropper, void *arg);
+                                     _z_questionable_handler_t callback, _z_drop_handler_t dropper, void *arg,
+                                     _Bool is_executed);
 
 /**
  * Undeclare a :c:type:`_z_queryable_t`.
@@ -168,11 +175,29 @@ int8_t _z_undeclare_queryable(_z_queryable_t *qle);
  *     kind: The kind of the value.
  *     cong_ctrl: The congestion control of this write. Possible values defined
  *                in :c:type:`_z_congestion_control_t`.
+ *     priority: The priority of this write. Possible values defined in :c:type:`z_priority_t`.
+ *     is_express: If this write is sent right away, together with the batch pending on the link if any.
  * Returns:
  *     ``0`` in case of success, ``-1`` in case of failure.
  */
 int8_t _z_write(_z_session_t *zn, const _z_keyexpr_t keyexpr, const uint8_t *payload, const size_t len,
-                const _z_encoding_t encoding, const z_sample_kind_t kind, const z_congestion_control_t cong_ctrl);
+                const _z_encoding_t encoding, const z_sample_kind_t kind, const z_congestion_control_t cong_ctrl,
+                const z_priority_t priority, const _Bool is_express);
+
+/**
+ * Write data with a declared publisher. The key and data info of the message are not encoded again
+ * if the default encoding is used, since they have been encoded when declaring the publisher.
+ *
+ * Parameters:
+ *     pub: The :c:type:`_z_publisher_t` to write with. The caller keeps its ownership.
+ *     payload: The value to write.
+ *     len: The length of the value to write.
+ *     encoding: The encoding of the payload.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _z_publisher_put(const _z_publisher_t *pub, const uint8_t *payload, const size_t len,
+                        const _z_encoding_t encoding);
 
 /**
  * Pull data for a pull mode :c:type:`_z_subscriber_t`. The pulled data will be provided
@@ -26,6 +26,8 @@ typedef struct {
     _z_keyexpr_t _key;
     z_congestion_control_t _congestion_control;
     z_priority_t _priority;
+    _Bool _is_express;
+    _z_bytes_t _prefix;  // Key and data info of the samples put with the default encoding, encoded at declaration
 } _z_publisher_t;
 
 void _z_publisher_clear(_z_publisher_t *pub);
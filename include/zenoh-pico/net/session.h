@@ -15,10 +15,16 @@
 #ifndef ZENOH_PICO_SESSION_NETAPI_H
 #define ZENOH_PICO_SESSION_NETAPI_H
 
+#include "zenoh-pico/collections/intmap.h"
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/protocol/keyexpr_tree.h"
 #include "zenoh-pico/session/session.h"
 #include "zenoh-pico/utils/config.h"
 
+#if Z_SUBSCRIPTION_SNAPSHOTS == 1
+#include <stdatomic.h>
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 1
+
 /**
  * A zenoh-net session.
  */
@@ -36,19 +42,52 @@ typedef struct {
     // Session declarations
     _z_resource_list_t *_local_resources;
     _z_resource_list_t *_remote_resources;
+    // Index of the resources above by ID, and by key expression as declared
+    _z_int_void_map_t _local_resources_by_id;
+    _z_int_void_map_t _remote_resources_by_id;
+    _z_keyexpr_tree_t _local_resources_by_key;
+    _z_keyexpr_tree_t _remote_resources_by_key;
 
     // Session subscriptions
     _z_subscription_sptr_list_t *_local_subscriptions;
     _z_subscription_sptr_list_t *_remote_subscriptions;
+    // Index of the subscriptions above by key expression, to match the samples without scanning the lists
+    _z_keyexpr_tree_t _local_subscriptions_tree;
+    _z_keyexpr_tree_t _remote_subscriptions_tree;
+    _z_int_void_map_t _local_subscriptions_by_id;
+    _z_int_void_map_t _remote_subscriptions_by_id;
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0
+    // Subscriptions matching the last keys made of a resource ID, see Z_SUBSCRIPTION_CACHE_SIZE
+    _z_subscription_cache_entry_t _subscription_cache[Z_SUBSCRIPTION_CACHE_SIZE];
+    size_t _subscription_cache_gen;
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0
+#if Z_SUBSCRIPTION_SNAPSHOTS == 1
+    // Last snapshot of the tables above, read by the dispatch of the samples without taking _mutex_inner.
+    // Readers count themselves in the current epoch while they load the snapshot and take a reference on it, and a
+    // publication flips the epoch and retires the replaced snapshot, which is released once both counts have been
+    // seen at zero. The retired snapshots are only modified under _mutex_inner.
+    _Atomic(_z_subscription_snapshot_sptr_t *) _subscription_snapshot;
+    atomic_size_t _subscription_snapshot_epoch;
+    atomic_size_t _subscription_snapshot_readers[2];
+    _Atomic(_z_list_t *) _subscription_snapshot_retired;
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 1
 
     // Session queryables
     _z_questionable_sptr_list_t *_local_questionable;
     _z_pending_query_list_t *_pending_queries;
+    // Index of the queryables and of the pending queries above by ID
+    _z_int_void_map_t _local_questionable_by_id;
+    _z_int_void_map_t _pending_queries_by_id;
 
     // Session transport.
     // Zenoh-pico is considering a single transport per session.
     _z_transport_t *_tp;
     _z_transport_manager_t *_tp_manager;
+
+#if Z_EXECUTOR == 1
+    // Runs the callbacks of the subscriptions and queryables declared to be executed, once started
+    _z_executor_t _executor;
+#endif  // Z_EXECUTOR == 1
 } _z_session_t;
 
 /**
@@ -114,6 +153,16 @@ int8_t _zp_send_keep_alive(_z_session_t *z);
  */
 int8_t _zp_send_join(_z_session_t *z);
 
+/**
+ * Send the zenoh messages currently batched on the transport, if any.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_flush(_z_session_t *z);
+
 #if Z_MULTI_THREAD == 1
 /**
  * Start a separate task to read from the network and process the messages
@@ -166,4 +215,78 @@ int8_t _zp_start_lease_task(_z_session_t *z);
 int8_t _zp_stop_lease_task(_z_session_t *z);
 #endif  // Z_MULTI_THREAD == 1
 
+#if Z_TX_QUEUE == 1
+/**
+ * Start a separate task to send the zenoh messages enqueued by the publishing operations,
+ * batching them on the link. Only available on unicast transports.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ *     drop_policy: The messages to drop when the queue is full.
+ *     block_timeout: The time in milliseconds blocking messages wait for room in the queue, 0 to wait indefinitely.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_start_write_task(_z_session_t *z, zp_drop_policy_t drop_policy, uint32_t block_timeout);
+
+/**
+ * Stop the write task, once the enqueued messages are sent, and wait for it to return. This may result in
+ * stopping a thread or a process depending on the target platform.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_stop_write_task(_z_session_t *z);
+
+/**
+ * Get the number of zenoh messages dropped, and of blocking messages discarded after
+ * timing out, because of congestion.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ *     dropped: Where to store the number of dropped messages.
+ *     timed_out: Where to store the number of timed out messages.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_tx_stats(_z_session_t *z, size_t *dropped, size_t *timed_out);
+#endif  // Z_TX_QUEUE == 1
+
+#if Z_EXECUTOR == 1
+/**
+ * Start the workers running the callbacks of the subscriptions and queryables declared to be executed.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ *     workers: The number of worker tasks.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_start_executor_task(_z_session_t *z, size_t workers);
+
+/**
+ * Stop the workers of the executor, once the callbacks handed over to them are run.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_stop_executor_task(_z_session_t *z);
+
+/**
+ * Get the number of callbacks currently queued on the executor, and the highest number queued at once.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ *     queued: Where to store the number of queued callbacks.
+ *     high_water_mark: Where to store the highest number of queued callbacks.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_executor_stats(_z_session_t *z, size_t *queued, size_t *high_water_mark);
+#endif  // Z_EXECUTOR == 1
+
 #endif /* ZENOH_PICO_SESSION_NETAPI_H */
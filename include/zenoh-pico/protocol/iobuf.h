@@ -90,6 +90,8 @@ void _z_zbuf_free(_z_zbuf_t **zbf);
 /*------------------ WBuf ------------------*/
 typedef struct {
     _z_iosli_vec_t _ioss;
+    _z_iosli_vec_t _views;   // Ioslices released on reset, recycled to wrap bytes without allocating
+    _z_iosli_vec_t _spares;  // Ioslices released on reset by an expandable wbuf, recycled when it is expanded
     size_t _r_idx;
     size_t _w_idx;
     size_t _capacity;
@@ -117,7 +119,10 @@ _z_iosli_t *_z_wbuf_get_iosli(const _z_wbuf_t *wbf, size_t idx);
 size_t _z_wbuf_len_iosli(const _z_wbuf_t *wbf);
 
 _z_zbuf_t _z_wbuf_to_zbuf(const _z_wbuf_t *wbf);
+_z_zbuf_t _z_wbuf_as_zbuf(const _z_wbuf_t *wbf);
+int8_t _z_wbuf_reserve(_z_wbuf_t *wbf, size_t capacity);
 int8_t _z_wbuf_siphon(_z_wbuf_t *dst, _z_wbuf_t *src, size_t length);
+int8_t _z_wbuf_siphon_wrap(_z_wbuf_t *dst, _z_wbuf_t *src, size_t length);
 
 void _z_wbuf_copy(_z_wbuf_t *dst, const _z_wbuf_t *src);
 void _z_wbuf_reset(_z_wbuf_t *wbf);
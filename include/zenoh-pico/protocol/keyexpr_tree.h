@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_PROTOCOL_KEYEXPR_TREE_H
+#define ZENOH_PICO_PROTOCOL_KEYEXPR_TREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct __z_keyexpr_tree_node_t;
+
+/**
+ * An index of values by key expression, each node standing for a chunk of the key expressions, i.e. the part
+ * between two ``/``. The children of a node are either literal chunks, looked up in an open-addressing hash table,
+ * or wildcard chunks (``*``, ``**`` and chunks with ``$*``), which are kept apart so that finding the values whose key
+ * expression intersects a key without wildcards only walks the matching branches.
+ *
+ * The values are not owned by the tree, which only stores their pointers.
+ *
+ * Members:
+ *   struct __z_keyexpr_tree_node_t *_root: the node of the empty prefix, NULL until the first insertion
+ *   size_t _len: the number of values in the tree
+ *   size_t _gen: the generation of the last lookup, used to visit the values of each node once
+ */
+typedef struct {
+    struct __z_keyexpr_tree_node_t *_root;
+    size_t _len;
+    size_t _gen;
+} _z_keyexpr_tree_t;
+
+typedef _Bool (*_z_keyexpr_tree_eq_f)(const void *value, const void *arg);
+typedef void (*_z_keyexpr_tree_visit_f)(void *value, void *arg);
+
+_z_keyexpr_tree_t _z_keyexpr_tree_make(void);
+// Releases the nodes of the tree, not its values
+void _z_keyexpr_tree_clear(_z_keyexpr_tree_t *tree);
+
+int8_t _z_keyexpr_tree_insert(_z_keyexpr_tree_t *tree, const char *key, size_t len, void *value);
+// Removes the first value under the key expression for which eq returns true, if any
+void _z_keyexpr_tree_remove(_z_keyexpr_tree_t *tree, const char *key, size_t len, _z_keyexpr_tree_eq_f eq,
+                            const void *arg);
+
+// Returns the first value under the key expression for which eq returns true, or NULL if there is none
+void *_z_keyexpr_tree_get(const _z_keyexpr_tree_t *tree, const char *key, size_t len, _z_keyexpr_tree_eq_f eq,
+                          const void *arg);
+
+// Whether the key can be looked up with _z_keyexpr_tree_intersecting, i.e. whether it has no wildcards
+_Bool _z_keyexpr_tree_is_literal(const char *key, size_t len);
+// Visits once each value whose key expression intersects the key, which is expected to be literal
+void _z_keyexpr_tree_intersecting(_z_keyexpr_tree_t *tree, const char *key, size_t len,
+                                  _z_keyexpr_tree_visit_f visit, void *arg);
+// Same as _z_keyexpr_tree_intersecting, but without modifying the tree so that it can be looked up concurrently,
+// at the cost of visiting the values reached through several ``**`` chunks of their key expression several times
+void _z_keyexpr_tree_intersecting_readonly(const _z_keyexpr_tree_t *tree, const char *key, size_t len,
+                                           _z_keyexpr_tree_visit_f visit, void *arg);
+
+#endif /* ZENOH_PICO_PROTOCOL_KEYEXPR_TREE_H */
@@ -236,10 +236,14 @@ void _z_msg_clear_reply_context(_z_reply_context_t *rc);
 //
 //  7 6 5 4 3 2 1 0
 // +-+-+-+-+-+-+-+-+
-// | ID  |  Prio   |
+// | Prio|   ID    |
 // +-+-+-+---------+
 //
-// WARNING: zenoh-pico does not support priorities and QoS.
+// NOTE: zenoh-pico only encodes/decodes the Priority decorator of FRAME messages, that is on
+//       transports where QoS has been negotiated. Frames without decorator have the default priority.
+//
+#define _Z_PRIORITY_DECORATOR(p) ((uint8_t)(_Z_MID_PRIORITY | ((uint8_t)(p) << 5)))
+#define _Z_PRIORITY_FROM_DECORATOR(h) ((z_priority_t)((h) >> 5))
 
 /*=============================*/
 /*       Zenoh Messages        */
@@ -469,6 +473,7 @@ typedef struct {
     _z_keyexpr_t _key;
     _z_data_info_t _info;
     _z_payload_t _payload;
+    _z_bytes_t _prefix;  // Key and data info encoded beforehand, used in their place when encoding if not empty
 } _z_msg_data_t;
 void _z_msg_clear_data(_z_msg_data_t *msg);
 
@@ -561,6 +566,21 @@ void _z_msg_clear(_z_zenoh_message_t *m);
 _Z_ELEM_DEFINE(_z_zenoh_message, _z_zenoh_message_t, _z_noop_size, _z_msg_clear, _z_noop_copy)
 _Z_VEC_DEFINE(_z_zenoh_message, _z_zenoh_message_t)
 
+/*------------------ Zenoh Message Arena ------------------*/
+/**
+ * Storage the zenoh messages of received frames are decoded into. It is owned by a transport and reset after each
+ * batch: the released messages are kept and reused by the following batches, so that decoding does not allocate
+ * once the arena has grown to the largest batch received.
+ */
+typedef struct {
+    _z_zenoh_message_vec_t _messages;  // Messages decoded from the current batch
+    _z_zenoh_message_vec_t _free;      // Messages released by the previous batches, ready to be reused
+} _z_zenoh_message_arena_t;
+_z_zenoh_message_arena_t _z_zenoh_message_arena_make(size_t capacity);
+_z_zenoh_message_t *_z_zenoh_message_arena_push(_z_zenoh_message_arena_t *arena);
+void _z_zenoh_message_arena_reset(_z_zenoh_message_arena_t *arena);
+void _z_zenoh_message_arena_clear(_z_zenoh_message_arena_t *arena);
+
 /*------------------ Builders ------------------*/
 _z_reply_context_t *_z_msg_make_reply_context(_z_zint_t qid, _z_bytes_t replier_id, _Bool is_final);
 _z_declaration_t _z_msg_make_declaration_resource(_z_zint_t id, _z_keyexpr_t key);
@@ -940,10 +960,12 @@ void _z_t_msg_clear_ping_pong(_z_t_msg_ping_pong_t *msg, uint8_t header);
 typedef union {
     _z_payload_t _fragment;
     _z_zenoh_message_vec_t _messages;
+    _z_payload_t _encoded;  // Zenoh messages left to be decoded one at a time, see Z_RX_STREAMING
 } _z_frame_payload_t;
 typedef struct {
     _z_zint_t _sn;
     _z_frame_payload_t _payload;
+    z_priority_t _priority;  // Carried by the Priority decorator, if any
 } _z_t_msg_frame_t;
 void _z_t_msg_clear_frame(_z_t_msg_frame_t *msg, uint8_t header);
 
@@ -967,6 +989,7 @@ typedef struct {
     uint8_t _header;
 } _z_transport_message_t;
 void _z_t_msg_clear(_z_transport_message_t *msg);
+void _z_t_msg_clear_ar(_z_transport_message_t *msg, _z_zenoh_message_arena_t *arena);
 
 /*------------------ Builders ------------------*/
 _z_transport_message_t _z_t_msg_make_scout(z_whatami_t what, _Bool request_pid);
@@ -17,6 +17,14 @@
 
 #define _ZENOH_PICO_FRAME_MESSAGES_VEC_SIZE 32
 
+#include "zenoh-pico/config.h"
+
+#if Z_RX_STREAMING == 1
+#define _ZENOH_PICO_FRAME_ARENA_SIZE 1
+#else
+#define _ZENOH_PICO_FRAME_ARENA_SIZE _ZENOH_PICO_FRAME_MESSAGES_VEC_SIZE
+#endif
+
 #include "zenoh-pico/collections/element.h"
 #include "zenoh-pico/link/endpoint.h"
 #include "zenoh-pico/protocol/codec.h"
@@ -87,11 +95,24 @@ _Z_RESULT_DECLARE(_z_zenoh_message_t, zenoh_message)
 /*------------------ Transport Message ------------------*/
 _Z_DECLARE_ENCODE_NOH(transport_message);
 _Z_DECLARE_DECODE_NOH(transport_message);
+// Decodes the zenoh messages of a frame into the given arena, which owns them until it is reset.
+// If Z_RX_STREAMING is enabled, the zenoh messages are left encoded and decoded by _z_frame_decode_next.
+void _z_transport_message_decode_ar(_z_zbuf_t *zbf, _z_zenoh_message_arena_t *arena,
+                                    _z_transport_message_result_t *r);
+// Decodes the next zenoh message of a frame into the arena, releasing the previous one. Returns NULL once all the
+// messages of the frame have been decoded.
+_z_zenoh_message_t *_z_frame_decode_next(_z_t_msg_frame_t *msg, _z_zenoh_message_arena_t *arena);
+// Encodes and decodes the body of a frame, i.e. its SN and payload
+int8_t _z_frame_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_frame_t *msg);
+void _z_frame_decode_ar(_z_zbuf_t *zbf, uint8_t header, _z_zenoh_message_arena_t *arena, _z_frame_result_t *r);
 
 /*------------------ Zenoh Message ------------------*/
 _Z_DECLARE_ENCODE_NOH(zenoh_message);
 _Z_DECLARE_DECODE_NOH(zenoh_message);
 
+// Encodes the key and data info of a data message, i.e. its body up to the payload
+int8_t _z_data_prefix_encode(_z_wbuf_t *wbf, uint8_t header, const _z_msg_data_t *msg);
+
 #endif /* ZENOH_PICO_MSGCODEC_H */
 
 // NOTE: the following headers are for unit testing only
@@ -198,6 +219,7 @@ _z_ping_pong_result_t _z_ping_pong_decode(_z_zbuf_t *zbf);
 
 int8_t _z_frame_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_frame_t *msg);
 void _z_frame_decode_na(_z_zbuf_t *zbf, uint8_t header, _z_frame_result_t *r);
+void _z_frame_decode_ar(_z_zbuf_t *zbf, uint8_t header, _z_zenoh_message_arena_t *arena, _z_frame_result_t *r);
 _z_frame_result_t _z_frame_decode(_z_zbuf_t *zbf, uint8_t header);
 
 // /*------------------ Discovery Message ------------------*/
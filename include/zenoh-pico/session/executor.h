@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_SESSION_EXECUTOR_H
+#define ZENOH_PICO_SESSION_EXECUTOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/system/platform.h"
+
+#if Z_EXECUTOR == 1
+
+#if Z_MULTI_THREAD == 0
+#error "Z_EXECUTOR requires Z_MULTI_THREAD"
+#endif
+
+struct __z_executor_job_t;
+typedef void (*_z_executor_job_f)(struct __z_executor_job_t *job);
+
+/**
+ * A callback to be run by the executor. It is the first member of the structure holding the arguments of the
+ * callback, which is released by _free once the job has been run.
+ */
+typedef struct __z_executor_job_t {
+    struct __z_executor_job_t *_next;
+    _z_executor_job_f _run;
+    _z_executor_job_f _free;
+} _z_executor_job_t;
+
+/**
+ * The FIFO queue of the jobs of a subscription or of a queryable, which are run one at a time in order.
+ * A strand is scheduled, i.e. in the ready list of the executor or being run by a worker, while it has jobs.
+ */
+typedef struct __z_executor_strand_t {
+    struct __z_executor_strand_t *_next;
+    _z_executor_job_t *_head;
+    _z_executor_job_t *_tail;
+    size_t _depth;
+    _Bool _is_scheduled;
+} _z_executor_strand_t;
+
+/**
+ * A pool of workers running the jobs of the scheduled strands. All its state is protected by _mutex.
+ */
+typedef struct {
+    _z_mutex_t _mutex;
+    _z_condvar_t _cv;
+    _z_executor_strand_t *_ready_head;
+    _z_executor_strand_t *_ready_tail;
+    _z_task_t *_workers;
+    size_t _workers_num;
+    size_t _queued;
+    size_t _high_water_mark;
+    _Bool _is_running;
+} _z_executor_t;
+
+void _z_executor_strand_init(_z_executor_strand_t *strand);
+
+void _z_executor_init(_z_executor_t *ex);
+void _z_executor_clear(_z_executor_t *ex);
+
+int8_t _z_executor_start(_z_executor_t *ex, size_t workers);
+// Waits for the queued jobs to be run, it must not be called from a job
+int8_t _z_executor_stop(_z_executor_t *ex);
+_Bool _z_executor_is_running(_z_executor_t *ex);
+
+// Fails if the executor is not running, the job then remains owned by the caller
+int8_t _z_executor_push(_z_executor_t *ex, _z_executor_strand_t *strand, _z_executor_job_t *job);
+
+size_t _z_executor_strand_depth(_z_executor_t *ex, const _z_executor_strand_t *strand);
+void _z_executor_stats(_z_executor_t *ex, size_t *queued, size_t *high_water_mark);
+
+#endif  // Z_EXECUTOR == 1
+
+#endif /* ZENOH_PICO_SESSION_EXECUTOR_H */
@@ -30,5 +30,8 @@ _z_questionable_sptr_t *_z_register_questionable(_z_session_t *zn, _z_questionab
 int8_t _z_trigger_queryables(_z_session_t *zn, const _z_msg_query_t *query);
 void _z_unregister_questionable(_z_session_t *zn, _z_questionable_sptr_t *q);
 void _z_flush_questionables(_z_session_t *zn);
+#if Z_EXECUTOR == 1
+size_t _z_questionable_queue_depth(_z_session_t *zn, const _z_zint_t id);
+#endif  // Z_EXECUTOR == 1
 
 #endif /* ZENOH_PICO_SESSION_QUERYABLE_H */
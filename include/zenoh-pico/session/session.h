@@ -18,11 +18,14 @@
 #include <stdbool.h>
 
 #include "zenoh-pico/collections/element.h"
+#include "zenoh-pico/collections/intmap.h"
 #include "zenoh-pico/collections/list.h"
 #include "zenoh-pico/collections/pointer.h"
 #include "zenoh-pico/collections/string.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/protocol/keyexpr_tree.h"
+#include "zenoh-pico/session/executor.h"
 #include "zenoh-pico/transport/manager.h"
 
 /**
@@ -68,9 +71,19 @@ typedef struct {
 void _z_reply_clear(_z_reply_t *src);
 void _z_reply_free(_z_reply_t **hello);
 
+/**
+ * A resource, i.e. a key expression mapped to an ID so that it can be referred to by the ID and a suffix.
+ *
+ * Members:
+ *   _z_zint_t _id: The resource ID.
+ *   _z_keyexpr_t _key: The key expression as declared, possibly made of the ID of another resource and a suffix.
+ *   _z_string_t _expanded: The full key expression, null-terminated, resolved when the resource is registered so that
+ *     the keys referring to the resource are expanded without walking the chain of resource IDs.
+ */
 typedef struct {
     _z_zint_t _id;
     _z_keyexpr_t _key;
+    _z_string_t _expanded;
 } _z_resource_t;
 
 _Bool _z_resource_eq(const _z_resource_t *one, const _z_resource_t *two);
@@ -92,6 +105,10 @@ typedef struct {
     _z_data_handler_t _callback;
     _z_drop_handler_t _dropper;
     void *_arg;
+#if Z_EXECUTOR == 1
+    _Bool _is_executed;
+    _z_executor_strand_t _strand;  // The samples waiting for the executor to run the callback
+#endif  // Z_EXECUTOR == 1
 } _z_subscription_t;
 
 _Bool _z_subscription_eq(const _z_subscription_t *one, const _z_subscription_t *two);
@@ -102,6 +119,60 @@ _Z_ELEM_DEFINE(_z_subscriber, _z_subscription_t, _z_noop_size, _z_subscription_c
 _Z_ELEM_DEFINE(_z_subscription_sptr, _z_subscription_sptr_t, _z_noop_size, _z_subscription_sptr_drop, _z_noop_copy)
 _Z_LIST_DEFINE(_z_subscription_sptr, _z_subscription_sptr_t)
 
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0 || Z_SUBSCRIPTION_SNAPSHOTS == 1
+/**
+ * The expanded key of a resource ID and suffix, along with the local subscriptions matching it.
+ */
+typedef struct {
+    _z_keyexpr_t _key;
+    _z_subscription_sptr_list_t *_subs;
+} _z_subscription_match_t;
+
+void _z_subscription_match_clear(_z_subscription_match_t *match);
+
+_Z_POINTER_DEFINE(_z_subscription_match, _z_subscription_match);
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0 || Z_SUBSCRIPTION_SNAPSHOTS == 1
+
+#if Z_SUBSCRIPTION_SNAPSHOTS == 1
+#if Z_MULTI_THREAD == 0 || ZENOH_C_STANDARD == 99
+#error "Z_SUBSCRIPTION_SNAPSHOTS requires Z_MULTI_THREAD and C11 atomics"
+#endif
+
+/**
+ * A copy of the session tables needed to dispatch the samples, whose tables are never modified once published.
+ *
+ * Members:
+ *   _z_subscription_sptr_list_t *_subs: a reference on each local subscription
+ *   _z_keyexpr_tree_t _subs_tree: the index of the subscriptions above by key expression
+ *   _z_int_void_map_t _matches: the ``_z_subscription_match_t`` of each remote resource, by resource ID
+ *   uint8_t _busy_readers: once retired, a bit per reader count of the session not seen at zero since then
+ */
+typedef struct {
+    _z_subscription_sptr_list_t *_subs;
+    _z_keyexpr_tree_t _subs_tree;
+    _z_int_void_map_t _matches;
+    uint8_t _busy_readers;
+} _z_subscription_snapshot_t;
+
+void _z_subscription_snapshot_clear(_z_subscription_snapshot_t *snap);
+
+_Z_POINTER_DEFINE(_z_subscription_snapshot, _z_subscription_snapshot);
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 1
+
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0
+
+/**
+ * An entry of the subscription cache, which is valid while its generation is the one of the session.
+ * The match is shared with the samples being dispatched, so that replacing the entry does not release it under them.
+ */
+typedef struct {
+    _z_zint_t _rid;
+    char *_suffix;
+    size_t _gen;
+    _z_subscription_match_sptr_t _match;
+} _z_subscription_cache_entry_t;
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0
+
 typedef struct {
     _z_zint_t _id;
     _z_keyexpr_t _key;
@@ -119,6 +190,10 @@ typedef struct {
     _z_questionable_handler_t _callback;
     _z_drop_handler_t _dropper;
     void *_arg;
+#if Z_EXECUTOR == 1
+    _Bool _is_executed;
+    _z_executor_strand_t _strand;  // The queries waiting for the executor to run the callback
+#endif  // Z_EXECUTOR == 1
 } _z_questionable_t;
 
 _Bool _z_questionable_eq(const _z_questionable_t *one, const _z_questionable_t *two);
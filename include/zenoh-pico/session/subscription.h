@@ -27,6 +27,10 @@ int8_t _z_trigger_subscriptions(_z_session_t *zn, const _z_keyexpr_t keyexpr, co
                                 const _z_encoding_t encoding, const _z_zint_t kind, const _z_timestamp_t timestamp);
 void _z_unregister_subscription(_z_session_t *zn, uint8_t is_local, _z_subscription_sptr_t *sub);
 void _z_flush_subscriptions(_z_session_t *zn);
+void __unsafe_z_invalidate_subscription_cache(_z_session_t *zn);
+#if Z_EXECUTOR == 1
+size_t _z_subscription_queue_depth(_z_session_t *zn, const _z_zint_t id);
+#endif  // Z_EXECUTOR == 1
 
 /*------------------ Pull ------------------*/
 _z_zint_t _z_get_pull_id(_z_session_t *zn);
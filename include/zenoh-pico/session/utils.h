@@ -29,6 +29,6 @@ void _z_session_free(_z_session_t **zn);
 
 int8_t _z_handle_zenoh_message(_z_session_t *zn, _z_zenoh_message_t *z_msg);
 int8_t _z_send_z_msg(_z_session_t *zn, _z_zenoh_message_t *z_msg, z_reliability_t reliability,
-                     z_congestion_control_t cong_ctrl);
+                     z_congestion_control_t cong_ctrl, z_priority_t priority, _Bool is_express);
 
 #endif /* ZENOH_PICO_SESSION_UTILS_H */
@@ -18,6 +18,7 @@
 #include <stdint.h>
 
 #include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/protocol/iobuf.h"
 #include "zenoh-pico/system/platform.h"
 
 #if Z_LINK_TCP == 1
@@ -36,6 +37,9 @@ void _z_close_tcp(_z_sys_net_socket_t sock);
 size_t _z_read_exact_tcp(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
 size_t _z_read_tcp(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
 size_t _z_send_tcp(_z_sys_net_socket_t sock, const uint8_t *ptr, size_t len);
+#if defined(_Z_SYS_NET_SENDV)
+size_t _z_sendv_tcp(_z_sys_net_socket_t sock, const _z_wbuf_t *wbf);
+#endif
 #endif
 
 #endif /* ZENOH_PICO_SYSTEM_LINK_TCP_H */
@@ -18,6 +18,7 @@
 #include <stdint.h>
 
 #include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/protocol/iobuf.h"
 #include "zenoh-pico/system/platform.h"
 
 #if Z_LINK_UDP_UNICAST == 1 || Z_LINK_UDP_MULTICAST == 1
@@ -39,6 +40,12 @@ void _z_close_udp_unicast(_z_sys_net_socket_t sock);
 size_t _z_read_exact_udp_unicast(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
 size_t _z_read_udp_unicast(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
 size_t _z_send_udp_unicast(_z_sys_net_socket_t sock, const uint8_t *ptr, size_t len, _z_sys_net_endpoint_t rep);
+#if defined(_Z_SYS_NET_SENDV)
+size_t _z_sendv_udp_unicast(_z_sys_net_socket_t sock, const _z_wbuf_t *wbf, _z_sys_net_endpoint_t rep);
+#endif
+#if defined(_Z_SYS_NET_SENDMMSG)
+size_t _z_sendmmsg_udp_unicast(_z_sys_net_socket_t sock, const _z_wbuf_t *wbfs, size_t n, _z_sys_net_endpoint_t rep);
+#endif
 
 // Multicast
 _z_sys_net_socket_t _z_open_udp_multicast(_z_sys_net_endpoint_t rep, _z_sys_net_endpoint_t *lep, uint32_t tout,
@@ -50,6 +57,20 @@ size_t _z_read_exact_udp_multicast(_z_sys_net_socket_t sock, uint8_t *ptr, size_
 size_t _z_read_udp_multicast(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len, _z_sys_net_endpoint_t lep,
                              _z_bytes_t *ep);
 size_t _z_send_udp_multicast(_z_sys_net_socket_t sock, const uint8_t *ptr, size_t len, _z_sys_net_endpoint_t rep);
+#if defined(_Z_SYS_NET_SENDV)
+size_t _z_sendv_udp_multicast(_z_sys_net_socket_t sock, const _z_wbuf_t *wbf, _z_sys_net_endpoint_t rep);
+#endif
+#if defined(_Z_SYS_NET_SENDMMSG)
+size_t _z_sendmmsg_udp_multicast(_z_sys_net_socket_t sock, const _z_wbuf_t *wbfs, size_t n,
+                                 _z_sys_net_endpoint_t rep);
+#endif
+#if defined(_Z_SYS_NET_RECVMMSG)
+// Receives up to n datagrams, each one in its own zbuf. The address of the sender of each datagram is written in
+// the storage already wrapped by the matching addrs entry, whose len must be its capacity. Datagrams sent by the
+// local endpoint lep or truncated leave their slot empty. Returns the number of slots used, or SIZE_MAX on error.
+size_t _z_recvmmsg_udp_multicast(_z_sys_net_socket_t sock, _z_zbuf_t *zbfs, _z_bytes_t *addrs, size_t n,
+                                 _z_sys_net_endpoint_t lep);
+#endif
 #endif
 
 #endif /* ZENOH_PICO_SYSTEM_LINK_UDP_H */
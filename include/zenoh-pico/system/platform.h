@@ -69,8 +69,48 @@ int _z_condvar_free(_z_condvar_t *cv);
 
 int _z_condvar_signal(_z_condvar_t *cv);
 int _z_condvar_wait(_z_condvar_t *cv, _z_mutex_t *m);
+int _z_condvar_timedwait(_z_condvar_t *cv, _z_mutex_t *m, unsigned int time);  // The time is in milliseconds
+
+#if defined(_Z_SYS_WAKER)
+/*------------------ Waker ------------------*/
+// A signal is kept until a wait consumes it. If the waker could not be initialized, the waits end on timeouts.
+int8_t _z_waker_init(_z_waker_t *w);
+void _z_waker_free(_z_waker_t *w);
+
+void _z_waker_signal(const _z_waker_t *w);
+// Both return true if they have been woken up
+_Bool _z_waker_sleep_ms(const _z_waker_t *w, unsigned int time);
+_Bool _z_waker_wait_socket(const _z_waker_t *w, const _z_sys_net_socket_t *sock);  // Until the socket is readable
+#endif  // defined(_Z_SYS_WAKER)
 #endif  // Z_MULTI_THREAD == 1
 
+#if Z_REACTOR == 1
+#if (Z_MULTI_THREAD != 1) || !defined(ZENOH_LINUX)
+#error "Z_REACTOR requires Z_MULTI_THREAD and is only supported on Linux"
+#endif
+
+/*------------------ Reactor ------------------*/
+// Identifies a socket or a timer watched by the reactor, _Z_REACTOR_SOURCE_NONE if it is not attached
+typedef uint64_t _z_reactor_source_t;
+#define _Z_REACTOR_SOURCE_NONE ((_z_reactor_source_t)0)
+
+// Called when data can be read from a socket, returns false to stop watching it
+typedef _Bool (*_z_reactor_read_f)(void *arg);
+// Called when a timer expires, returns the delay in milliseconds before its next expiration or _Z_REACTOR_TIMER_STOP
+typedef uint32_t (*_z_reactor_timer_f)(void *arg);
+#define _Z_REACTOR_TIMER_STOP UINT32_MAX
+
+// The reactor is started along with its first source and stopped once its last source has been detached.
+// The callbacks of a given source are never run concurrently, but those of different sources are.
+int8_t _z_reactor_attach_socket(const _z_sys_net_socket_t *sock, _z_reactor_read_f f, void *arg,
+                                _z_reactor_source_t *src);
+int8_t _z_reactor_attach_timer(uint32_t delay, _z_reactor_timer_f f, void *arg, _z_reactor_source_t *src);
+// Runs the callback of an attached timer right away, instead of waiting for its delay
+void _z_reactor_fire_timer(const _z_reactor_source_t *src);
+// Waits for the callback of the source to return if it is running, it must not be called from that callback
+void _z_reactor_detach(_z_reactor_source_t *src);
+#endif  // Z_REACTOR == 1
+
 /*------------------ Sleep ------------------*/
 int z_sleep_us(unsigned int time);
 int z_sleep_ms(unsigned int time);
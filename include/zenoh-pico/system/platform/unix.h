@@ -28,8 +28,25 @@ typedef pthread_t _z_task_t;
 typedef pthread_attr_t _z_task_attr_t;
 typedef pthread_mutex_t _z_mutex_t;
 typedef pthread_cond_t _z_condvar_t;
+
+// Blocked tasks can be woken up from another thread, see _z_waker_* functions
+#define _Z_SYS_WAKER 1
+typedef struct {
+    int _rfd;
+    int _wfd;
+} _z_waker_t;
 #endif  // Z_MULTI_THREAD == 1
 
+// Vectored socket writes are supported, see _z_sendv_* functions
+#define _Z_SYS_NET_SENDV 1
+
+#if defined(ZENOH_LINUX)
+// Several datagrams can be sent with a single call, see _z_sendmmsg_* functions
+#define _Z_SYS_NET_SENDMMSG 1
+// Several datagrams can be received with a single call, see _z_recvmmsg_* functions
+#define _Z_SYS_NET_RECVMMSG 1
+#endif
+
 typedef struct timespec z_clock_t;
 typedef struct timeval z_time_t;
 
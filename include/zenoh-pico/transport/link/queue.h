@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_TRANSPORT_LINK_QUEUE_H
+#define ZENOH_PICO_TRANSPORT_LINK_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "zenoh-pico/api/constants.h"
+#include "zenoh-pico/collections/bytes.h"
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/protocol/msg.h"
+#include "zenoh-pico/system/platform.h"
+
+#if Z_TX_QUEUE == 1
+
+#if Z_MULTI_THREAD == 0 || Z_TX_BATCHING == 0 || ZENOH_C_STANDARD == 99
+#error "Z_TX_QUEUE requires Z_MULTI_THREAD, Z_TX_BATCHING and C11 atomics"
+#endif
+
+#include <stdatomic.h>
+
+/**
+ * A slot of the TX queue, holding one encoded zenoh message.
+ */
+typedef struct {
+    atomic_size_t _seq;
+    size_t _pos;
+
+    _z_wbuf_t _wbuf;    // Encoded message, if it fits in Z_TX_QUEUE_SLOT_SIZE
+    _z_zbuf_t _large;   // Encoded message if it does not fit in _wbuf, grown on demand to the largest one
+    _Bool _is_large;    // If the encoded message is stored in _large
+    _Bool _is_valid;    // If the slot holds a message to send
+    _Bool _is_droppable;  // If the message can be dropped on congestion, see Z_CONGESTION_CONTROL_DROP
+    _Bool _is_express;    // If the message must be sent right away, rather than batched
+    z_reliability_t _reliability;
+    z_priority_t _priority;
+} _z_tx_queue_slot_t;
+
+/**
+ * A bounded lock-free multi-producer multi-consumer queue of encoded zenoh messages.
+ *
+ * Claiming and releasing a slot are done in two steps, so that messages are encoded and
+ * sent in place: push_begin/push_end on the producer side, pop_begin/pop_end on the consumer side.
+ */
+typedef struct {
+    _z_tx_queue_slot_t *_slots;
+    size_t _mask;
+    atomic_size_t _head;
+    atomic_size_t _tail;
+
+    // Used only to put to sleep the consumer when the queue is empty,
+    // and the producers when the queue is full
+    _z_mutex_t _mutex;
+    _z_condvar_t _cv_not_empty;
+    _z_condvar_t _cv_not_full;
+    atomic_uint _waiting_not_empty;
+    atomic_uint _waiting_not_full;
+} _z_tx_queue_t;
+
+int8_t _z_tx_queue_init(_z_tx_queue_t *q);
+void _z_tx_queue_clear(_z_tx_queue_t *q);
+
+_z_tx_queue_slot_t *_z_tx_queue_push_begin(_z_tx_queue_t *q);
+void _z_tx_queue_push_end(_z_tx_queue_t *q, _z_tx_queue_slot_t *slot);
+_z_tx_queue_slot_t *_z_tx_queue_pop_begin(_z_tx_queue_t *q);
+void _z_tx_queue_pop_end(_z_tx_queue_t *q, _z_tx_queue_slot_t *slot);
+_z_tx_queue_slot_t *_z_tx_queue_pop_droppable_begin(_z_tx_queue_t *q);
+
+_Bool _z_tx_queue_is_empty(_z_tx_queue_t *q);
+void _z_tx_queue_wait_not_empty(_z_tx_queue_t *q, volatile _Bool *is_running);
+void _z_tx_queue_wait_not_full(_z_tx_queue_t *q, volatile _Bool *is_running, unsigned int timeout);
+// Waits for a message to be enqueued, or for the producers to be done with the queue
+void _z_tx_queue_wait_producers(_z_tx_queue_t *q, atomic_size_t *producers);
+void _z_tx_queue_wake_consumer(_z_tx_queue_t *q);
+void _z_tx_queue_notify(_z_tx_queue_t *q);
+
+int8_t _z_tx_queue_slot_encode(_z_tx_queue_slot_t *slot, const _z_zenoh_message_t *z_msg);
+_z_bytes_t _z_tx_queue_slot_bytes(const _z_tx_queue_slot_t *slot);
+void _z_tx_queue_slot_reset(_z_tx_queue_slot_t *slot);
+
+#endif  // Z_TX_QUEUE == 1
+
+#endif /* ZENOH_PICO_TRANSPORT_LINK_QUEUE_H */
@@ -28,6 +28,37 @@ _z_transport_message_result_t _z_link_recv_t_msg(const _z_link_t *zl);
 void _z_unicast_recv_t_msg_na(_z_transport_unicast_t *ztu, _z_transport_message_result_t *r);
 void _z_multicast_recv_t_msg_na(_z_transport_multicast_t *ztm, _z_transport_message_result_t *r, _z_bytes_t *addr);
 
+// Appends a fragment to a defragmentation buffer, which is grown as needed up to Z_FRAG_MAX_SIZE (if it was not
+// allocated at this size, see Z_DYNAMIC_MEMORY_ALLOCATION) so that the reassembled message can be decoded in place.
+// A message exceeding Z_FRAG_MAX_SIZE is dropped until it is reset.
+void _z_transport_defrag_append(_z_wbuf_t *dbuf, _Bool *is_dropping, const _z_payload_t *fragment);
+void _z_transport_defrag_reset(_z_wbuf_t *dbuf, _Bool *is_dropping);
+
+/**
+ * The reception state of the frames sent on a conduit with a given reliability, which share the same SN sequence.
+ */
+typedef struct {
+    void *_session;
+    _z_zenoh_message_arena_t *_arena;
+    _z_zint_t _sn_resolution;
+    _z_zint_t _sn_resolution_half;
+    _z_zint_t *_sn;  // SN of the last frame handled
+    _z_wbuf_t *_dbuf;
+    _Bool *_dbuf_dropping;
+#if Z_RX_REORDER_WINDOW > 0
+    _z_transport_reorder_t *_reorder;
+#endif  // Z_RX_REORDER_WINDOW > 0
+} _z_transport_rx_channel_t;
+
+// Handles the zenoh messages of a frame in SN order. Out-of-order frames are held back in the reorder window of the
+// channel if any, and dropped otherwise.
+void _z_transport_rx_channel_handle_frame(const _z_transport_rx_channel_t *ch, uint8_t header,
+                                          _z_t_msg_frame_t *frame);
+#if Z_RX_REORDER_WINDOW > 0
+// Handles the frames held back for more than Z_RX_REORDER_TIMEOUT, giving up on the frames missing before them
+void _z_transport_rx_channel_expire(const _z_transport_rx_channel_t *ch);
+#endif  // Z_RX_REORDER_WINDOW > 0
+
 int8_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_transport_message_t *t_msg);
 int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_transport_message_t *t_msg,
                                              _z_bytes_t *addr);
@@ -25,4 +25,15 @@ void *_zp_lease_task(void *zt_arg);             // The argument is void* to avoi
 void *_zp_unicast_lease_task(void *ztu_arg);    // The argument is void* to avoid incompatible pointer types in tasks
 void *_zp_multicast_lease_task(void *ztm_arg);  // The argument is void* to avoid incompatible pointer types in tasks
 
+#if (Z_TX_BATCHING == 1) && (Z_MULTI_THREAD == 1)
+// Wakes the lease task of a transport up, for it to send the batches left open once their deadline has passed
+void _zp_unicast_wake_lease(_z_transport_unicast_t *ztu);
+#endif  // (Z_TX_BATCHING == 1) && (Z_MULTI_THREAD == 1)
+
+#if Z_REACTOR == 1
+// Run the lease task of a transport on a timer of the reactor
+int8_t _zp_unicast_attach_lease(_z_transport_unicast_t *ztu);
+int8_t _zp_multicast_attach_lease(_z_transport_multicast_t *ztm);
+#endif  // Z_REACTOR == 1
+
 #endif /* ZENOH_PICO_TRANSPORT_LINK_TASK_LEASE_H */
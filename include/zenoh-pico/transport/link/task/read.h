@@ -25,4 +25,10 @@ void *_zp_read_task(void *zt_arg);             // The argument is void* to avoid
 void *_zp_unicast_read_task(void *ztu_arg);    // The argument is void* to avoid incompatible pointer types in tasks
 void *_zp_multicast_read_task(void *ztm_arg);  // The argument is void* to avoid incompatible pointer types in tasks
 
+#if Z_REACTOR == 1
+// Dispatch the reads of a transport from the reactor, if its link can be watched
+int8_t _zp_unicast_attach_read(_z_transport_unicast_t *ztu);
+int8_t _zp_multicast_attach_read(_z_transport_multicast_t *ztm);
+#endif  // Z_REACTOR == 1
+
 #endif /* ZENOH_PICO_TRANSPORT_LINK_TASK_READ_H */
\ No newline at end of file
@@ -0,0 +1,24 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_TRANSPORT_LINK_TASK_WRITE_H
+#define ZENOH_PICO_TRANSPORT_LINK_TASK_WRITE_H
+
+#include "zenoh-pico/transport/transport.h"
+
+void *_zp_unicast_write_task(void *ztu_arg);  // The argument is void* to avoid incompatible pointer types in tasks
+// Stops the write task and waits for it to return, once the messages it has been handed over are sent
+void _zp_unicast_stop_write_task(_z_transport_unicast_t *ztu);
+
+#endif /* ZENOH_PICO_TRANSPORT_LINK_TASK_WRITE_H */
@@ -21,19 +21,33 @@
 
 void __unsafe_z_prepare_wbuf(_z_wbuf_t *buf, _Bool is_streamed);
 void __unsafe_z_finalize_wbuf(_z_wbuf_t *buf, _Bool is_streamed);
-int8_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z_reliability_t reliability, size_t sn);
-_z_transport_message_t _z_frame_header(z_reliability_t reliability, _Bool is_fragment, _Bool is_final, _z_zint_t sn);
+int8_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z_priority_t priority,
+                                           z_reliability_t reliability, size_t sn, _Bool is_scatter_gather);
+_z_transport_message_t _z_frame_header(z_priority_t priority, z_reliability_t reliability, _Bool is_fragment,
+                                       _Bool is_final, _z_zint_t sn);
 
 /*------------------ Transmission and Reception helpers ------------------*/
 int8_t _z_unicast_send_z_msg(_z_session_t *zn, _z_zenoh_message_t *z_msg, z_reliability_t reliability,
-                             z_congestion_control_t cong_ctrl);
+                             z_congestion_control_t cong_ctrl, z_priority_t priority, _Bool is_express);
 int8_t _z_multicast_send_z_msg(_z_session_t *zn, _z_zenoh_message_t *z_msg, z_reliability_t reliability,
-                               z_congestion_control_t cong_ctrl);
+                               z_congestion_control_t cong_ctrl, z_priority_t priority, _Bool is_express);
+#if Z_TX_QUEUE == 1
+int8_t _z_unicast_send_encoded_z_msg(_z_transport_unicast_t *ztu, const _z_bytes_t *z_msg_bytes,
+                                     z_reliability_t reliability, z_priority_t priority, _Bool is_express);
+#endif  // Z_TX_QUEUE == 1
 
 int8_t _z_send_t_msg(_z_transport_t *zt, const _z_transport_message_t *t_msg);
 int8_t _z_unicast_send_t_msg(_z_transport_unicast_t *ztu, const _z_transport_message_t *t_msg);
 int8_t _z_multicast_send_t_msg(_z_transport_multicast_t *ztm, const _z_transport_message_t *t_msg);
 
+int8_t _z_flush(_z_transport_t *zt);
+int8_t _z_unicast_flush(_z_transport_unicast_t *ztu);
+#if Z_TX_BATCHING == 1
+// Sends the batches open for Z_TX_BATCHING_DEADLINE. If some are left open, is_open is set and next is lowered to the
+// time in milliseconds until the first of them is due.
+int8_t _z_unicast_flush_expired(_z_transport_unicast_t *ztu, _z_zint_t *next, _Bool *is_open);
+#endif  // Z_TX_BATCHING == 1
+
 int8_t _z_link_send_t_msg(const _z_link_t *zl, const _z_transport_message_t *t_msg);
 
 #endif /* ZENOH_PICO_TRANSPORT_LINK_TX_H */
@@ -21,11 +21,42 @@
 #include "zenoh-pico/link/link.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/msg.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/transport/link/queue.h"
 
+#if Z_RX_REORDER_WINDOW > 0
+// A frame received ahead of the frames preceding it, its body (SN and payload) being stored encoded
 typedef struct {
-    // Defragmentation buffers
+    _z_zint_t _sn;
+    uint8_t _header;
+    _z_zbuf_t _body;
+} _z_transport_reorder_slot_t;
+
+/**
+ * The frames of a reliability channel held back until the frames preceding them have been received,
+ * see Z_RX_REORDER_WINDOW.
+ */
+typedef struct {
+    _z_transport_reorder_slot_t _slots[Z_RX_REORDER_WINDOW + 1];  // One more for the frame making it overflow
+    size_t _len;
+    z_clock_t _since;  // Time at which the window last made progress, or started holding frames back if it has not
+} _z_transport_reorder_t;
+
+void _z_transport_reorder_init(_z_transport_reorder_t *ro);
+void _z_transport_reorder_clear(_z_transport_reorder_t *ro);
+void _z_transport_reorder_copy(_z_transport_reorder_t *dst, const _z_transport_reorder_t *src);
+#endif  // Z_RX_REORDER_WINDOW > 0
+
+typedef struct {
+    // Defragmentation buffers, and whether the message they reassemble is being dropped
     _z_wbuf_t _dbuf_reliable;
     _z_wbuf_t _dbuf_best_effort;
+    _Bool _dbuf_reliable_dropping;
+    _Bool _dbuf_best_effort_dropping;
+#if Z_RX_REORDER_WINDOW > 0
+    _z_transport_reorder_t _reorder_reliable;
+    _z_transport_reorder_t _reorder_best_effort;
+#endif  // Z_RX_REORDER_WINDOW > 0
 
     // SN numbers
     _z_zint_t _sn_resolution;
@@ -46,38 +77,121 @@ void _z_transport_peer_entry_copy(_z_transport_peer_entry_t *dst, const _z_trans
 _Bool _z_transport_peer_entry_eq(const _z_transport_peer_entry_t *left, const _z_transport_peer_entry_t *right);
 _Z_ELEM_DEFINE(_z_transport_peer_entry, _z_transport_peer_entry_t, _z_transport_peer_entry_size,
                _z_transport_peer_entry_clear, _z_transport_peer_entry_copy)
-_Z_LIST_DEFINE(_z_transport_peer_entry, _z_transport_peer_entry_t)
+
+/**
+ * An open-addressing hash table of peer entries, keyed by their remote address.
+ *
+ * Collisions are resolved with linear probing and removed entries are back-shifted, so that lookups never go
+ * through tombstones. The slots are allocated on the first insertion and doubled whenever the table gets 3/4 full.
+ *
+ * Members:
+ *   _z_transport_peer_entry_t **_slots: the slots of the table, NULL if empty
+ *   size_t _capacity: the number of slots, always a power of two
+ *   size_t _len: the number of entries in the table
+ */
+typedef struct {
+    _z_transport_peer_entry_t **_slots;
+    size_t _capacity;
+    size_t _len;
+} _z_transport_peer_table_t;
+
+typedef _Bool (*_z_transport_peer_entry_keep_f)(_z_transport_peer_entry_t *entry);
+
+_z_transport_peer_table_t _z_transport_peer_table_make(void);
+size_t _z_transport_peer_table_len(const _z_transport_peer_table_t *table);
+_z_transport_peer_entry_t *_z_transport_peer_table_get(const _z_transport_peer_table_t *table,
+                                                       const _z_bytes_t *remote_addr);
+int8_t _z_transport_peer_table_insert(_z_transport_peer_table_t *table, _z_transport_peer_entry_t *entry);
+void _z_transport_peer_table_remove(_z_transport_peer_table_t *table, _z_transport_peer_entry_t *entry);
+void _z_transport_peer_table_retain(_z_transport_peer_table_t *table, _z_transport_peer_entry_keep_f keep);
+_z_transport_peer_entry_t *_z_transport_peer_table_next(const _z_transport_peer_table_t *table, size_t *pos);
+void _z_transport_peer_table_clear(_z_transport_peer_table_t *table);
+
+/**
+ * Number of conduits instantiated by a unicast transport: one per priority if QoS is enabled, a single one otherwise.
+ */
+#if Z_TRANSPORT_QOS == 1
+#define _Z_TRANSPORT_CONDUITS_NUM Z_PRIORITIES_NUM
+#else
+#define _Z_TRANSPORT_CONDUITS_NUM 1
+#endif  // Z_TRANSPORT_QOS == 1
+
+typedef struct {
+#if Z_MULTI_THREAD == 1
+    // Serializes the access to the TX buffer and SN numbers of the conduit
+    _z_mutex_t _mutex;
+#endif  // Z_MULTI_THREAD == 1
+
+    // SN numbers
+    _z_zint_t _sn_reliable;
+    _z_zint_t _sn_best_effort;
+
+    // TX buffer
+    _z_wbuf_t _wbuf;
+
+    // Expandable buffer on which messages are encoded to be fragmented, reset and reused for each of them
+    _z_wbuf_t _fbuf;
+
+#if Z_TX_BATCHING == 1
+    // Frame currently open in the TX buffer
+    _Bool _batch_is_open;
+    z_reliability_t _batch_reliability;
+    z_clock_t _batch_start;
+#endif  // Z_TX_BATCHING == 1
+} _z_transport_tx_conduit_t;
+
+typedef struct {
+    // SN numbers
+    _z_zint_t _sn_reliable;
+    _z_zint_t _sn_best_effort;
+
+    // Defragmentation buffers, and whether the message they reassemble is being dropped
+    _z_wbuf_t _dbuf_reliable;
+    _z_wbuf_t _dbuf_best_effort;
+    _Bool _dbuf_reliable_dropping;
+    _Bool _dbuf_best_effort_dropping;
+#if Z_RX_REORDER_WINDOW > 0
+    _z_transport_reorder_t _reorder_reliable;
+    _z_transport_reorder_t _reorder_best_effort;
+#endif  // Z_RX_REORDER_WINDOW > 0
+} _z_transport_rx_conduit_t;
+
+// Size of the TX buffer of the transport messages of a unicast transport, i.e. KEEP_ALIVE and CLOSE messages:
+// a header, a PID along with its length and a reason, plus the message length on streamed links
+#define _Z_TRANSPORT_UNICAST_T_MSG_SIZE (_Z_MSG_LEN_ENC_SIZE + 3 + Z_ZID_LENGTH)
 
 typedef struct {
     // Session associated to the transport
     void *_session;
 
 #if Z_MULTI_THREAD == 1
-    // TX and RX mutexes
+    // RX mutex and link TX mutex, the latter being only held while writing on the link
     _z_mutex_t _mutex_rx;
     _z_mutex_t _mutex_tx;
 #endif  // Z_MULTI_THREAD == 1
 
-    // Defragmentation buffers
-    _z_wbuf_t _dbuf_reliable;
-    _z_wbuf_t _dbuf_best_effort;
-
-    // SN numbers
+    // SN resolution
     _z_zint_t _sn_resolution;
     _z_zint_t _sn_resolution_half;
-    _z_zint_t _sn_tx_reliable;
-    _z_zint_t _sn_tx_best_effort;
-    _z_zint_t _sn_rx_reliable;
-    _z_zint_t _sn_rx_best_effort;
+
+    // TX and RX conduits, indexed by priority if QoS has been negotiated
+    _Bool _is_qos;
+    _z_transport_tx_conduit_t _tx_conduits[_Z_TRANSPORT_CONDUITS_NUM];
+    _z_transport_rx_conduit_t _rx_conduits[_Z_TRANSPORT_CONDUITS_NUM];
 
     _z_bytes_t _remote_pid;
 
     // ----------- Link related -----------
-    // TX and RX buffers
+    // RX buffer
     const _z_link_t *_link;
-    _z_wbuf_t _wbuf;
     _z_zbuf_t _zbuf;
 
+    // TX buffer of the transport messages, which is only accessed under _mutex_tx
+    _z_wbuf_t _wbuf_t_msg;
+
+    // Arena on which the messages of the received frames are decoded
+    _z_zenoh_message_arena_t _arena;
+
     volatile _Bool _received;
     volatile _Bool _transmitted;
 
@@ -86,8 +200,48 @@ typedef struct {
     _z_task_t *_read_task;
     volatile _Bool _lease_task_running;
     _z_task_t *_lease_task;
+#if defined(_Z_SYS_WAKER)
+    // Signaled to stop the tasks while they wait for data or for the next lease check
+    _z_waker_t _read_waker;
+    _z_waker_t _lease_waker;
+#endif  // defined(_Z_SYS_WAKER)
+#if Z_TX_BATCHING == 1
+    // Set while a batch is left open, the lease task is then woken up to send it once its deadline has passed.
+    // It is only accessed under _mutex_tx, which is taken for it once per batch rather than once per message.
+    _Bool _batch_pending;
+#if !defined(_Z_SYS_WAKER)
+    _z_mutex_t _lease_mutex;
+    _z_condvar_t _lease_cv;
+    _Bool _lease_signaled;
+#endif  // !defined(_Z_SYS_WAKER)
+#endif  // Z_TX_BATCHING == 1
 #endif  // Z_MULTI_THREAD == 1
 
+#if Z_REACTOR == 1
+    // Sources of the reactor standing for the read and lease tasks, and the state of the lease timer
+    _z_reactor_source_t _read_source;
+    _z_reactor_source_t _lease_source;
+    _z_zint_t _lease_interval;
+    z_clock_t _lease_step;
+    _z_zint_t _next_lease;
+    _z_zint_t _next_keep_alive;
+#endif  // Z_REACTOR == 1
+
+#if Z_TX_QUEUE == 1
+    // Zenoh messages waiting to be sent by the write task
+    _z_tx_queue_t _tx_queue;
+    zp_drop_policy_t _tx_drop_policy;
+    uint32_t _tx_block_timeout;
+    volatile _Bool _write_task_running;
+    _z_task_t *_write_task;
+    // Producers that have seen the write task running, it only returns once they are done with their messages
+    atomic_size_t _tx_producers;
+
+    // Messages discarded because of congestion
+    atomic_size_t _tx_dropped;
+    atomic_size_t _tx_timed_out;
+#endif  // Z_TX_QUEUE == 1
+
     volatile _z_zint_t _lease;
 } _z_transport_unicast_t;
 
@@ -105,7 +259,7 @@ typedef struct {
 #endif  // Z_MULTI_THREAD == 1
 
     // Known valid peers
-    _z_transport_peer_entry_list_t *_peers;
+    _z_transport_peer_table_t _peers;
 
     // SN initial numbers
     _z_zint_t _sn_resolution;
@@ -119,6 +273,21 @@ typedef struct {
     _z_wbuf_t _wbuf;
     _z_zbuf_t _zbuf;
 
+    // Arena on which the messages of the received frames are decoded
+    _z_zenoh_message_arena_t _arena;
+
+    // TX buffers for fragment bursts, only allocated if the link has Z_LINK_CAPABILITY_BURST
+    _z_wbuf_t *_wbuf_burst;
+
+    // RX buffers for datagram bursts and the addresses of their senders, stored inline in _addr_burst_buf.
+    // Only allocated if the link has a _read_burst_f.
+    _z_zbuf_t *_zbuf_burst;
+    _z_bytes_t *_addr_burst;
+    uint8_t *_addr_burst_buf;
+
+    // Expandable buffer on which messages are encoded to be fragmented, reset and reused for each of them
+    _z_wbuf_t _fbuf;
+
     volatile _Bool _transmitted;
 
 #if Z_MULTI_THREAD == 1
@@ -126,8 +295,23 @@ typedef struct {
     _z_task_t *_read_task;
     volatile _Bool _lease_task_running;
     _z_task_t *_lease_task;
+#if defined(_Z_SYS_WAKER)
+    // Signaled to stop the tasks while they wait for data or for the next lease check
+    _z_waker_t _read_waker;
+    _z_waker_t _lease_waker;
+#endif  // defined(_Z_SYS_WAKER)
 #endif  // Z_MULTI_THREAD == 1
 
+#if Z_REACTOR == 1
+    // Sources of the reactor standing for the read and lease tasks, and the state of the lease timer
+    _z_reactor_source_t _read_source;
+    _z_reactor_source_t _lease_source;
+    _z_zint_t _lease_interval;
+    _z_zint_t _next_lease;
+    _z_zint_t _next_keep_alive;
+    _z_zint_t _next_join;
+#endif  // Z_REACTOR == 1
+
     volatile _z_zint_t _lease;
 } _z_transport_multicast_t;
 
@@ -169,6 +353,9 @@ typedef struct {
 
 _Z_RESULT_DECLARE(_z_transport_multicast_establish_param_t, transport_multicast_establish_param)
 
+size_t _z_transport_unicast_conduits_num(const _z_transport_unicast_t *ztu);
+size_t _z_transport_unicast_conduit_idx(const _z_transport_unicast_t *ztu, z_priority_t priority);
+
 _z_transport_t *_z_transport_unicast_new(_z_link_t *link, _z_transport_unicast_establish_param_t param);
 _z_transport_t *_z_transport_multicast_new(_z_link_t *link, _z_transport_multicast_establish_param_t param);
 
@@ -25,6 +25,7 @@
 #include "zenoh-pico/protocol/keyexpr.h"
 #include "zenoh-pico/session/queryable.h"
 #include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/session/subscription.h"
 #include "zenoh-pico/session/utils.h"
 
 /********* Data Types Handlers *********/
@@ -388,10 +389,11 @@ int8_t z_info_peers_zid(const z_session_t zs, z_owned_closure_zid_t *callback) {
 
 #if Z_MULTICAST_TRANSPORT == 1
     if (zs._val->_tp->_type == _Z_TRANSPORT_MULTICAST_TYPE) {
-        _z_transport_peer_entry_list_t *l = zs._val->_tp->_transport._multicast._peers;
-        for (; l != NULL; l = _z_transport_peer_entry_list_tail(l)) {
+        const _z_transport_peer_table_t *peers = &zs._val->_tp->_transport._multicast._peers;
+        size_t pos = 0;
+        for (_z_transport_peer_entry_t *val = _z_transport_peer_table_next(peers, &pos); val != NULL;
+             val = _z_transport_peer_table_next(peers, &pos)) {
             z_id_t id;
-            _z_transport_peer_entry_t *val = _z_transport_peer_entry_list_head(l);
 
             if (val->_remote_pid.len <= sizeof(id.id)) {
                 _z_bytes_t bs = val->_remote_pid;
@@ -457,7 +459,8 @@ z_id_t z_info_zid(const z_session_t zs) {
 z_put_options_t z_put_options_default(void) {
     return (z_put_options_t){.encoding = z_encoding_default(),
                              .congestion_control = Z_CONGESTION_CONTROL_DEFAULT,
-                             .priority = Z_PRIORITY_DEFAULT};
+                             .priority = Z_PRIORITY_DEFAULT,
+                             .express = false};
 }
 
 z_delete_options_t z_delete_options_default(void) {
@@ -473,9 +476,10 @@ int8_t z_put(z_session_t zs, z_keyexpr_t keyexpr, const uint8_t *payload, z_zint
         opt.congestion_control = options->congestion_control;
         opt.encoding = options->encoding;
         opt.priority = options->priority;
+        opt.express = options->express;
     }
     ret = _z_write(zs._val, keyexpr, (const uint8_t *)payload, payload_len, opt.encoding, Z_SAMPLE_KIND_PUT,
-                   opt.congestion_control);
+                   opt.congestion_control, opt.priority, opt.express);
 
     return ret;
 }
@@ -488,7 +492,8 @@ int8_t z_delete(z_session_t zs, z_keyexpr_t keyexpr, const z_delete_options_t *o
         opt.congestion_control = options->congestion_control;
         opt.priority = options->priority;
     }
-    ret = _z_write(zs._val, keyexpr, NULL, 0, z_encoding_default(), Z_SAMPLE_KIND_DELETE, opt.congestion_control);
+    ret = _z_write(zs._val, keyexpr, NULL, 0, z_encoding_default(), Z_SAMPLE_KIND_DELETE, opt.congestion_control,
+                   opt.priority, false);
 
     return ret;
 }
@@ -567,7 +572,8 @@ int8_t z_undeclare_keyexpr(z_session_t zs, z_owned_keyexpr_t *keyexpr) {
 }
 
 z_publisher_options_t z_publisher_options_default(void) {
-    return (z_publisher_options_t){.congestion_control = Z_CONGESTION_CONTROL_DEFAULT, .priority = Z_PRIORITY_DEFAULT};
+    return (z_publisher_options_t){
+        .congestion_control = Z_CONGESTION_CONTROL_DEFAULT, .priority = Z_PRIORITY_DEFAULT, .express = false};
 }
 
 z_owned_publisher_t z_declare_publisher(z_session_t zs, z_keyexpr_t keyexpr, z_publisher_options_t *options) {
@@ -592,9 +598,11 @@ z_owned_publisher_t z_declare_publisher(z_session_t zs, z_keyexpr_t keyexpr, z_p
     if (options != NULL) {
         opt.congestion_control = options->congestion_control;
         opt.priority = options->priority;
+        opt.express = options->express;
     }
 
-    return (z_owned_publisher_t){._value = _z_declare_publisher(zs._val, key, opt.congestion_control, opt.priority)};
+    return (z_owned_publisher_t){
+        ._value = _z_declare_publisher(zs._val, key, opt.congestion_control, opt.priority, opt.express)};
 }
 
 int8_t z_undeclare_publisher(z_owned_publisher_t *pub) {
@@ -623,8 +631,7 @@ int8_t z_publisher_put(const z_publisher_t pub, const uint8_t *payload, size_t l
         opt.encoding = options->encoding;
     }
 
-    ret = _z_write(pub._val->_zn, pub._val->_key, payload, len, opt.encoding, Z_SAMPLE_KIND_PUT,
-                   pub._val->_congestion_control);
+    ret = _z_publisher_put(pub._val, payload, len, opt.encoding);
 
     return ret;
 }
@@ -632,11 +639,11 @@ int8_t z_publisher_put(const z_publisher_t pub, const uint8_t *payload, size_t l
 int8_t z_publisher_delete(const z_publisher_t pub, const z_publisher_delete_options_t *options) {
     (void)(options);
     return _z_write(pub._val->_zn, pub._val->_key, NULL, 0, z_encoding_default(), Z_SAMPLE_KIND_DELETE,
-                    pub._val->_congestion_control);
+                    pub._val->_congestion_control, pub._val->_priority, pub._val->_is_express);
 }
 
 z_subscriber_options_t z_subscriber_options_default(void) {
-    return (z_subscriber_options_t){.reliability = Z_RELIABILITY_DEFAULT};
+    return (z_subscriber_options_t){.reliability = Z_RELIABILITY_DEFAULT, .executor = false};
 }
 
 z_pull_subscriber_options_t z_pull_subscriber_options_default(void) {
@@ -663,12 +670,14 @@ z_owned_subscriber_t z_declare_subscriber(z_session_t zs, z_keyexpr_t keyexpr, z
 #endif  // Z_MULTICAST_TRANSPORT == 1
 
     _z_subinfo_t subinfo = _z_subinfo_push_default();
+    _Bool is_executed = false;
     if (options != NULL) {
         subinfo.reliability = options->reliability;
+        is_executed = options->executor;
     }
 
     return (z_owned_subscriber_t){
-        ._value = _z_declare_subscriber(zs._val, key, subinfo, callback->call, callback->drop, ctx)};
+        ._value = _z_declare_subscriber(zs._val, key, subinfo, callback->call, callback->drop, ctx, is_executed)};
 }
 
 z_owned_pull_subscriber_t z_declare_pull_subscriber(z_session_t zs, z_keyexpr_t keyexpr,
@@ -692,7 +701,7 @@ z_owned_pull_subscriber_t z_declare_pull_subscriber(z_session_t zs, z_keyexpr_t
     }
 
     return (z_owned_pull_subscriber_t){
-        ._value = _z_declare_subscriber(zs._val, key, subinfo, callback->call, callback->drop, ctx)};
+        ._value = _z_declare_subscriber(zs._val, key, subinfo, callback->call, callback->drop, ctx, false)};
 }
 
 int8_t z_undeclare_subscriber(z_owned_subscriber_t *sub) {
@@ -716,7 +725,7 @@ int8_t z_undeclare_pull_subscriber(z_owned_pull_subscriber_t *sub) {
 int8_t z_subscriber_pull(const z_pull_subscriber_t sub) { return _z_subscriber_pull(sub._val); }
 
 z_queryable_options_t z_queryable_options_default(void) {
-    return (z_queryable_options_t){.complete = _Z_QUERYABLE_COMPLETE_DEFAULT};
+    return (z_queryable_options_t){.complete = _Z_QUERYABLE_COMPLETE_DEFAULT, .executor = false};
 }
 
 z_owned_queryable_t z_declare_queryable(z_session_t zs, z_keyexpr_t keyexpr, z_owned_closure_query_t *callback,
@@ -734,10 +743,11 @@ z_owned_queryable_t z_declare_queryable(z_session_t zs, z_keyexpr_t keyexpr, z_o
     z_queryable_options_t opt = z_queryable_options_default();
     if (options != NULL) {
         opt.complete = options->complete;
+        opt.executor = options->executor;
     }
 
-    return (z_owned_queryable_t){
-        ._value = _z_declare_queryable(zs._val, key, opt.complete, callback->call, callback->drop, ctx)};
+    return (z_owned_queryable_t){._value = _z_declare_queryable(zs._val, key, opt.complete, callback->call,
+                                                                callback->drop, ctx, opt.executor)};
 }
 
 int8_t z_undeclare_queryable(z_owned_queryable_t *queryable) {
@@ -818,6 +828,99 @@ int8_t zp_stop_lease_task(z_session_t zs) {
 #endif
 }
 
+zp_task_write_options_t zp_task_write_options_default(void) {
+    return (zp_task_write_options_t){.drop_policy = Z_DROP_POLICY_DEFAULT, .block_timeout = Z_TX_QUEUE_BLOCK_TIMEOUT};
+}
+
+int8_t zp_start_write_task(z_session_t zs, const zp_task_write_options_t *options) {
+#if Z_TX_QUEUE == 1
+    zp_task_write_options_t opt = zp_task_write_options_default();
+    if (options != NULL) {
+        opt.drop_policy = options->drop_policy;
+        opt.block_timeout = options->block_timeout;
+    }
+    return _zp_start_write_task(zs._val, opt.drop_policy, opt.block_timeout);
+#else
+    (void)(zs);
+    (void)(options);
+    return -1;
+#endif
+}
+
+int8_t zp_stop_write_task(z_session_t zs) {
+#if Z_TX_QUEUE == 1
+    return _zp_stop_write_task(zs._val);
+#else
+    (void)(zs);
+    return -1;
+#endif
+}
+
+int8_t zp_tx_stats(z_session_t zs, zp_tx_stats_t *stats) {
+#if Z_TX_QUEUE == 1
+    return _zp_tx_stats(zs._val, &stats->dropped, &stats->timed_out);
+#else
+    (void)(zs);
+    (void)(stats);
+    return -1;
+#endif
+}
+
+zp_task_executor_options_t zp_task_executor_options_default(void) {
+    return (zp_task_executor_options_t){.workers = Z_EXECUTOR_WORKERS};
+}
+
+int8_t zp_start_executor_task(z_session_t zs, const zp_task_executor_options_t *options) {
+#if Z_EXECUTOR == 1
+    zp_task_executor_options_t opt = zp_task_executor_options_default();
+    if (options != NULL) {
+        opt.workers = options->workers;
+    }
+    return _zp_start_executor_task(zs._val, opt.workers);
+#else
+    (void)(zs);
+    (void)(options);
+    return -1;
+#endif
+}
+
+int8_t zp_stop_executor_task(z_session_t zs) {
+#if Z_EXECUTOR == 1
+    return _zp_stop_executor_task(zs._val);
+#else
+    (void)(zs);
+    return -1;
+#endif
+}
+
+int8_t zp_executor_stats(z_session_t zs, zp_executor_stats_t *stats) {
+#if Z_EXECUTOR == 1
+    return _zp_executor_stats(zs._val, &stats->queued, &stats->high_water_mark);
+#else
+    (void)(zs);
+    (void)(stats);
+    return -1;
+#endif
+}
+
+size_t zp_subscriber_queue_depth(z_subscriber_t sub) {
+#if Z_EXECUTOR == 1
+    return _z_subscription_queue_depth(sub._val->_zn, sub._val->_id);
+#else
+    (void)(sub);
+    return 0;
+#endif
+}
+
+size_t zp_queryable_queue_depth(z_queryable_t qable) {
+#if Z_EXECUTOR == 1
+    return _z_questionable_queue_depth(qable._val->_zn, qable._val->_id);
+#else
+    (void)(qable);
+    return 0;
+#endif
+}
+
 zp_read_options_t zp_read_options_default(void) { return (zp_read_options_t){}; }
 
 int8_t zp_read(z_session_t zs, const zp_read_options_t *options) {
@@ -838,3 +941,10 @@ int8_t zp_send_join(z_session_t zs, const zp_send_join_options_t *options) {
     (void)(options);
     return _zp_send_join(zs._val);
 }
+
+zp_flush_options_t zp_flush_options_default(void) { return (zp_flush_options_t){}; }
+
+int8_t zp_flush(z_session_t zs, const zp_flush_options_t *options) {
+    (void)(options);
+    return _zp_flush(zs._val);
+}
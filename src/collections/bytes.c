@@ -94,3 +94,7 @@ _z_bytes_t _z_bytes_duplicate(const _z_bytes_t *src) {
 }
 
 _Bool _z_bytes_is_empty(const _z_bytes_t *bs) { return bs->len == 0; }
+
+_Bool _z_bytes_eq(const _z_bytes_t *left, const _z_bytes_t *right) {
+    return (left->len == right->len) && ((left->len == 0) || (memcmp(left->start, right->start, left->len) == 0));
+}
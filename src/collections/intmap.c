@@ -17,14 +17,12 @@
 #include <stddef.h>
 
 /*-------- int-void map --------*/
-_Bool _z_int_void_map_entry_key_eq(const void *left, const void *right) {
-    _z_int_void_map_entry_t *l = (_z_int_void_map_entry_t *)left;
-    _z_int_void_map_entry_t *r = (_z_int_void_map_entry_t *)right;
-    return l->_key == r->_key;
-}
-
 void _z_int_void_map_init(_z_int_void_map_t *map, size_t capacity) {
-    map->_capacity = capacity;
+    map->_capacity = 2;
+    while (map->_capacity < capacity) {
+        map->_capacity = map->_capacity * (size_t)2;
+    }
+    map->_len = 0;
     map->_vals = NULL;
 }
 
@@ -36,71 +34,104 @@ _z_int_void_map_t _z_int_void_map_make(size_t capacity) {
 
 size_t _z_int_void_map_capacity(const _z_int_void_map_t *map) { return map->_capacity; }
 
-size_t _z_int_void_map_len(const _z_int_void_map_t *map) {
-    size_t len = 0;
+size_t _z_int_void_map_len(const _z_int_void_map_t *map) { return map->_len; }
 
-    if (map->_vals != NULL) {
-        for (size_t idx = 0; idx < map->_capacity; idx++) {
-            len = len + _z_list_len(map->_vals[idx]);
-        }
+_Bool _z_int_void_map_is_empty(const _z_int_void_map_t *map) { return _z_int_void_map_len(map) == (size_t)0; }
+
+// Returns the index of the entry of the key, or of the free entry ending its probing sequence if there is none
+static size_t __z_int_void_map_find(const _z_int_void_map_t *map, size_t k) {
+    size_t mask = map->_capacity - (size_t)1;
+    size_t idx = k & mask;
+    while ((map->_vals[idx]._val != NULL) && (map->_vals[idx]._key != k)) {
+        idx = (idx + (size_t)1) & mask;
     }
 
-    return len;
+    return idx;
 }
 
-_Bool _z_int_void_map_is_empty(const _z_int_void_map_t *map) { return _z_int_void_map_len(map) == (size_t)0; }
+static _z_int_void_map_entry_t *__z_int_void_map_alloc(size_t capacity) {
+    _z_int_void_map_entry_t *vals = (_z_int_void_map_entry_t *)z_malloc(capacity * sizeof(_z_int_void_map_entry_t));
+    if (vals != NULL) {
+        for (size_t idx = 0; idx < capacity; idx++) {
+            vals[idx]._key = 0;
+            vals[idx]._val = NULL;
+        }
+    }
+
+    return vals;
+}
 
 void _z_int_void_map_remove(_z_int_void_map_t *map, size_t k, z_element_free_f f) {
     if (map->_vals != NULL) {
-        size_t idx = k % map->_capacity;
-        _z_int_void_map_entry_t e;
-        e._key = k;
-        e._val = NULL;
-
-        map->_vals[idx] = _z_list_drop_filter(map->_vals[idx], f, _z_int_void_map_entry_key_eq, &e);
+        size_t idx = __z_int_void_map_find(map, k);
+        if (map->_vals[idx]._val != NULL) {
+            f(&map->_vals[idx]._val);
+            map->_vals[idx]._val = NULL;
+            map->_len = map->_len - (size_t)1;
+
+            // Shift back the following entries that could not be reached anymore through the freed one
+            size_t mask = map->_capacity - (size_t)1;
+            size_t hole = idx;
+            size_t next = (idx + (size_t)1) & mask;
+            while (map->_vals[next]._val != NULL) {
+                size_t home = map->_vals[next]._key & mask;
+                if (((next - home) & mask) >= ((next - hole) & mask)) {
+                    map->_vals[hole] = map->_vals[next];
+                    map->_vals[next]._val = NULL;
+                    hole = next;
+                }
+                next = (next + (size_t)1) & mask;
+            }
+        }
     }
 }
 
 void *_z_int_void_map_insert(_z_int_void_map_t *map, size_t k, void *v, z_element_free_f f_f) {
-    if (map->_vals == NULL) {
-        // Lazily allocate and initialize to NULL all the pointers
-        map->_vals = (_z_list_t **)z_malloc(map->_capacity * sizeof(_z_list_t *));
-        // (void)memset(map->vals, 0, map->capacity * sizeof(_z_list_t *));
-
-        for (size_t idx = 0; idx < map->_capacity; idx++) {
-            map->_vals[idx] = NULL;
-        }
-    }
+    void *ret = v;
 
     // Free any old value
     _z_int_void_map_remove(map, k, f_f);
 
-    // Insert the element
-    _z_int_void_map_entry_t *entry = (_z_int_void_map_entry_t *)z_malloc(sizeof(_z_int_void_map_entry_t));
-    entry->_key = k;
-    entry->_val = v;
+    if (map->_vals == NULL) {
+        map->_vals = __z_int_void_map_alloc(map->_capacity);
+    } else if (((map->_len + (size_t)1) * (size_t)4) > (map->_capacity * (size_t)3)) {
+        // Keep the load factor under 3/4, so that probing sequences remain short
+        _z_int_void_map_entry_t *vals = __z_int_void_map_alloc(map->_capacity * (size_t)2);
+        if (vals != NULL) {
+            _z_int_void_map_entry_t *old_vals = map->_vals;
+            size_t old_capacity = map->_capacity;
+            map->_vals = vals;
+            map->_capacity = old_capacity * (size_t)2;
+            for (size_t idx = 0; idx < old_capacity; idx++) {
+                if (old_vals[idx]._val != NULL) {
+                    map->_vals[__z_int_void_map_find(map, old_vals[idx]._key)] = old_vals[idx];
+                }
+            }
+            z_free(old_vals);
+        }
+    } else {
+        // Enough room left
+    }
 
-    size_t idx = k % map->_capacity;
-    map->_vals[idx] = _z_list_push(map->_vals[idx], entry);
+    // Insert the element, unless the entries could not be allocated. One of them must always remain free, as it ends
+    // the probing sequences.
+    if ((map->_vals != NULL) && (v != NULL) && ((map->_len + (size_t)1) < map->_capacity)) {
+        size_t idx = __z_int_void_map_find(map, k);
+        map->_vals[idx]._key = k;
+        map->_vals[idx]._val = v;
+        map->_len = map->_len + (size_t)1;
+    } else {
+        ret = NULL;
+    }
 
-    return v;
+    return ret;
 }
 
 void *_z_int_void_map_get(const _z_int_void_map_t *map, size_t k) {
     void *ret = NULL;
 
     if (map->_vals != NULL) {
-        size_t idx = k % map->_capacity;
-
-        _z_int_void_map_entry_t e;
-        e._key = k;
-        e._val = NULL;
-
-        _z_list_t *xs = _z_list_find(map->_vals[idx], _z_int_void_map_entry_key_eq, &e);
-        if (xs != NULL) {
-            _z_int_void_map_entry_t *h = (_z_int_void_map_entry_t *)_z_list_head(xs);
-            ret = h->_val;
-        }
+        ret = map->_vals[__z_int_void_map_find(map, k)]._val;
     }
 
     return ret;
@@ -109,11 +140,14 @@ void *_z_int_void_map_get(const _z_int_void_map_t *map, size_t k) {
 void _z_int_void_map_clear(_z_int_void_map_t *map, z_element_free_f f_f) {
     if (map->_vals != NULL) {
         for (size_t idx = 0; idx < map->_capacity; idx++) {
-            _z_list_free(&map->_vals[idx], f_f);
+            if (map->_vals[idx]._val != NULL) {
+                f_f(&map->_vals[idx]._val);
+            }
         }
 
         z_free(map->_vals);
         map->_vals = NULL;
+        map->_len = 0;
     }
 }
 
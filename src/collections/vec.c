@@ -104,10 +104,10 @@ void _z_vec_set(_z_vec_t *v, size_t i, void *e, z_element_free_f free_f) {
 
 void _z_vec_remove(_z_vec_t *v, size_t pos, z_element_free_f free_f) {
     free_f(&v->_val[pos]);
-    for (size_t i = pos; i < v->_len; i++) {
-        v->_val[pos] = v->_val[pos + (size_t)1];
+    for (size_t i = pos; (i + (size_t)1) < v->_len; i++) {
+        v->_val[i] = v->_val[i + (size_t)1];
     }
 
-    v->_val[v->_len] = NULL;
     v->_len = v->_len - 1;
+    v->_val[v->_len] = NULL;
 }
@@ -123,6 +123,13 @@ size_t _z_link_recv_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, _z_bytes_t *addr
     return rb;
 }
 
+// Receives up to n datagrams at once, each one in its own zbuf, on links with a _read_burst_f. Each addrs entry must
+// wrap a storage of _Z_LINK_ADDR_MAX_SIZE bytes, in which the address of the sender of the datagram is written.
+// Empty slots are left for the datagrams to be ignored. Returns the number of slots used, or SIZE_MAX on error.
+size_t _z_link_recv_zbuf_burst(const _z_link_t *link, _z_zbuf_t *zbfs, _z_bytes_t *addrs, size_t n) {
+    return link->_read_burst_f(link, zbfs, addrs, n);
+}
+
 size_t _z_link_recv_exact_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, size_t len, _z_bytes_t *addr) {
     size_t rb = link->_read_exact_f(link, _z_zbuf_get_wptr(zbf), len, addr);
     if (rb != SIZE_MAX) {
@@ -131,13 +138,75 @@ size_t _z_link_recv_exact_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, size_t len
     return rb;
 }
 
+#if defined(_Z_SYS_WAKER)
+// Returns the socket on which the link receives, to be waited for or watched by the reactor, or NULL if there is none
+const _z_sys_net_socket_t *_z_link_get_rx_socket(const _z_link_t *link) {
+    const _z_sys_net_socket_t *ret = NULL;
+
+#if Z_LINK_TCP == 1
+    if (_z_str_eq(link->_endpoint._locator._protocol, TCP_SCHEMA) == true) {
+        ret = &link->_socket._tcp._sock;
+    } else
+#endif
+#if Z_LINK_UDP_UNICAST == 1 || Z_LINK_UDP_MULTICAST == 1
+        if (_z_str_eq(link->_endpoint._locator._protocol, UDP_SCHEMA) == true) {
+        ret = &link->_socket._udp._sock;
+    } else
+#endif
+    {
+        ret = NULL;
+    }
+
+    return ret;
+}
+
+// Blocks until data can be read from the link or the waker is signaled, in which case it returns true.
+// Returns false right away for the links without a socket to wait for, their reads time out instead.
+_Bool _z_link_wait_readable(const _z_link_t *link, const _z_waker_t *waker) {
+    _Bool ret = false;
+
+    const _z_sys_net_socket_t *sock = _z_link_get_rx_socket(link);
+    if (sock != NULL) {
+        ret = _z_waker_wait_socket(waker, sock);
+    }
+
+    return ret;
+}
+#endif  // defined(_Z_SYS_WAKER)
+
+_Bool _z_link_is_scatter_gather(const _z_link_t *link) {
+    return (_Z_LINK_IS_STREAMED(link->_capabilities) == true) || (link->_writev_f != NULL);
+}
+
 int8_t _z_link_send_wbuf(const _z_link_t *link, const _z_wbuf_t *wbf) {
     int8_t ret = _Z_RES_OK;
 
-    for (size_t i = 0; (i < _z_wbuf_len_iosli(wbf)) || (ret == -1); i++) {
+    // Send all the ioslices at once if supported by the link
+    size_t sent = 0;
+    if (link->_writev_f != NULL) {
+        _Z_DEBUG("Sending wbuf on socket...");
+        sent = link->_writev_f(link, wbf);
+        _Z_DEBUG(" sent %lu bytes\n", sent);
+        if (sent == SIZE_MAX) {
+            _Z_DEBUG("Error while sending data over socket [%lu]\n", sent);
+            ret = _Z_ERR_TRANSPORT_TX_FAILED;
+        }
+    }
+
+    // Send one ioslice at a time what has not been sent yet
+    for (size_t i = 0; (i < _z_wbuf_len_iosli(wbf)) && (ret == _Z_RES_OK); i++) {
         _z_bytes_t bs = _z_iosli_to_bytes(_z_wbuf_get_iosli(wbf, i));
+        if (sent >= bs.len) {
+            sent = sent - bs.len;
+            bs.len = 0;
+        } else {
+            bs.start = bs.start + sent;
+            bs.len = bs.len - sent;
+            sent = 0;
+        }
+
         size_t n = bs.len;
-        do {
+        while (n > (size_t)0) {
             _Z_DEBUG("Sending wbuf on socket...");
             size_t wb = link->_write_f(link, bs.start, n);
             _Z_DEBUG(" sent %lu bytes\n", wb);
@@ -147,8 +216,32 @@ int8_t _z_link_send_wbuf(const _z_link_t *link, const _z_wbuf_t *wbf) {
                 break;
             }
             n = n - wb;
-            bs.start = bs.start + (bs.len - n);
-        } while (n > (size_t)0);
+            bs.start = bs.start + wb;
+        }
+    }
+
+    return ret;
+}
+
+int8_t _z_link_send_wbuf_burst(const _z_link_t *link, const _z_wbuf_t *wbfs, size_t n) {
+    int8_t ret = _Z_RES_OK;
+
+    size_t i = 0;
+    while ((i < n) && (ret == _Z_RES_OK)) {
+        if (_Z_LINK_IS_BURST(link->_capabilities) == true) {
+            _Z_DEBUG("Sending %lu wbufs on socket...", n - i);
+            size_t sent = link->_write_burst_f(link, &wbfs[i], n - i);
+            _Z_DEBUG(" sent %lu wbufs\n", sent);
+            if ((sent == SIZE_MAX) || (sent == (size_t)0)) {
+                _Z_DEBUG("Error while sending data over socket [%lu]\n", sent);
+                ret = _Z_ERR_TRANSPORT_TX_FAILED;
+            } else {
+                i = i + sent;
+            }
+        } else {
+            ret = _z_link_send_wbuf(link, &wbfs[i]);
+            i = i + (size_t)1;
+        }
     }
 
     return ret;
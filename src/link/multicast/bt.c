@@ -121,7 +121,10 @@ _z_link_t *_z_new_link_bt(_z_endpoint_t endpoint) {
 
     lt->_write_f = _z_f_link_write_bt;
     lt->_write_all_f = _z_f_link_write_all_bt;
+    lt->_writev_f = NULL;
+    lt->_write_burst_f = NULL;
     lt->_read_f = _z_f_link_read_bt;
+    lt->_read_burst_f = NULL;
     lt->_read_exact_f = _z_f_link_read_exact_bt;
 
     return lt;
@@ -121,10 +121,28 @@ size_t _z_f_link_write_all_udp_multicast(const _z_link_t *self, const uint8_t *p
     return _z_send_udp_multicast(self->_socket._udp._msock, ptr, len, self->_socket._udp._rep);
 }
 
+#if defined(_Z_SYS_NET_SENDV)
+size_t _z_f_link_writev_udp_multicast(const _z_link_t *self, const _z_wbuf_t *wbf) {
+    return _z_sendv_udp_multicast(self->_socket._udp._msock, wbf, self->_socket._udp._rep);
+}
+#endif
+
+#if defined(_Z_SYS_NET_SENDMMSG)
+size_t _z_f_link_write_burst_udp_multicast(const _z_link_t *self, const _z_wbuf_t *wbfs, size_t n) {
+    return _z_sendmmsg_udp_multicast(self->_socket._udp._msock, wbfs, n, self->_socket._udp._rep);
+}
+#endif
+
 size_t _z_f_link_read_udp_multicast(const _z_link_t *self, uint8_t *ptr, size_t len, _z_bytes_t *addr) {
     return _z_read_udp_multicast(self->_socket._udp._sock, ptr, len, self->_socket._udp._lep, addr);
 }
 
+#if defined(_Z_SYS_NET_RECVMMSG)
+size_t _z_f_link_read_burst_udp_multicast(const _z_link_t *self, _z_zbuf_t *zbfs, _z_bytes_t *addrs, size_t n) {
+    return _z_recvmmsg_udp_multicast(self->_socket._udp._sock, zbfs, addrs, n, self->_socket._udp._lep);
+}
+#endif
+
 size_t _z_f_link_read_exact_udp_multicast(const _z_link_t *self, uint8_t *ptr, size_t len, _z_bytes_t *addr) {
     return _z_read_exact_udp_multicast(self->_socket._udp._sock, ptr, len, self->_socket._udp._lep, addr);
 }
@@ -137,7 +155,11 @@ uint16_t _z_get_link_mtu_udp_multicast(void) {
 _z_link_t *_z_new_link_udp_multicast(_z_endpoint_t endpoint) {
     _z_link_t *lt = (_z_link_t *)z_malloc(sizeof(_z_link_t));
 
+#if defined(_Z_SYS_NET_SENDMMSG)
+    lt->_capabilities = Z_LINK_CAPABILITY_MULTICAST | Z_LINK_CAPABILITY_BURST;
+#else
     lt->_capabilities = Z_LINK_CAPABILITY_MULTICAST;
+#endif
     lt->_mtu = _z_get_link_mtu_udp_multicast();
 
     lt->_endpoint = endpoint;
@@ -158,7 +180,22 @@ _z_link_t *_z_new_link_udp_multicast(_z_endpoint_t endpoint) {
 
     lt->_write_f = _z_f_link_write_udp_multicast;
     lt->_write_all_f = _z_f_link_write_all_udp_multicast;
+#if defined(_Z_SYS_NET_SENDV)
+    lt->_writev_f = _z_f_link_writev_udp_multicast;
+#else
+    lt->_writev_f = NULL;
+#endif
+#if defined(_Z_SYS_NET_SENDMMSG)
+    lt->_write_burst_f = _z_f_link_write_burst_udp_multicast;
+#else
+    lt->_write_burst_f = NULL;
+#endif
     lt->_read_f = _z_f_link_read_udp_multicast;
+#if defined(_Z_SYS_NET_RECVMMSG)
+    lt->_read_burst_f = _z_f_link_read_burst_udp_multicast;
+#else
+    lt->_read_burst_f = NULL;
+#endif
     lt->_read_exact_f = _z_f_link_read_exact_udp_multicast;
 
     return lt;
@@ -95,7 +95,10 @@ _z_link_t *_z_new_link_serial(_z_endpoint_t endpoint) {
 
     lt->_write_f = _z_f_link_write_serial;
     lt->_write_all_f = _z_f_link_write_all_serial;
+    lt->_writev_f = NULL;
+    lt->_write_burst_f = NULL;
     lt->_read_f = _z_f_link_read_serial;
+    lt->_read_burst_f = NULL;
     lt->_read_exact_f = _z_f_link_read_exact_serial;
 
     return lt;
@@ -108,6 +108,12 @@ size_t _z_f_link_write_all_tcp(const _z_link_t *self, const uint8_t *ptr, size_t
     return _z_send_tcp(self->_socket._tcp._sock, ptr, len);
 }
 
+#if defined(_Z_SYS_NET_SENDV)
+size_t _z_f_link_writev_tcp(const _z_link_t *self, const _z_wbuf_t *wbf) {
+    return _z_sendv_tcp(self->_socket._tcp._sock, wbf);
+}
+#endif
+
 size_t _z_f_link_read_tcp(const _z_link_t *self, uint8_t *ptr, size_t len, _z_bytes_t *addr) {
     (void)(addr);
     return _z_read_tcp(self->_socket._tcp._sock, ptr, len);
@@ -145,7 +151,14 @@ _z_link_t *_z_new_link_tcp(_z_endpoint_t endpoint) {
 
     lt->_write_f = _z_f_link_write_tcp;
     lt->_write_all_f = _z_f_link_write_all_tcp;
+#if defined(_Z_SYS_NET_SENDV)
+    lt->_writev_f = _z_f_link_writev_tcp;
+#else
+    lt->_writev_f = NULL;
+#endif
+    lt->_write_burst_f = NULL;
     lt->_read_f = _z_f_link_read_tcp;
+    lt->_read_burst_f = NULL;
     lt->_read_exact_f = _z_f_link_read_exact_tcp;
 
     return lt;
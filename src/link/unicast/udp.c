@@ -114,6 +114,18 @@ size_t _z_f_link_write_all_udp_unicast(const _z_link_t *self, const uint8_t *ptr
     return _z_send_udp_unicast(self->_socket._udp._sock, ptr, len, self->_socket._udp._rep);
 }
 
+#if defined(_Z_SYS_NET_SENDV)
+size_t _z_f_link_writev_udp_unicast(const _z_link_t *self, const _z_wbuf_t *wbf) {
+    return _z_sendv_udp_unicast(self->_socket._udp._sock, wbf, self->_socket._udp._rep);
+}
+#endif
+
+#if defined(_Z_SYS_NET_SENDMMSG)
+size_t _z_f_link_write_burst_udp_unicast(const _z_link_t *self, const _z_wbuf_t *wbfs, size_t n) {
+    return _z_sendmmsg_udp_unicast(self->_socket._udp._sock, wbfs, n, self->_socket._udp._rep);
+}
+#endif
+
 size_t _z_f_link_read_udp_unicast(const _z_link_t *self, uint8_t *ptr, size_t len, _z_bytes_t *addr) {
     (void)(addr);
     return _z_read_udp_unicast(self->_socket._udp._sock, ptr, len);
@@ -132,7 +144,11 @@ uint16_t _z_get_link_mtu_udp_unicast(void) {
 _z_link_t *_z_new_link_udp_unicast(_z_endpoint_t endpoint) {
     _z_link_t *lt = (_z_link_t *)z_malloc(sizeof(_z_link_t));
 
+#if defined(_Z_SYS_NET_SENDMMSG)
+    lt->_capabilities = Z_LINK_CAPABILITY_BURST;
+#else
     lt->_capabilities = Z_LINK_CAPABILITY_NONE;
+#endif
     lt->_mtu = _z_get_link_mtu_udp_unicast();
 
     lt->_endpoint = endpoint;
@@ -153,7 +169,18 @@ _z_link_t *_z_new_link_udp_unicast(_z_endpoint_t endpoint) {
 
     lt->_write_f = _z_f_link_write_udp_unicast;
     lt->_write_all_f = _z_f_link_write_all_udp_unicast;
+#if defined(_Z_SYS_NET_SENDV)
+    lt->_writev_f = _z_f_link_writev_udp_unicast;
+#else
+    lt->_writev_f = NULL;
+#endif
+#if defined(_Z_SYS_NET_SENDMMSG)
+    lt->_write_burst_f = _z_f_link_write_burst_udp_unicast;
+#else
+    lt->_write_burst_f = NULL;
+#endif
     lt->_read_f = _z_f_link_read_udp_unicast;
+    lt->_read_burst_f = NULL;
     lt->_read_exact_f = _z_f_link_read_exact_udp_unicast;
 
     return lt;
@@ -19,6 +19,7 @@
 #include "zenoh-pico/net/logger.h"
 #include "zenoh-pico/net/memory.h"
 #include "zenoh-pico/protocol/keyexpr.h"
+#include "zenoh-pico/protocol/msgcodec.h"
 #include "zenoh-pico/session/query.h"
 #include "zenoh-pico/session/queryable.h"
 #include "zenoh-pico/session/resource.h"
@@ -60,7 +61,8 @@ _z_zint_t _z_declare_resource(_z_session_t *zn, _z_keyexpr_t keyexpr) {
             _z_declaration_array_t declarations = _z_declaration_array_make(1);
             declarations._val[0] = _z_msg_make_declaration_resource(r->_id, _z_keyexpr_duplicate(&keyexpr));
             _z_zenoh_message_t z_msg = _z_msg_make_declare(declarations);
-            if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK) {
+            if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                              false) == _Z_RES_OK) {
                 ret = r->_id;
             } else {
                 _z_unregister_resource(zn, _Z_RESOURCE_IS_LOCAL, r);
@@ -83,7 +85,8 @@ int8_t _z_undeclare_resource(_z_session_t *zn, const _z_zint_t rid) {
         _z_declaration_array_t declarations = _z_declaration_array_make(1);
         declarations._val[0] = _z_msg_make_declaration_forget_resource(rid);
         _z_zenoh_message_t z_msg = _z_msg_make_declare(declarations);
-        if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK) {
+        if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                          false) == _Z_RES_OK) {
             _z_unregister_resource(zn, _Z_RESOURCE_IS_LOCAL, r);  // Only if message is send, local resource is removed
         } else {
             ret = _Z_ERR_TRANSPORT_TX_FAILED;
@@ -96,22 +99,58 @@ int8_t _z_undeclare_resource(_z_session_t *zn, const _z_zint_t rid) {
     return ret;
 }
 
+/*------------------ Data Message ------------------*/
+static _z_zenoh_message_t __z_write_make_data(const _z_keyexpr_t keyexpr, const uint8_t *payload, const size_t len,
+                                              const _z_encoding_t encoding, const z_sample_kind_t kind,
+                                              const z_congestion_control_t cong_ctrl) {
+    // Data info
+    _z_data_info_t info = {._flags = 0, ._encoding = encoding, ._kind = kind};
+    _Z_SET_FLAG(info._flags, _Z_DATA_INFO_ENC);
+    _Z_SET_FLAG(info._flags, _Z_DATA_INFO_KIND);
+
+    _z_payload_t pld = {.len = len, .start = payload};              // Payload
+    _Bool can_be_dropped = cong_ctrl == Z_CONGESTION_CONTROL_DROP;  // Congestion control
+    return _z_msg_make_data(keyexpr, info, pld, can_be_dropped);
+}
+
+static _z_bytes_t __z_write_encode_prefix(const _z_keyexpr_t keyexpr, const _z_encoding_t encoding,
+                                          const z_sample_kind_t kind) {
+    _z_bytes_t ret = _z_bytes_empty();
+
+    // The congestion control only affects the message header, which is not part of the prefix
+    _z_zenoh_message_t z_msg = __z_write_make_data(keyexpr, NULL, 0, encoding, kind, Z_CONGESTION_CONTROL_DEFAULT);
+    _z_wbuf_t wbf = _z_wbuf_make(Z_IOSLICE_SIZE, true);
+    if (_z_data_prefix_encode(&wbf, z_msg._header, &z_msg._body._data) == _Z_RES_OK) {
+        _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+        ret = _z_bytes_make(_z_zbuf_len(&zbf));
+        (void)memcpy((uint8_t *)ret.start, _z_zbuf_get_rptr(&zbf), ret.len);
+        _z_zbuf_clear(&zbf);
+    }
+    _z_wbuf_clear(&wbf);
+
+    return ret;
+}
+
 /*------------------  Publisher Declaration ------------------*/
 _z_publisher_t *_z_declare_publisher(_z_session_t *zn, _z_keyexpr_t keyexpr, z_congestion_control_t congestion_control,
-                                     z_priority_t priority) {
+                                     z_priority_t priority, _Bool is_express) {
     _z_publisher_t *ret = NULL;
 
     // Build the declare message to send on the wire
     _z_declaration_array_t declarations = _z_declaration_array_make(1);
     declarations._val[0] = _z_msg_make_declaration_publisher(_z_keyexpr_duplicate(&keyexpr));
     _z_zenoh_message_t z_msg = _z_msg_make_declare(declarations);
-    if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK) {
+    if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                      false) == _Z_RES_OK) {
         ret = (_z_publisher_t *)z_malloc(sizeof(_z_publisher_t));
         ret->_zn = zn;
         ret->_key = _z_keyexpr_duplicate(&keyexpr);
         ret->_id = _z_get_entity_id(zn);
         ret->_congestion_control = congestion_control;
         ret->_priority = priority;
+        ret->_is_express = is_express;
+        _z_encoding_t encoding = {.prefix = Z_ENCODING_PREFIX_DEFAULT, .suffix = _z_bytes_empty()};
+        ret->_prefix = __z_write_encode_prefix(ret->_key, encoding, Z_SAMPLE_KIND_PUT);
     } else {
         // ret = _Z_ERR_TRANSPORT_TX_FAILED;
     }
@@ -127,7 +166,8 @@ int8_t _z_undeclare_publisher(_z_publisher_t *pub) {
     _z_declaration_array_t declarations = _z_declaration_array_make(1);
     declarations._val[0] = _z_msg_make_declaration_forget_publisher(_z_keyexpr_duplicate(&pub->_key));
     _z_zenoh_message_t z_msg = _z_msg_make_declare(declarations);
-    if (_z_send_z_msg(pub->_zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) != _Z_RES_OK) {
+    if (_z_send_z_msg(pub->_zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                      false) != _Z_RES_OK) {
         ret = _Z_ERR_TRANSPORT_TX_FAILED;
     }
     _z_msg_clear(&z_msg);
@@ -137,7 +177,8 @@ int8_t _z_undeclare_publisher(_z_publisher_t *pub) {
 
 /*------------------ Subscriber Declaration ------------------*/
 _z_subscriber_t *_z_declare_subscriber(_z_session_t *zn, _z_keyexpr_t keyexpr, _z_subinfo_t sub_info,
-                                       _z_data_handler_t callback, _z_drop_handler_t dropper, void *arg) {
+                                       _z_data_handler_t callback, _z_drop_handler_t dropper, void *arg,
+                                       _Bool is_executed) {
     _z_subscriber_t *ret = NULL;
 
     _z_subscription_t s;
@@ -147,6 +188,12 @@ _z_subscriber_t *_z_declare_subscriber(_z_session_t *zn, _z_keyexpr_t keyexpr, _
     s._callback = callback;
     s._dropper = dropper;
     s._arg = arg;
+#if Z_EXECUTOR == 1
+    s._is_executed = is_executed;
+    _z_executor_strand_init(&s._strand);
+#else
+    (void)(is_executed);
+#endif  // Z_EXECUTOR == 1
 
     _z_subscription_sptr_t *sp_s =
         _z_register_subscription(zn, _Z_RESOURCE_IS_LOCAL, &s);  // This a pointer to the entry stored at session-level.
@@ -156,7 +203,8 @@ _z_subscriber_t *_z_declare_subscriber(_z_session_t *zn, _z_keyexpr_t keyexpr, _
         _z_declaration_array_t declarations = _z_declaration_array_make(1);
         declarations._val[0] = _z_msg_make_declaration_subscriber(_z_keyexpr_duplicate(&keyexpr), sub_info);
         _z_zenoh_message_t z_msg = _z_msg_make_declare(declarations);
-        if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK) {
+        if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                          false) == _Z_RES_OK) {
             ret = (_z_subscriber_t *)z_malloc(sizeof(_z_subscriber_t));
             ret->_zn = zn;
             ret->_id = s._id;
@@ -179,7 +227,8 @@ int8_t _z_undeclare_subscriber(_z_subscriber_t *sub) {
         _z_declaration_array_t declarations = _z_declaration_array_make(1);
         declarations._val[0] = _z_msg_make_declaration_forget_subscriber(_z_keyexpr_duplicate(&s->ptr->_key));
         _z_zenoh_message_t z_msg = _z_msg_make_declare(declarations);
-        if (_z_send_z_msg(sub->_zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK) {
+        if (_z_send_z_msg(sub->_zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                          false) == _Z_RES_OK) {
             // Only if message is successfully send, local subscription state can be removed
             _z_unregister_subscription(sub->_zn, _Z_RESOURCE_IS_LOCAL, s);
         } else {
@@ -195,7 +244,8 @@ int8_t _z_undeclare_subscriber(_z_subscriber_t *sub) {
 
 /*------------------ Queryable Declaration ------------------*/
 _z_queryable_t *_z_declare_queryable(_z_session_t *zn, _z_keyexpr_t keyexpr, _Bool complete,
-                                     _z_questionable_handler_t callback, _z_drop_handler_t dropper, void *arg) {
+                                     _z_questionable_handler_t callback, _z_drop_handler_t dropper, void *arg,
+                                     _Bool is_executed) {
     _z_queryable_t *ret = NULL;
 
     _z_questionable_t q;
@@ -205,6 +255,12 @@ _z_queryable_t *_z_declare_queryable(_z_session_t *zn, _z_keyexpr_t keyexpr, _Bo
     q._callback = callback;
     q._dropper = dropper;
     q._arg = arg;
+#if Z_EXECUTOR == 1
+    q._is_executed = is_executed;
+    _z_executor_strand_init(&q._strand);
+#else
+    (void)(is_executed);
+#endif  // Z_EXECUTOR == 1
 
     _z_questionable_sptr_t *sp_q =
         _z_register_questionable(zn, &q);  // This a pointer to the entry stored at session-level.
@@ -215,7 +271,8 @@ _z_queryable_t *_z_declare_queryable(_z_session_t *zn, _z_keyexpr_t keyexpr, _Bo
         declarations._val[0] = _z_msg_make_declaration_queryable(_z_keyexpr_duplicate(&keyexpr), q._complete,
                                                                  _Z_QUERYABLE_DISTANCE_DEFAULT);
         _z_zenoh_message_t z_msg = _z_msg_make_declare(declarations);
-        if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK) {
+        if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                          false) == _Z_RES_OK) {
             ret = (_z_queryable_t *)z_malloc(sizeof(_z_queryable_t));
             ret->_zn = zn;
             ret->_id = q._id;
@@ -238,7 +295,8 @@ int8_t _z_undeclare_queryable(_z_queryable_t *qle) {
         _z_declaration_array_t declarations = _z_declaration_array_make(1);
         declarations._val[0] = _z_msg_make_declaration_forget_queryable(_z_keyexpr_duplicate(&q->ptr->_key));
         _z_zenoh_message_t z_msg = _z_msg_make_declare(declarations);
-        if (_z_send_z_msg(qle->_zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK) {
+        if (_z_send_z_msg(qle->_zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                          false) == _Z_RES_OK) {
             // Only if message is successfully send, local queryable state can be removed
             _z_unregister_questionable(qle->_zn, q);
         } else {
@@ -279,7 +337,8 @@ int8_t _z_send_reply(const z_query_t *query, _z_keyexpr_t keyexpr, const uint8_t
         _Bool can_be_dropped = false;                       // Congestion control
         _z_zenoh_message_t z_msg = _z_msg_make_reply(keyexpr, di, pld, can_be_dropped, rctx);
 
-        if (_z_send_z_msg(query->_zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) != _Z_RES_OK) {
+        if (_z_send_z_msg(query->_zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                          false) != _Z_RES_OK) {
             ret = _Z_ERR_TRANSPORT_TX_FAILED;
         }
 
@@ -291,21 +350,29 @@ int8_t _z_send_reply(const z_query_t *query, _z_keyexpr_t keyexpr, const uint8_t
 
 /*------------------ Write ------------------*/
 int8_t _z_write(_z_session_t *zn, const _z_keyexpr_t keyexpr, const uint8_t *payload, const size_t len,
-                const _z_encoding_t encoding, const z_sample_kind_t kind, const z_congestion_control_t cong_ctrl) {
+                const _z_encoding_t encoding, const z_sample_kind_t kind, const z_congestion_control_t cong_ctrl,
+                const z_priority_t priority, const _Bool is_express) {
     int8_t ret = _Z_RES_OK;
 
-    // @TODO: accept `const z_priority_t priority` as additional parameter
+    _z_zenoh_message_t z_msg = __z_write_make_data(keyexpr, payload, len, encoding, kind, cong_ctrl);
+    if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, cong_ctrl, priority, is_express) != _Z_RES_OK) {
+        ret = _Z_ERR_TRANSPORT_TX_FAILED;
+    }
 
-    // Data info
-    _z_data_info_t info = {._flags = 0, ._encoding = encoding, ._kind = kind};
-    _Z_SET_FLAG(info._flags, _Z_DATA_INFO_ENC);
-    _Z_SET_FLAG(info._flags, _Z_DATA_INFO_KIND);
+    return ret;
+}
 
-    _z_payload_t pld = {.len = len, .start = payload};              // Payload
-    _Bool can_be_dropped = cong_ctrl == Z_CONGESTION_CONTROL_DROP;  // Congestion control
-    _z_zenoh_message_t z_msg = _z_msg_make_data(keyexpr, info, pld, can_be_dropped);
+int8_t _z_publisher_put(const _z_publisher_t *pub, const uint8_t *payload, const size_t len,
+                        const _z_encoding_t encoding) {
+    int8_t ret = _Z_RES_OK;
 
-    if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, cong_ctrl) != _Z_RES_OK) {
+    _z_zenoh_message_t z_msg =
+        __z_write_make_data(pub->_key, payload, len, encoding, Z_SAMPLE_KIND_PUT, pub->_congestion_control);
+    if ((encoding.prefix == Z_ENCODING_PREFIX_DEFAULT) && (encoding.suffix.len == 0)) {
+        z_msg._body._data._prefix = pub->_prefix;  // Skip the encoding of the key and data info
+    }
+    if (_z_send_z_msg(pub->_zn, &z_msg, Z_RELIABILITY_RELIABLE, pub->_congestion_control, pub->_priority,
+                      pub->_is_express) != _Z_RES_OK) {
         ret = _Z_ERR_TRANSPORT_TX_FAILED;
     }
 
@@ -337,7 +404,8 @@ int8_t _z_query(_z_session_t *zn, _z_keyexpr_t keyexpr, const char *parameters,
         _z_zenoh_message_t z_msg =
             _z_msg_make_query(keyexpr, pq->_parameters, pq->_id, pq->_target, pq->_consolidation, with_value);
 
-        if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) != _Z_RES_OK) {
+        if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                          false) != _Z_RES_OK) {
             _z_unregister_pending_query(zn, pq);
             ret = _Z_ERR_TRANSPORT_TX_FAILED;
         }
@@ -359,7 +427,8 @@ int8_t _z_subscriber_pull(const _z_subscriber_t *sub) {
         _Bool is_final = true;
         _z_zenoh_message_t z_msg = _z_msg_make_pull(s->ptr->_key, pull_id, max_samples, is_final);
 
-        if (_z_send_z_msg(sub->_zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) != _Z_RES_OK) {
+        if (_z_send_z_msg(sub->_zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                          false) != _Z_RES_OK) {
             ret = _Z_ERR_TRANSPORT_TX_FAILED;
         }
     } else {
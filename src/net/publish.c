@@ -18,7 +18,10 @@
 
 #include "zenoh-pico/protocol/msg.h"
 
-void _z_publisher_clear(_z_publisher_t *pub) { _z_keyexpr_clear(&pub->_key); }
+void _z_publisher_clear(_z_publisher_t *pub) {
+    _z_keyexpr_clear(&pub->_key);
+    _z_bytes_clear(&pub->_prefix);
+}
 
 void _z_publisher_free(_z_publisher_t **pub) {
     _z_publisher_t *ptr = *pub;
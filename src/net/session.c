@@ -20,6 +20,8 @@
 #include "zenoh-pico/transport/link/task/join.h"
 #include "zenoh-pico/transport/link/task/lease.h"
 #include "zenoh-pico/transport/link/task/read.h"
+#include "zenoh-pico/transport/link/task/write.h"
+#include "zenoh-pico/transport/link/tx.h"
 #include "zenoh-pico/utils/logging.h"
 
 _z_session_t *__z_open_inner(char *locator, z_whatami_t mode) {
@@ -139,12 +141,12 @@ _z_config_t *_z_info(const _z_session_t *zn) {
 #endif  // Z_UNICAST_TRANSPORT == 1
 #if Z_MULTICAST_TRANSPORT == 1
         if (zn->_tp->_type == _Z_TRANSPORT_MULTICAST_TYPE) {
-        _z_transport_peer_entry_list_t *xs = zn->_tp->_transport._multicast._peers;
-        while (xs != NULL) {
-            _z_transport_peer_entry_t *peer = _z_transport_peer_entry_list_head(xs);
+        size_t pos = 0;
+        _z_transport_peer_entry_t *peer = _z_transport_peer_table_next(&zn->_tp->_transport._multicast._peers, &pos);
+        while (peer != NULL) {
             _zp_config_insert(ps, Z_INFO_PEER_PID_KEY, _z_string_from_bytes(&peer->_remote_pid));
 
-            xs = _z_transport_peer_entry_list_tail(xs);
+            peer = _z_transport_peer_table_next(&zn->_tp->_transport._multicast._peers, &pos);
         }
     } else
 #endif  // Z_MULTICAST_TRANSPORT == 1
@@ -161,8 +163,47 @@ int8_t _zp_send_keep_alive(_z_session_t *zn) { return _z_send_keep_alive(zn->_tp
 
 int8_t _zp_send_join(_z_session_t *zn) { return _z_send_join(zn->_tp); }
 
+int8_t _zp_flush(_z_session_t *zn) { return _z_flush(zn->_tp); }
+
 #if Z_MULTI_THREAD == 1
-int8_t _zp_start_read_task(_z_session_t *zn) {
+#if Z_REACTOR == 1
+// Attaches the transport to the reactor, returns _Z_ERR_TRANSPORT_NOT_AVAILABLE if its link cannot be watched
+static int8_t __zp_attach_read_task(_z_session_t *zn) {
+    int8_t ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+
+#if Z_UNICAST_TRANSPORT == 1
+    if (zn->_tp->_type == _Z_TRANSPORT_UNICAST_TYPE) {
+        ret = _zp_unicast_attach_read(&zn->_tp->_transport._unicast);
+    }
+#endif  // Z_UNICAST_TRANSPORT == 1
+#if Z_MULTICAST_TRANSPORT == 1
+    if (zn->_tp->_type == _Z_TRANSPORT_MULTICAST_TYPE) {
+        ret = _zp_multicast_attach_read(&zn->_tp->_transport._multicast);
+    }
+#endif  // Z_MULTICAST_TRANSPORT == 1
+
+    return ret;
+}
+
+static int8_t __zp_attach_lease_task(_z_session_t *zn) {
+    int8_t ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+
+#if Z_UNICAST_TRANSPORT == 1
+    if (zn->_tp->_type == _Z_TRANSPORT_UNICAST_TYPE) {
+        ret = _zp_unicast_attach_lease(&zn->_tp->_transport._unicast);
+    }
+#endif  // Z_UNICAST_TRANSPORT == 1
+#if Z_MULTICAST_TRANSPORT == 1
+    if (zn->_tp->_type == _Z_TRANSPORT_MULTICAST_TYPE) {
+        ret = _zp_multicast_attach_lease(&zn->_tp->_transport._multicast);
+    }
+#endif  // Z_MULTICAST_TRANSPORT == 1
+
+    return ret;
+}
+#endif  // Z_REACTOR == 1
+
+static int8_t __zp_spawn_read_task(_z_session_t *zn) {
     int8_t ret = _Z_RES_OK;
 
     _z_task_t *task = (_z_task_t *)z_malloc(sizeof(_z_task_t));
@@ -194,17 +235,42 @@ int8_t _zp_start_read_task(_z_session_t *zn) {
     return ret;
 }
 
+int8_t _zp_start_read_task(_z_session_t *zn) {
+    int8_t ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+
+#if Z_REACTOR == 1
+    ret = __zp_attach_read_task(zn);
+#endif  // Z_REACTOR == 1
+    if (ret == _Z_ERR_TRANSPORT_NOT_AVAILABLE) {
+        ret = __zp_spawn_read_task(zn);
+    }
+
+    return ret;
+}
+
 int8_t _zp_stop_read_task(_z_session_t *zn) {
     int8_t ret = _Z_RES_OK;
 
 #if Z_UNICAST_TRANSPORT == 1
     if (zn->_tp->_type == _Z_TRANSPORT_UNICAST_TYPE) {
         zn->_tp->_transport._unicast._read_task_running = false;
+#if defined(_Z_SYS_WAKER)
+        _z_waker_signal(&zn->_tp->_transport._unicast._read_waker);
+#endif  // defined(_Z_SYS_WAKER)
+#if Z_REACTOR == 1
+        _z_reactor_detach(&zn->_tp->_transport._unicast._read_source);
+#endif  // Z_REACTOR == 1
     } else
 #endif  // Z_UNICAST_TRANSPORT == 1
 #if Z_MULTICAST_TRANSPORT == 1
         if (zn->_tp->_type == _Z_TRANSPORT_MULTICAST_TYPE) {
         zn->_tp->_transport._multicast._read_task_running = false;
+#if defined(_Z_SYS_WAKER)
+        _z_waker_signal(&zn->_tp->_transport._multicast._read_waker);
+#endif  // defined(_Z_SYS_WAKER)
+#if Z_REACTOR == 1
+        _z_reactor_detach(&zn->_tp->_transport._multicast._read_source);
+#endif  // Z_REACTOR == 1
     } else
 #endif  // Z_MULTICAST_TRANSPORT == 1
     {
@@ -214,7 +280,7 @@ int8_t _zp_stop_read_task(_z_session_t *zn) {
     return ret;
 }
 
-int8_t _zp_start_lease_task(_z_session_t *zn) {
+static int8_t __zp_spawn_lease_task(_z_session_t *zn) {
     int8_t ret = _Z_RES_OK;
 
     _z_task_t *task = (_z_task_t *)z_malloc(sizeof(_z_task_t));
@@ -246,17 +312,42 @@ int8_t _zp_start_lease_task(_z_session_t *zn) {
     return ret;
 }
 
+int8_t _zp_start_lease_task(_z_session_t *zn) {
+    int8_t ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+
+#if Z_REACTOR == 1
+    ret = __zp_attach_lease_task(zn);
+#endif  // Z_REACTOR == 1
+    if (ret == _Z_ERR_TRANSPORT_NOT_AVAILABLE) {
+        ret = __zp_spawn_lease_task(zn);
+    }
+
+    return ret;
+}
+
 int8_t _zp_stop_lease_task(_z_session_t *zn) {
     int8_t ret = _Z_RES_OK;
 
 #if Z_UNICAST_TRANSPORT == 1
     if (zn->_tp->_type == _Z_TRANSPORT_UNICAST_TYPE) {
         zn->_tp->_transport._unicast._lease_task_running = false;
+#if defined(_Z_SYS_WAKER)
+        _z_waker_signal(&zn->_tp->_transport._unicast._lease_waker);
+#endif  // defined(_Z_SYS_WAKER)
+#if Z_REACTOR == 1
+        _z_reactor_detach(&zn->_tp->_transport._unicast._lease_source);
+#endif  // Z_REACTOR == 1
     } else
 #endif  // Z_UNICAST_TRANSPORT == 1
 #if Z_MULTICAST_TRANSPORT == 1
         if (zn->_tp->_type == _Z_TRANSPORT_MULTICAST_TYPE) {
         zn->_tp->_transport._multicast._lease_task_running = false;
+#if defined(_Z_SYS_WAKER)
+        _z_waker_signal(&zn->_tp->_transport._multicast._lease_waker);
+#endif  // defined(_Z_SYS_WAKER)
+#if Z_REACTOR == 1
+        _z_reactor_detach(&zn->_tp->_transport._multicast._lease_source);
+#endif  // Z_REACTOR == 1
     } else
 #endif  // Z_MULTICAST_TRANSPORT == 1
     {
@@ -266,3 +357,86 @@ int8_t _zp_stop_lease_task(_z_session_t *zn) {
     return ret;
 }
 #endif  // Z_MULTI_THREAD == 1
+
+#if Z_TX_QUEUE == 1
+int8_t _zp_start_write_task(_z_session_t *zn, zp_drop_policy_t drop_policy, uint32_t block_timeout) {
+    int8_t ret = _Z_RES_OK;
+
+#if Z_UNICAST_TRANSPORT == 1
+    if (zn->_tp->_type == _Z_TRANSPORT_UNICAST_TYPE) {
+        _z_transport_unicast_t *ztu = &zn->_tp->_transport._unicast;
+        if (ztu->_write_task_running == true) {
+            ret = _Z_ERR_TASK_START_FAILED;  // Only one write task per transport
+        } else if (ztu->_tx_queue._slots == NULL) {
+            ret = _z_tx_queue_init(&ztu->_tx_queue);  // The queue is only allocated if used
+        }
+
+        if (ret == _Z_RES_OK) {
+            _z_task_t *task = (_z_task_t *)z_malloc(sizeof(_z_task_t));
+            (void)memset(task, 0, sizeof(_z_task_t));
+
+            ztu->_tx_drop_policy = drop_policy;
+            ztu->_tx_block_timeout = block_timeout;
+
+            // Set before starting the task, so that it is not reset by an early stop
+            ztu->_write_task_running = true;
+            ztu->_write_task = task;
+            if (_z_task_init(task, NULL, _zp_unicast_write_task, ztu) != _Z_RES_OK) {
+                ztu->_write_task_running = false;
+                ztu->_write_task = NULL;
+                ret = _Z_ERR_TASK_START_FAILED;
+                z_free(task);
+            }
+        }
+    } else
+#endif  // Z_UNICAST_TRANSPORT == 1
+    {
+        ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+    }
+
+    return ret;
+}
+
+int8_t _zp_stop_write_task(_z_session_t *zn) {
+    int8_t ret = _Z_RES_OK;
+
+#if Z_UNICAST_TRANSPORT == 1
+    if (zn->_tp->_type == _Z_TRANSPORT_UNICAST_TYPE) {
+        _zp_unicast_stop_write_task(&zn->_tp->_transport._unicast);
+    } else
+#endif  // Z_UNICAST_TRANSPORT == 1
+    {
+        ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+    }
+
+    return ret;
+}
+
+int8_t _zp_tx_stats(_z_session_t *zn, size_t *dropped, size_t *timed_out) {
+    int8_t ret = _Z_RES_OK;
+
+#if Z_UNICAST_TRANSPORT == 1
+    if (zn->_tp->_type == _Z_TRANSPORT_UNICAST_TYPE) {
+        *dropped = atomic_load_explicit(&zn->_tp->_transport._unicast._tx_dropped, memory_order_relaxed);
+        *timed_out = atomic_load_explicit(&zn->_tp->_transport._unicast._tx_timed_out, memory_order_relaxed);
+    } else
+#endif  // Z_UNICAST_TRANSPORT == 1
+    {
+        ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+    }
+
+    return ret;
+}
+#endif  // Z_TX_QUEUE == 1
+
+#if Z_EXECUTOR == 1
+int8_t _zp_start_executor_task(_z_session_t *zn, size_t workers) { return _z_executor_start(&zn->_executor, workers); }
+
+int8_t _zp_stop_executor_task(_z_session_t *zn) { return _z_executor_stop(&zn->_executor); }
+
+int8_t _zp_executor_stats(_z_session_t *zn, size_t *queued, size_t *high_water_mark) {
+    _z_executor_stats(&zn->_executor, queued, high_water_mark);
+    return _Z_RES_OK;
+}
+#endif  // Z_EXECUTOR == 1
+
@@ -199,7 +199,7 @@ void _z_zbuf_clear(_z_zbuf_t *zbf) { _z_iosli_clear(&zbf->_ios); }
 void _z_zbuf_compact(_z_zbuf_t *zbf) {
     if ((zbf->_ios._r_pos != 0) || (zbf->_ios._w_pos != 0)) {
         size_t len = _z_iosli_readable(&zbf->_ios);
-        (void)memcpy(zbf->_ios._buf, _z_zbuf_get_rptr(zbf), len);
+        (void)memmove(zbf->_ios._buf, _z_zbuf_get_rptr(zbf), len);
         _z_zbuf_set_rpos(zbf, 0);
         _z_zbuf_set_wpos(zbf, len);
     }
@@ -214,6 +214,9 @@ void _z_zbuf_free(_z_zbuf_t **zbf) {
 }
 
 /*------------------ WBuf ------------------*/
+// Used to take ioslices out of a vector without freeing them
+static void __z_iosli_elem_keep(void **ios) { (void)(ios); }
+
 void _z_wbuf_add_iosli(_z_wbuf_t *wbf, _z_iosli_t *ios) {
     wbf->_w_idx = wbf->_w_idx + 1;
     _z_iosli_vec_append(&wbf->_ioss, ios);
@@ -225,6 +228,40 @@ _z_iosli_t *__z_wbuf_new_iosli(size_t capacity) {
     return ios;
 }
 
+// Gets an ioslice pointing to the given bytes, recycling one released on reset if any
+static _z_iosli_t *__z_wbuf_new_view(_z_wbuf_t *wbf, const uint8_t *bs, size_t length) {
+    _z_iosli_t *ios = NULL;
+
+    size_t len = _z_iosli_vec_len(&wbf->_views);
+    if (len > (size_t)0) {
+        ios = _z_iosli_vec_get(&wbf->_views, len - (size_t)1);
+        _z_vec_remove(&wbf->_views, len - (size_t)1, __z_iosli_elem_keep);
+    } else {
+        ios = (_z_iosli_t *)z_malloc(sizeof(_z_iosli_t));
+    }
+
+    if (ios != NULL) {
+        *ios = _z_iosli_wrap(bs, length, 0, length);
+    }
+
+    return ios;
+}
+
+// Gets an ioslice of Z_IOSLICE_SIZE bytes to expand the wbuf, recycling one released on reset if any
+static _z_iosli_t *__z_wbuf_new_spare(_z_wbuf_t *wbf) {
+    _z_iosli_t *ios = NULL;
+
+    size_t len = _z_iosli_vec_len(&wbf->_spares);
+    if (len > (size_t)0) {
+        ios = _z_iosli_vec_get(&wbf->_spares, len - (size_t)1);
+        _z_vec_remove(&wbf->_spares, len - (size_t)1, __z_iosli_elem_keep);
+    } else {
+        ios = __z_wbuf_new_iosli(Z_IOSLICE_SIZE);
+    }
+
+    return ios;
+}
+
 _z_iosli_t *_z_wbuf_get_iosli(const _z_wbuf_t *wbf, size_t idx) { return _z_iosli_vec_get(&wbf->_ioss, idx); }
 
 size_t _z_wbuf_len_iosli(const _z_wbuf_t *wbf) { return _z_iosli_vec_len(&wbf->_ioss); }
@@ -240,6 +277,8 @@ _z_wbuf_t _z_wbuf_make(size_t capacity, _Bool is_expandable) {
         wbf._ioss = _z_iosli_vec_make(1);
         _z_wbuf_add_iosli(&wbf, __z_wbuf_new_iosli(capacity));
     }
+    wbf._views = _z_iosli_vec_make(0);
+    wbf._spares = _z_iosli_vec_make(0);
     wbf._w_idx = 0;  // This __must__ come after adding ioslices to reset w_idx
     wbf._r_idx = 0;
     wbf._is_expandable = is_expandable;
@@ -336,7 +375,7 @@ int8_t _z_wbuf_write(_z_wbuf_t *wbf, uint8_t b) {
     if (writable >= (size_t)1) {
         _z_iosli_write(ios, b);
     } else if (wbf->_is_expandable == true) {
-        ios = __z_wbuf_new_iosli(Z_IOSLICE_SIZE);
+        ios = __z_wbuf_new_spare(wbf);
         _z_wbuf_add_iosli(wbf, ios);
         _z_iosli_write(ios, b);
     } else {
@@ -361,7 +400,7 @@ int8_t _z_wbuf_write_bytes(_z_wbuf_t *wbf, const uint8_t *bs, size_t offset, siz
         llength = llength - writable;
         loffset = loffset + writable;
         while (llength > (size_t)0) {
-            ios = __z_wbuf_new_iosli(Z_IOSLICE_SIZE);
+            ios = __z_wbuf_new_spare(wbf);
             _z_wbuf_add_iosli(wbf, ios);
 
             writable = _z_iosli_writable(ios);
@@ -386,11 +425,15 @@ int8_t _z_wbuf_wrap_bytes(_z_wbuf_t *wbf, const uint8_t *bs, size_t offset, size
     _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, wbf->_w_idx);
     size_t writable = _z_iosli_writable(ios);
     ios->_capacity = ios->_w_pos;  // Block writing on this ioslice
-                                   // The remaining space is allocated in a new ioslice
+                                   // The remaining space is written through a view placed after the wrapped bytes
+    uint8_t *space = _z_ptr_u8_offset(ios->_buf, (ptrdiff_t)ios->_w_pos);
 
-    _z_iosli_t wios = _z_iosli_wrap(bs, length, offset, offset + length);
-    _z_wbuf_add_iosli(wbf, _z_iosli_clone(&wios));
-    _z_wbuf_add_iosli(wbf, __z_wbuf_new_iosli(writable));
+    _z_wbuf_add_iosli(wbf, __z_wbuf_new_view(wbf, bs + offset, length));
+    _z_iosli_t *tail = __z_wbuf_new_view(wbf, space, writable);
+    if (tail != NULL) {
+        tail->_w_pos = 0;
+    }
+    _z_wbuf_add_iosli(wbf, tail);
 
     return ret;
 }
@@ -477,6 +520,35 @@ void _z_wbuf_set_wpos(_z_wbuf_t *wbf, size_t pos) {
     } while (1);
 }
 
+// Wraps the content of a non-expandable wbuf in a zbuf, without copying it
+_z_zbuf_t _z_wbuf_as_zbuf(const _z_wbuf_t *wbf) {
+    assert(_z_wbuf_len_iosli(wbf) == (size_t)1);
+    _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, 0);
+    _z_zbuf_t zbf;
+    zbf._ios = _z_iosli_wrap(_z_cptr_u8_offset(ios->_buf, (ptrdiff_t)ios->_r_pos), _z_iosli_readable(ios), 0,
+                             _z_iosli_readable(ios));
+    return zbf;
+}
+
+// Grows a non-expandable wbuf to the given capacity, keeping its content
+int8_t _z_wbuf_reserve(_z_wbuf_t *wbf, size_t capacity) {
+    int8_t ret = _Z_RES_OK;
+
+    if ((wbf->_is_expandable == false) && (capacity > wbf->_capacity)) {
+        _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, 0);
+        uint8_t *buf = (uint8_t *)z_realloc(ios->_buf, capacity);
+        if (buf != NULL) {
+            ios->_buf = buf;
+            ios->_capacity = capacity;
+            wbf->_capacity = capacity;
+        } else {
+            ret = _Z_ERR_IOBUF_NO_SPACE;
+        }
+    }
+
+    return ret;
+}
+
 _z_zbuf_t _z_wbuf_to_zbuf(const _z_wbuf_t *wbf) {
     size_t len = _z_wbuf_len(wbf);
     _z_zbuf_t zbf = _z_zbuf_make(len);
@@ -490,10 +562,44 @@ _z_zbuf_t _z_wbuf_to_zbuf(const _z_wbuf_t *wbf) {
 int8_t _z_wbuf_siphon(_z_wbuf_t *dst, _z_wbuf_t *src, size_t length) {
     int8_t ret = _Z_RES_OK;
 
-    for (size_t i = 0; i < length; i++) {
-        ret = _z_wbuf_write(dst, _z_wbuf_read(src));
-        if (ret != _Z_RES_OK) {
-            break;
+    size_t llength = length;
+    while ((llength > (size_t)0) && (ret == _Z_RES_OK)) {
+        assert(src->_r_idx <= src->_w_idx);
+        _z_iosli_t *ios = _z_wbuf_get_iosli(src, src->_r_idx);
+        size_t readable = _z_iosli_readable(ios);
+        if (readable > (size_t)0) {
+            size_t to_copy = (readable <= llength) ? readable : llength;
+            ret = _z_wbuf_write_bytes(dst, ios->_buf, ios->_r_pos, to_copy);
+            ios->_r_pos = ios->_r_pos + to_copy;
+            llength = llength - to_copy;
+        } else {
+            src->_r_idx = src->_r_idx + (size_t)1;
+        }
+    }
+
+    return ret;
+}
+
+// Like _z_wbuf_siphon, but the bytes are not copied: dst gets ioslices pointing into src memory,
+// which must then outlive dst content. No further bytes can be written on dst until it is reset.
+int8_t _z_wbuf_siphon_wrap(_z_wbuf_t *dst, _z_wbuf_t *src, size_t length) {
+    int8_t ret = _Z_RES_OK;
+
+    _z_iosli_t *ios = _z_wbuf_get_iosli(dst, dst->_w_idx);
+    ios->_capacity = ios->_w_pos;  // Block writing on this ioslice, the views are appended after it
+
+    size_t llength = length;
+    while (llength > (size_t)0) {
+        assert(src->_r_idx <= src->_w_idx);
+        ios = _z_wbuf_get_iosli(src, src->_r_idx);
+        size_t readable = _z_iosli_readable(ios);
+        if (readable > (size_t)0) {
+            size_t to_wrap = (readable <= llength) ? readable : llength;
+            _z_wbuf_add_iosli(dst, __z_wbuf_new_view(dst, ios->_buf + ios->_r_pos, to_wrap));
+            ios->_r_pos = ios->_r_pos + to_wrap;
+            llength = llength - to_wrap;
+        } else {
+            src->_r_idx = src->_r_idx + (size_t)1;
         }
     }
 
@@ -506,6 +612,8 @@ void _z_wbuf_copy(_z_wbuf_t *dst, const _z_wbuf_t *src) {
     dst->_w_idx = src->_w_idx;
     dst->_is_expandable = src->_is_expandable;
     _z_iosli_vec_copy(&dst->_ioss, &src->_ioss);
+    dst->_views = _z_iosli_vec_make(0);
+    dst->_spares = _z_iosli_vec_make(0);
 }
 
 void _z_wbuf_reset(_z_wbuf_t *wbf) {
@@ -513,17 +621,36 @@ void _z_wbuf_reset(_z_wbuf_t *wbf) {
     wbf->_w_idx = 0;
 
     // Reset to default iosli allocation
-    for (size_t i = 0; i < _z_wbuf_len_iosli(wbf); i++) {
+    size_t i = _z_wbuf_len_iosli(wbf);
+    while (i > (size_t)0) {
+        i = i - (size_t)1;
         _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, i);
         if (ios->_is_alloc == false) {
-            _z_iosli_vec_remove(&wbf->_ioss, i);
+            // Keep the ioslice for the next bytes to be wrapped
+            _z_vec_remove(&wbf->_ioss, i, __z_iosli_elem_keep);
+            _z_iosli_vec_append(&wbf->_views, ios);
+        } else if (i > (size_t)0) {
+            // Keep the ioslice for the next expansion, restoring the capacity blocked by wrapping bytes after it
+            _z_iosli_reset(ios);
+            ios->_capacity = Z_IOSLICE_SIZE;
+            _z_vec_remove(&wbf->_ioss, i, __z_iosli_elem_keep);
+            _z_iosli_vec_append(&wbf->_spares, ios);
         } else {
             _z_iosli_reset(ios);
         }
     }
+
+    // Only the first ioslice is left, whose writing may have been blocked by wrapping bytes after it: restore its
+    // capacity. An expandable wbuf starts with Z_IOSLICE_SIZE bytes, whatever the capacity it has been made with.
+    _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, 0);
+    ios->_capacity = (wbf->_is_expandable == true) ? (size_t)Z_IOSLICE_SIZE : wbf->_capacity;
 }
 
-void _z_wbuf_clear(_z_wbuf_t *wbf) { _z_iosli_vec_clear(&wbf->_ioss); }
+void _z_wbuf_clear(_z_wbuf_t *wbf) {
+    _z_iosli_vec_clear(&wbf->_ioss);
+    _z_iosli_vec_clear(&wbf->_views);
+    _z_iosli_vec_clear(&wbf->_spares);
+}
 
 void _z_wbuf_free(_z_wbuf_t **wbf) {
     _z_wbuf_t *ptr = *wbf;
@@ -346,9 +346,12 @@ _Bool _z_ke_chunk_intersect_stardsl(_z_str_t l, _z_str_t r) {
             } else {
                 result = _z_ke_chunk_intersect_rhasstardsl(r, l);
             }
-        } else {
-            // r is guaranteed to have a stardsl if l doesn't and this function has been called.
+        } else if (_z_strstr(r.start, r.end, _Z_DOLLAR_STAR) != NULL) {
             result = _z_ke_chunk_intersect_rhasstardsl(l, r);
+        } else {
+            // This matcher is picked when any chunk of either expression has a stardsl, so both chunks may be
+            // verbatim: the verbatim comparison above already ruled out the intersection.
+            result = false;
         }
     }
 
@@ -430,6 +433,7 @@ _Bool _z_ke_intersect_rhassuperchunks(_z_str_t l, _z_str_t r, _z_ke_chunk_matche
             }
             h = _z_splitstr_next(&haystack);
         }
+        result = needle_found;
     }
     return result;
 }
@@ -591,11 +595,9 @@ _Bool _z_keyexpr_intersects(const char *lstart, const size_t llen, const char *r
                         break;
                     }
                 }
-            } else if (((lwildness & (int8_t)_ZP_WILDNESS_SUPERCHUNKS) == (int8_t)_ZP_WILDNESS_SUPERCHUNKS) &&
-                       (ln_chunks <= (rn_chunks * (size_t)2 + (size_t)1))) {
+            } else if ((lwildness & (int8_t)_ZP_WILDNESS_SUPERCHUNKS) == (int8_t)_ZP_WILDNESS_SUPERCHUNKS) {
                 result = _z_ke_intersect_rhassuperchunks(r, l, chunk_intersector);
-            } else if (((rwildness & (int8_t)_ZP_WILDNESS_SUPERCHUNKS) == (int8_t)_ZP_WILDNESS_SUPERCHUNKS) &&
-                       (rn_chunks <= (ln_chunks * (size_t)2 + (size_t)1))) {
+            } else if ((rwildness & (int8_t)_ZP_WILDNESS_SUPERCHUNKS) == (int8_t)_ZP_WILDNESS_SUPERCHUNKS) {
                 result = _z_ke_intersect_rhassuperchunks(l, r, chunk_intersector);
             } else if (ln_chunks == rn_chunks) {
                 // no superchunks, just iterate and check chunk intersection
@@ -0,0 +1,459 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/protocol/keyexpr_tree.h"
+
+#include <string.h>
+
+#include "zenoh-pico/protocol/keyexpr.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/result.h"
+
+#define _Z_KEYEXPR_TREE_CHILDREN_MIN_CAPACITY 4
+#define _Z_KEYEXPR_TREE_VALUES_MIN_CAPACITY 2
+
+typedef struct __z_keyexpr_tree_node_t {
+    struct __z_keyexpr_tree_node_t *_parent;
+    char *_chunk;
+    size_t _chunk_len;
+    size_t _hash;
+
+    // Children with a literal chunk, in an open-addressing table with linear probing
+    struct __z_keyexpr_tree_node_t **_children;
+    size_t _children_capacity;
+    size_t _children_len;
+    // Children with a wildcard chunk, the ones with ``$*`` being linked through their _next_dsl
+    struct __z_keyexpr_tree_node_t *_star;
+    struct __z_keyexpr_tree_node_t *_double_star;
+    struct __z_keyexpr_tree_node_t *_dsl;
+    struct __z_keyexpr_tree_node_t *_next_dsl;
+
+    // Values of the key expression ending with this chunk
+    void **_values;
+    size_t _values_len;
+    size_t _values_capacity;
+    size_t _gen;
+} _z_keyexpr_tree_node_t;
+
+// FNV-1a hash of a chunk
+static size_t __z_keyexpr_tree_chunk_hash(const char *chunk, size_t len) {
+    uint32_t h = 2166136261U;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ (uint8_t)chunk[i]) * 16777619U;
+    }
+    return (size_t)h;
+}
+
+// Returns the length of the chunk starting at pos, which ends at the next delimiter or at the end of the key
+static size_t __z_keyexpr_tree_chunk_len(const char *key, size_t len, size_t pos) {
+    size_t end = pos;
+    while ((end < len) && (key[end] != '/')) {
+        end = end + (size_t)1;
+    }
+    return end - pos;
+}
+
+static _Bool __z_keyexpr_tree_is_star(const char *chunk, size_t len) { return (len == (size_t)1) && (chunk[0] == '*'); }
+
+static _Bool __z_keyexpr_tree_is_double_star(const char *chunk, size_t len) {
+    return (len == (size_t)2) && (chunk[0] == '*') && (chunk[1] == '*');
+}
+
+static _Bool __z_keyexpr_tree_node_is_empty(const _z_keyexpr_tree_node_t *node) {
+    return (node->_values_len == (size_t)0) && (node->_children_len == (size_t)0) && (node->_star == NULL) &&
+           (node->_double_star == NULL) && (node->_dsl == NULL);
+}
+
+static _z_keyexpr_tree_node_t *__z_keyexpr_tree_node_new(_z_keyexpr_tree_node_t *parent, const char *chunk,
+                                                         size_t len) {
+    _z_keyexpr_tree_node_t *node = (_z_keyexpr_tree_node_t *)z_malloc(sizeof(_z_keyexpr_tree_node_t));
+    if (node != NULL) {
+        (void)memset(node, 0, sizeof(_z_keyexpr_tree_node_t));
+        node->_parent = parent;
+        if (len > (size_t)0) {
+            node->_chunk = (char *)z_malloc(len);
+            if (node->_chunk != NULL) {
+                (void)memcpy(node->_chunk, chunk, len);
+            } else {
+                z_free(node);
+                node = NULL;
+            }
+        }
+    }
+    if (node != NULL) {
+        node->_chunk_len = len;
+        node->_hash = __z_keyexpr_tree_chunk_hash(chunk, len);
+    }
+
+    return node;
+}
+
+static void __z_keyexpr_tree_node_free(_z_keyexpr_tree_node_t *node) {
+    for (size_t i = 0; i < node->_children_capacity; i++) {
+        if (node->_children[i] != NULL) {
+            __z_keyexpr_tree_node_free(node->_children[i]);
+        }
+    }
+    if (node->_star != NULL) {
+        __z_keyexpr_tree_node_free(node->_star);
+    }
+    if (node->_double_star != NULL) {
+        __z_keyexpr_tree_node_free(node->_double_star);
+    }
+    _z_keyexpr_tree_node_t *dsl = node->_dsl;
+    while (dsl != NULL) {
+        _z_keyexpr_tree_node_t *next = dsl->_next_dsl;
+        __z_keyexpr_tree_node_free(dsl);
+        dsl = next;
+    }
+
+    z_free(node->_children);
+    z_free(node->_values);
+    z_free(node->_chunk);
+    z_free(node);
+}
+
+/*------------------ Literal children ------------------*/
+// Puts a child in the first free slot of its probing sequence, the table is expected to have one
+static void __z_keyexpr_tree_children_place(_z_keyexpr_tree_node_t *node, _z_keyexpr_tree_node_t *child) {
+    size_t mask = node->_children_capacity - (size_t)1;
+    size_t i = child->_hash & mask;
+    while (node->_children[i] != NULL) {
+        i = (i + (size_t)1) & mask;
+    }
+    node->_children[i] = child;
+}
+
+static int8_t __z_keyexpr_tree_children_reserve(_z_keyexpr_tree_node_t *node) {
+    int8_t ret = _Z_RES_OK;
+
+    // Keep the load factor under 3/4, so that probing sequences remain short
+    if (((node->_children_len + (size_t)1) * (size_t)4) > (node->_children_capacity * (size_t)3)) {
+        size_t capacity = (node->_children_capacity == (size_t)0) ? (size_t)_Z_KEYEXPR_TREE_CHILDREN_MIN_CAPACITY
+                                                                  : (node->_children_capacity * (size_t)2);
+        _z_keyexpr_tree_node_t **children =
+            (_z_keyexpr_tree_node_t **)z_malloc(capacity * sizeof(_z_keyexpr_tree_node_t *));
+        if (children != NULL) {
+            (void)memset(children, 0, capacity * sizeof(_z_keyexpr_tree_node_t *));
+
+            _z_keyexpr_tree_node_t **old_children = node->_children;
+            size_t old_capacity = node->_children_capacity;
+            node->_children = children;
+            node->_children_capacity = capacity;
+            for (size_t i = 0; i < old_capacity; i++) {
+                if (old_children[i] != NULL) {
+                    __z_keyexpr_tree_children_place(node, old_children[i]);
+                }
+            }
+            z_free(old_children);
+        } else {
+            ret = _Z_ERR_GENERIC;
+        }
+    }
+
+    return ret;
+}
+
+// Returns the slot of the child with the given chunk, or the capacity of the table if there is none
+static size_t __z_keyexpr_tree_children_find(const _z_keyexpr_tree_node_t *node, const char *chunk, size_t len,
+                                             size_t hash) {
+    size_t ret = node->_children_capacity;
+
+    if (node->_children_len > (size_t)0) {
+        size_t mask = node->_children_capacity - (size_t)1;
+        size_t i = hash & mask;
+        while (node->_children[i] != NULL) {
+            _z_keyexpr_tree_node_t *child = node->_children[i];
+            if ((child->_hash == hash) && (child->_chunk_len == len) && (memcmp(child->_chunk, chunk, len) == 0)) {
+                ret = i;
+                break;
+            }
+            i = (i + (size_t)1) & mask;
+        }
+    }
+
+    return ret;
+}
+
+static void __z_keyexpr_tree_children_remove(_z_keyexpr_tree_node_t *node, size_t i) {
+    node->_children[i] = NULL;
+    node->_children_len = node->_children_len - (size_t)1;
+
+    // Shift back the following children of the cluster that cannot be reached anymore through the freed slot
+    size_t mask = node->_children_capacity - (size_t)1;
+    size_t hole = i;
+    size_t j = (i + (size_t)1) & mask;
+    while (node->_children[j] != NULL) {
+        size_t home = node->_children[j]->_hash & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            node->_children[hole] = node->_children[j];
+            node->_children[j] = NULL;
+            hole = j;
+        }
+        j = (j + (size_t)1) & mask;
+    }
+}
+
+/*------------------ Children of any kind ------------------*/
+// Returns the child with the given chunk, or NULL if there is none
+static _z_keyexpr_tree_node_t *__z_keyexpr_tree_child_get(const _z_keyexpr_tree_node_t *node, const char *chunk,
+                                                          size_t len) {
+    _z_keyexpr_tree_node_t *ret = NULL;
+
+    if (__z_keyexpr_tree_is_star(chunk, len) == true) {
+        ret = node->_star;
+    } else if (__z_keyexpr_tree_is_double_star(chunk, len) == true) {
+        ret = node->_double_star;
+    } else if (memchr(chunk, '$', len) != NULL) {
+        ret = node->_dsl;
+        while ((ret != NULL) && ((ret->_chunk_len != len) || (memcmp(ret->_chunk, chunk, len) != 0))) {
+            ret = ret->_next_dsl;
+        }
+    } else {
+        size_t i = __z_keyexpr_tree_children_find(node, chunk, len, __z_keyexpr_tree_chunk_hash(chunk, len));
+        if (i < node->_children_capacity) {
+            ret = node->_children[i];
+        }
+    }
+
+    return ret;
+}
+
+// Returns the child with the given chunk, which is created if there is none
+static _z_keyexpr_tree_node_t *__z_keyexpr_tree_child_get_or_add(_z_keyexpr_tree_node_t *node, const char *chunk,
+                                                                 size_t len) {
+    _z_keyexpr_tree_node_t *ret = __z_keyexpr_tree_child_get(node, chunk, len);
+    if (ret == NULL) {
+        _Bool is_literal = (__z_keyexpr_tree_is_star(chunk, len) == false) &&
+                           (__z_keyexpr_tree_is_double_star(chunk, len) == false) &&
+                           (memchr(chunk, '$', len) == NULL);
+        if ((is_literal == false) || (__z_keyexpr_tree_children_reserve(node) == _Z_RES_OK)) {
+            ret = __z_keyexpr_tree_node_new(node, chunk, len);
+        }
+        if (ret == NULL) {
+            // Out of memory
+        } else if (__z_keyexpr_tree_is_star(chunk, len) == true) {
+            node->_star = ret;
+        } else if (__z_keyexpr_tree_is_double_star(chunk, len) == true) {
+            node->_double_star = ret;
+        } else if (is_literal == false) {
+            ret->_next_dsl = node->_dsl;
+            node->_dsl = ret;
+        } else {
+            __z_keyexpr_tree_children_place(node, ret);
+            node->_children_len = node->_children_len + (size_t)1;
+        }
+    }
+
+    return ret;
+}
+
+static void __z_keyexpr_tree_child_remove(_z_keyexpr_tree_node_t *node, _z_keyexpr_tree_node_t *child) {
+    if (node->_star == child) {
+        node->_star = NULL;
+    } else if (node->_double_star == child) {
+        node->_double_star = NULL;
+    } else if (memchr(child->_chunk, '$', child->_chunk_len) != NULL) {
+        _z_keyexpr_tree_node_t **link = &node->_dsl;
+        while (*link != child) {
+            link = &(*link)->_next_dsl;
+        }
+        *link = child->_next_dsl;
+    } else {
+        __z_keyexpr_tree_children_remove(
+            node, __z_keyexpr_tree_children_find(node, child->_chunk, child->_chunk_len, child->_hash));
+    }
+}
+
+// Returns the node of the key expression, or NULL if there is none
+static _z_keyexpr_tree_node_t *__z_keyexpr_tree_get(const _z_keyexpr_tree_t *tree, const char *key, size_t len) {
+    _z_keyexpr_tree_node_t *node = tree->_root;
+    size_t pos = 0;
+    while ((node != NULL) && (pos <= len)) {
+        size_t chunk_len = __z_keyexpr_tree_chunk_len(key, len, pos);
+        node = __z_keyexpr_tree_child_get(node, &key[pos], chunk_len);
+        pos = pos + chunk_len + (size_t)1;
+    }
+
+    return node;
+}
+
+/*------------------ Tree ------------------*/
+_z_keyexpr_tree_t _z_keyexpr_tree_make(void) {
+    _z_keyexpr_tree_t tree;
+    tree._root = NULL;
+    tree._len = 0;
+    tree._gen = 0;
+    return tree;
+}
+
+void _z_keyexpr_tree_clear(_z_keyexpr_tree_t *tree) {
+    if (tree->_root != NULL) {
+        __z_keyexpr_tree_node_free(tree->_root);
+    }
+    *tree = _z_keyexpr_tree_make();
+}
+
+int8_t _z_keyexpr_tree_insert(_z_keyexpr_tree_t *tree, const char *key, size_t len, void *value) {
+    int8_t ret = _Z_RES_OK;
+
+    if (tree->_root == NULL) {
+        tree->_root = __z_keyexpr_tree_node_new(NULL, NULL, 0);
+    }
+    _z_keyexpr_tree_node_t *node = tree->_root;
+    size_t pos = 0;
+    while ((node != NULL) && (pos <= len)) {
+        size_t chunk_len = __z_keyexpr_tree_chunk_len(key, len, pos);
+        node = __z_keyexpr_tree_child_get_or_add(node, &key[pos], chunk_len);
+        pos = pos + chunk_len + (size_t)1;
+    }
+
+    if ((node != NULL) && (node->_values_len == node->_values_capacity)) {
+        size_t capacity = (node->_values_capacity == (size_t)0) ? (size_t)_Z_KEYEXPR_TREE_VALUES_MIN_CAPACITY
+                                                                : (node->_values_capacity * (size_t)2);
+        void **values = (void **)z_realloc(node->_values, capacity * sizeof(void *));
+        if (values != NULL) {
+            node->_values = values;
+            node->_values_capacity = capacity;
+        } else {
+            node = NULL;
+        }
+    }
+    if (node != NULL) {
+        node->_values[node->_values_len] = value;
+        node->_values_len = node->_values_len + (size_t)1;
+        tree->_len = tree->_len + (size_t)1;
+    } else {
+        // The nodes created so far are pruned along with the next removal under them
+        ret = _Z_ERR_GENERIC;
+    }
+
+    return ret;
+}
+
+void _z_keyexpr_tree_remove(_z_keyexpr_tree_t *tree, const char *key, size_t len, _z_keyexpr_tree_eq_f eq,
+                            const void *arg) {
+    _z_keyexpr_tree_node_t *node = __z_keyexpr_tree_get(tree, key, len);
+    if (node != NULL) {
+        for (size_t i = 0; i < node->_values_len; i++) {
+            if (eq(node->_values[i], arg) == true) {
+                // Move the remaining values, so that they are still visited in insertion order
+                node->_values_len = node->_values_len - (size_t)1;
+                (void)memmove(&node->_values[i], &node->_values[i + (size_t)1],
+                              (node->_values_len - i) * sizeof(void *));
+                tree->_len = tree->_len - (size_t)1;
+                break;
+            }
+        }
+
+        // Prune the nodes left without values nor children
+        while ((node->_parent != NULL) && (__z_keyexpr_tree_node_is_empty(node) == true)) {
+            _z_keyexpr_tree_node_t *parent = node->_parent;
+            __z_keyexpr_tree_child_remove(parent, node);
+            __z_keyexpr_tree_node_free(node);
+            node = parent;
+        }
+    }
+}
+
+void *_z_keyexpr_tree_get(const _z_keyexpr_tree_t *tree, const char *key, size_t len, _z_keyexpr_tree_eq_f eq,
+                          const void *arg) {
+    void *ret = NULL;
+
+    _z_keyexpr_tree_node_t *node = __z_keyexpr_tree_get(tree, key, len);
+    if (node != NULL) {
+        for (size_t i = 0; i < node->_values_len; i++) {
+            if (eq(node->_values[i], arg) == true) {
+                ret = node->_values[i];
+                break;
+            }
+        }
+    }
+
+    return ret;
+}
+
+_Bool _z_keyexpr_tree_is_literal(const char *key, size_t len) {
+    return (memchr(key, '*', len) == NULL) && (memchr(key, '$', len) == NULL);
+}
+
+static void __z_keyexpr_tree_visit(_z_keyexpr_tree_t *tree, _z_keyexpr_tree_node_t *node,
+                                   _z_keyexpr_tree_visit_f visit, void *arg) {
+    // A node can be reached several times through the ``**`` chunks of its key expression, which is only checked when
+    // the tree can be modified
+    if ((tree == NULL) || (node->_gen != tree->_gen)) {
+        if (tree != NULL) {
+            node->_gen = tree->_gen;
+        }
+        for (size_t i = 0; i < node->_values_len; i++) {
+            visit(node->_values[i], arg);
+        }
+    }
+}
+
+// Visits the values under the node intersecting the key from the chunk at pos, which is past the end of the key once
+// all its chunks have been matched
+static void __z_keyexpr_tree_match(_z_keyexpr_tree_t *tree, _z_keyexpr_tree_node_t *node, const char *key,
+                                   size_t len, size_t pos, _z_keyexpr_tree_visit_f visit, void *arg) {
+    if (pos > len) {
+        __z_keyexpr_tree_visit(tree, node, visit, arg);
+        if (node->_double_star != NULL) {
+            __z_keyexpr_tree_match(tree, node->_double_star, key, len, pos, visit, arg);  // Matching no chunk
+        }
+    } else {
+        size_t chunk_len = __z_keyexpr_tree_chunk_len(key, len, pos);
+        size_t next = pos + chunk_len + (size_t)1;
+
+        size_t i = __z_keyexpr_tree_children_find(node, &key[pos], chunk_len,
+                                                  __z_keyexpr_tree_chunk_hash(&key[pos], chunk_len));
+        if (i < node->_children_capacity) {
+            __z_keyexpr_tree_match(tree, node->_children[i], key, len, next, visit, arg);
+        }
+        if (node->_star != NULL) {
+            __z_keyexpr_tree_match(tree, node->_star, key, len, next, visit, arg);
+        }
+        for (_z_keyexpr_tree_node_t *dsl = node->_dsl; dsl != NULL; dsl = dsl->_next_dsl) {
+            if (_z_keyexpr_intersects(dsl->_chunk, dsl->_chunk_len, &key[pos], chunk_len) == true) {
+                __z_keyexpr_tree_match(tree, dsl, key, len, next, visit, arg);
+            }
+        }
+        if (node->_double_star != NULL) {
+            // Match any number of chunks, up to all the remaining ones
+            size_t from = pos;
+            _Bool is_done = false;
+            while (is_done == false) {
+                __z_keyexpr_tree_match(tree, node->_double_star, key, len, from, visit, arg);
+                is_done = from > len;
+                if (is_done == false) {
+                    from = from + __z_keyexpr_tree_chunk_len(key, len, from) + (size_t)1;
+                }
+            }
+        }
+    }
+}
+
+void _z_keyexpr_tree_intersecting(_z_keyexpr_tree_t *tree, const char *key, size_t len,
+                                  _z_keyexpr_tree_visit_f visit, void *arg) {
+    if (tree->_root != NULL) {
+        tree->_gen = tree->_gen + (size_t)1;
+        __z_keyexpr_tree_match(tree, tree->_root, key, len, 0, visit, arg);
+    }
+}
+
+void _z_keyexpr_tree_intersecting_readonly(const _z_keyexpr_tree_t *tree, const char *key, size_t len,
+                                           _z_keyexpr_tree_visit_f visit, void *arg) {
+    if (tree->_root != NULL) {
+        __z_keyexpr_tree_match(NULL, tree->_root, key, len, 0, visit, arg);
+    }
+}
@@ -303,6 +303,7 @@ _z_zenoh_message_t _z_msg_make_data(_z_keyexpr_t key, _z_data_info_t info, _z_pa
     msg._body._data._key = key;
     msg._body._data._info = info;
     msg._body._data._payload = payload;
+    msg._body._data._prefix = _z_bytes_empty();
 
     msg._header = _Z_MID_DATA;
     if (msg._body._data._info._flags != 0) {
@@ -450,6 +451,59 @@ void _z_msg_clear(_z_zenoh_message_t *msg) {
     }
 }
 
+/*------------------ Zenoh Message Arena ------------------*/
+// Messages on the free list have already been cleared: only their storage is left to be released
+static void __z_zenoh_message_elem_release(void **e) {
+    z_free(*e);
+    *e = NULL;
+}
+
+_z_zenoh_message_arena_t _z_zenoh_message_arena_make(size_t capacity) {
+    _z_zenoh_message_arena_t arena;
+    arena._messages = _z_zenoh_message_vec_make(capacity);
+    arena._free = _z_zenoh_message_vec_make(capacity);
+    for (size_t i = 0; i < capacity; i++) {
+        _z_zenoh_message_t *zm = (_z_zenoh_message_t *)z_malloc(sizeof(_z_zenoh_message_t));
+        if (zm != NULL) {
+            _z_zenoh_message_vec_append(&arena._free, zm);
+        }
+    }
+    return arena;
+}
+
+_z_zenoh_message_t *_z_zenoh_message_arena_push(_z_zenoh_message_arena_t *arena) {
+    _z_zenoh_message_t *zm = NULL;
+
+    size_t len = _z_zenoh_message_vec_len(&arena->_free);
+    if (len > (size_t)0) {
+        zm = _z_zenoh_message_vec_get(&arena->_free, len - (size_t)1);
+        _z_vec_remove(&arena->_free, len - (size_t)1, _z_noop_free);
+    } else {
+        zm = (_z_zenoh_message_t *)z_malloc(sizeof(_z_zenoh_message_t));
+    }
+    if (zm != NULL) {
+        _z_zenoh_message_vec_append(&arena->_messages, zm);
+    }
+
+    return zm;
+}
+
+void _z_zenoh_message_arena_reset(_z_zenoh_message_arena_t *arena) {
+    size_t len = _z_zenoh_message_vec_len(&arena->_messages);
+    for (size_t i = 0; i < len; i++) {
+        _z_zenoh_message_t *zm = _z_zenoh_message_vec_get(&arena->_messages, i);
+        _z_msg_clear(zm);
+        _z_zenoh_message_vec_append(&arena->_free, zm);
+    }
+    _z_vec_reset(&arena->_messages, _z_noop_free);
+}
+
+void _z_zenoh_message_arena_clear(_z_zenoh_message_arena_t *arena) {
+    _z_zenoh_message_arena_reset(arena);
+    _z_vec_clear(&arena->_free, __z_zenoh_message_elem_release);
+    _z_zenoh_message_vec_clear(&arena->_messages);
+}
+
 /*=============================*/
 /*     Transport Messages      */
 /*=============================*/
@@ -814,6 +868,7 @@ _z_transport_message_t _z_t_msg_make_frame_header(_z_zint_t sn, _Bool is_reliabl
     _z_transport_message_t msg;
 
     msg._body._frame._sn = sn;
+    msg._body._frame._priority = Z_PRIORITY_DEFAULT;
 
     // Reset payload content
     (void)memset(&msg._body._frame._payload, 0, sizeof(_z_frame_payload_t));
@@ -840,6 +895,7 @@ _z_transport_message_t _z_t_msg_make_frame(_z_zint_t sn, _z_frame_payload_t payl
 
     msg._body._frame._sn = sn;
     msg._body._frame._payload = payload;
+    msg._body._frame._priority = Z_PRIORITY_DEFAULT;
 
     msg._header = _Z_MID_FRAME;
     if (is_reliable == true) {
@@ -979,3 +1035,17 @@ void _z_t_msg_clear(_z_transport_message_t *msg) {
         } break;
     }
 }
+
+// Clears a transport message decoded with _z_transport_message_decode_ar: the zenoh messages of a frame are owned
+// by the arena, which is reset to be reused by the next batch.
+void _z_t_msg_clear_ar(_z_transport_message_t *msg, _z_zenoh_message_arena_t *arena) {
+    if ((_Z_MID(msg->_header) == _Z_MID_FRAME) && (_Z_HAS_FLAG(msg->_header, _Z_FLAG_T_F) == false)) {
+        _z_zenoh_message_arena_reset(arena);
+        if (msg->_attachment != NULL) {
+            _z_t_msg_clear_attachment(msg->_attachment);
+            z_free(msg->_attachment);
+        }
+    } else {
+        _z_t_msg_clear(msg);
+    }
+}
@@ -814,16 +814,29 @@ _z_data_info_result_t _z_data_info_decode(_z_zbuf_t *zbf) {
 }
 
 /*------------------ Data Message ------------------*/
+int8_t _z_data_prefix_encode(_z_wbuf_t *wbf, uint8_t header, const _z_msg_data_t *msg) {
+    int8_t ret = _Z_RES_OK;
+
+    if (msg->_prefix.len > 0) {
+        // The key and the data info have been encoded beforehand
+        ret = _z_wbuf_write_bytes(wbf, msg->_prefix.start, 0, msg->_prefix.len);
+    } else {
+        _Z_EC(_z_keyexpr_encode(wbf, header, &msg->_key))
+
+        if (_Z_HAS_FLAG(header, _Z_FLAG_Z_I) == true) {
+            ret = _z_data_info_encode(wbf, &msg->_info);
+        }
+    }
+
+    return ret;
+}
+
 int8_t _z_data_encode(_z_wbuf_t *wbf, uint8_t header, const _z_msg_data_t *msg) {
     int8_t ret = _Z_RES_OK;
     _Z_DEBUG("Encoding _Z_MID_DATA\n");
 
     // Encode the body
-    _Z_EC(_z_keyexpr_encode(wbf, header, &msg->_key))
-
-    if (_Z_HAS_FLAG(header, _Z_FLAG_Z_I) == true) {
-        _Z_EC(_z_data_info_encode(wbf, &msg->_info))
-    }
+    _Z_EC(_z_data_prefix_encode(wbf, header, msg))
     _Z_EC(_z_payload_encode(wbf, &msg->_payload))
 
     return ret;
@@ -848,6 +861,7 @@ void _z_data_decode_na(_z_zbuf_t *zbf, uint8_t header, _z_data_result_t *r) {
     _z_payload_result_t r_pld = _z_payload_decode(zbf);
     _ASSURE_P_RESULT(r_pld, r, _Z_ERR_PARSE_PAYLOAD)
     r->_value._payload = r_pld._value;
+    r->_value._prefix = _z_bytes_empty();
 }
 
 _z_data_result_t _z_data_decode(_z_zbuf_t *zbf, uint8_t header) {
@@ -1650,9 +1664,10 @@ int8_t _z_frame_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_frame_t *m
     return ret;
 }
 
-void _z_frame_decode_na(_z_zbuf_t *zbf, uint8_t header, _z_frame_result_t *r) {
+void _z_frame_decode_ar(_z_zbuf_t *zbf, uint8_t header, _z_zenoh_message_arena_t *arena, _z_frame_result_t *r) {
     _Z_DEBUG("Decoding _Z_MID_FRAME\n");
     r->_tag = _Z_RES_OK;
+    r->_value._priority = Z_PRIORITY_DEFAULT;
 
     _z_zint_result_t r_zint = _z_zint_decode(zbf);
     _ASSURE_P_RESULT(r_zint, r, _Z_ERR_PARSE_ZINT)
@@ -1665,23 +1680,75 @@ void _z_frame_decode_na(_z_zbuf_t *zbf, uint8_t header, _z_frame_result_t *r) {
 
         // We need to manually move the r_pos to w_pos, we have read it all
         _z_zbuf_set_rpos(zbf, _z_zbuf_get_wpos(zbf));
+    } else if ((Z_RX_STREAMING == 1) && (arena != NULL)) {
+        // Leave the messages to be decoded one at a time by _z_frame_decode_next
+        _z_zenoh_message_arena_reset(arena);
+        r->_value._payload._encoded = _z_bytes_wrap(_z_zbuf_get_rptr(zbf), _z_zbuf_len(zbf));
+        _z_zbuf_set_rpos(zbf, _z_zbuf_get_wpos(zbf));
     } else {
-        r->_value._payload._messages = _z_zenoh_message_vec_make(_ZENOH_PICO_FRAME_MESSAGES_VEC_SIZE);
+        _z_zenoh_message_vec_t *messages = &r->_value._payload._messages;
+        if (arena != NULL) {
+            // Release the messages left over by a previous batch, if any
+            _z_zenoh_message_arena_reset(arena);
+            messages = &arena->_messages;
+        } else {
+            *messages = _z_zenoh_message_vec_make(_ZENOH_PICO_FRAME_MESSAGES_VEC_SIZE);
+        }
+
         while (_z_zbuf_len(zbf) > 0) {
             // Mark the reading position of the iobfer
             size_t r_pos = _z_zbuf_get_rpos(zbf);
             _z_zenoh_message_result_t r_zm = _z_zenoh_message_decode(zbf);
             if (r_zm._tag == _Z_RES_OK) {
-                _z_zenoh_message_t *zm = (_z_zenoh_message_t *)z_malloc(sizeof(_z_zenoh_message_t));
+                _z_zenoh_message_t *zm = NULL;
+                if (arena != NULL) {
+                    zm = _z_zenoh_message_arena_push(arena);
+                } else {
+                    zm = (_z_zenoh_message_t *)z_malloc(sizeof(_z_zenoh_message_t));
+                    _z_zenoh_message_vec_append(messages, zm);
+                }
                 (void)memcpy(zm, &r_zm._value, sizeof(_z_zenoh_message_t));
-                _z_zenoh_message_vec_append(&r->_value._payload._messages, zm);
             } else {
                 // Restore the reading position of the iobfer
                 _z_zbuf_set_rpos(zbf, r_pos);
                 break;
             }
         }
+
+        if (arena != NULL) {
+            // The frame only borrows the messages, which are released when the arena is reset
+            r->_value._payload._messages = arena->_messages;
+        }
+    }
+}
+
+void _z_frame_decode_na(_z_zbuf_t *zbf, uint8_t header, _z_frame_result_t *r) {
+    _z_frame_decode_ar(zbf, header, NULL, r);
+}
+
+_z_zenoh_message_t *_z_frame_decode_next(_z_t_msg_frame_t *msg, _z_zenoh_message_arena_t *arena) {
+    _z_zenoh_message_t *zm = NULL;
+
+    _z_zenoh_message_arena_reset(arena);
+    _z_payload_t *encoded = &msg->_payload._encoded;
+    if (encoded->len > (size_t)0) {
+        _z_zbuf_t zbf;
+        zbf._ios = _z_iosli_wrap(encoded->start, encoded->len, 0, encoded->len);
+        _z_zenoh_message_result_t r_zm = _z_zenoh_message_decode(&zbf);
+        if (r_zm._tag == _Z_RES_OK) {
+            zm = _z_zenoh_message_arena_push(arena);
+        }
+        if (zm != NULL) {
+            (void)memcpy(zm, &r_zm._value, sizeof(_z_zenoh_message_t));
+            encoded->start = _z_zbuf_get_rptr(&zbf);
+            encoded->len = _z_zbuf_len(&zbf);
+        } else {
+            // Drop the rest of the frame, as done when decoding it all at once
+            encoded->len = 0;
+        }
     }
+
+    return zm;
 }
 
 _z_frame_result_t _z_frame_decode(_z_zbuf_t *zbf, uint8_t header) {
@@ -1698,6 +1765,9 @@ int8_t _z_transport_message_encode(_z_wbuf_t *wbf, const _z_transport_message_t
     if (msg->_attachment != NULL) {
         _Z_EC(_z_attachment_encode(wbf, msg->_attachment))
     }
+    if ((_Z_MID(msg->_header) == _Z_MID_FRAME) && (msg->_body._frame._priority != Z_PRIORITY_DEFAULT)) {
+        _Z_EC(_z_wbuf_write(wbf, _Z_PRIORITY_DECORATOR(msg->_body._frame._priority)))
+    }
 
     // Encode the header
     _Z_EC(_z_wbuf_write(wbf, msg->_header))
@@ -1757,8 +1827,10 @@ int8_t _z_transport_message_encode(_z_wbuf_t *wbf, const _z_transport_message_t
     return ret;
 }
 
-void _z_transport_message_decode_na(_z_zbuf_t *zbf, _z_transport_message_result_t *r) {
+void _z_transport_message_decode_ar(_z_zbuf_t *zbf, _z_zenoh_message_arena_t *arena,
+                                    _z_transport_message_result_t *r) {
     _Bool is_last = false;
+    z_priority_t priority = Z_PRIORITY_DEFAULT;
     r->_tag = _Z_RES_OK;
     r->_value._attachment = NULL;
 
@@ -1771,9 +1843,11 @@ void _z_transport_message_decode_na(_z_zbuf_t *zbf, _z_transport_message_result_
         uint8_t mid = _Z_MID(r->_value._header);
         switch (mid) {
             case _Z_MID_FRAME: {
-                _z_frame_result_t r_fr = _z_frame_decode(zbf, r->_value._header);
+                _z_frame_result_t r_fr;
+                _z_frame_decode_ar(zbf, r->_value._header, arena, &r_fr);
                 _ASSURE_P_RESULT(r_fr, r, _Z_ERR_PARSE_TRANSPORT_MESSAGE)
                 r->_value._body._frame = r_fr._value;
+                r->_value._body._frame._priority = priority;
                 is_last = true;
             } break;
 
@@ -1853,10 +1927,9 @@ void _z_transport_message_decode_na(_z_zbuf_t *zbf, _z_transport_message_result_
                 is_last = true;
             } break;
 
-            case _Z_MID_PRIORITY: {  // FIXME: implement PRIORITY parsing
-                _Z_DEBUG("WARNING: Priorities are not supported in zenoh-pico\n");
-                r->_tag = _Z_ERR_PARSE_TRANSPORT_MESSAGE;
-                is_last = true;
+            case _Z_MID_PRIORITY: {
+                // The priority applies to the frame that follows the decorator
+                priority = _Z_PRIORITY_FROM_DECORATOR(r->_value._header);
             } break;
 
             default: {
@@ -1873,6 +1946,10 @@ void _z_transport_message_decode_na(_z_zbuf_t *zbf, _z_transport_message_result_
     } while (1);
 }
 
+void _z_transport_message_decode_na(_z_zbuf_t *zbf, _z_transport_message_result_t *r) {
+    _z_transport_message_decode_ar(zbf, NULL, r);
+}
+
 _z_transport_message_result_t _z_transport_message_decode(_z_zbuf_t *zbf) {
     _z_transport_message_result_t r;
     _z_transport_message_decode_na(zbf, &r);
@@ -0,0 +1,220 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/session/executor.h"
+
+#include <stddef.h>
+
+#include "zenoh-pico/utils/result.h"
+
+#if Z_EXECUTOR == 1
+
+void _z_executor_strand_init(_z_executor_strand_t *strand) {
+    strand->_next = NULL;
+    strand->_head = NULL;
+    strand->_tail = NULL;
+    strand->_depth = 0;
+    strand->_is_scheduled = false;
+}
+
+void _z_executor_init(_z_executor_t *ex) {
+    _z_mutex_init(&ex->_mutex);
+    _z_condvar_init(&ex->_cv);
+    ex->_ready_head = NULL;
+    ex->_ready_tail = NULL;
+    ex->_workers = NULL;
+    ex->_workers_num = 0;
+    ex->_queued = 0;
+    ex->_high_water_mark = 0;
+    ex->_is_running = false;
+}
+
+void _z_executor_clear(_z_executor_t *ex) {
+    (void)_z_executor_stop(ex);
+    _z_condvar_free(&ex->_cv);
+    _z_mutex_free(&ex->_mutex);
+}
+
+// Appends the strand to the ready list, the executor mutex being held
+static void __z_executor_schedule(_z_executor_t *ex, _z_executor_strand_t *strand) {
+    strand->_next = NULL;
+    if (ex->_ready_tail != NULL) {
+        ex->_ready_tail->_next = strand;
+    } else {
+        ex->_ready_head = strand;
+    }
+    ex->_ready_tail = strand;
+    strand->_is_scheduled = true;
+    _z_condvar_signal(&ex->_cv);
+}
+
+static void *__z_executor_task(void *ex_arg) {
+    _z_executor_t *ex = (_z_executor_t *)ex_arg;
+
+    _z_mutex_lock(&ex->_mutex);
+    _Bool is_running = true;
+    while (is_running == true) {
+        _z_executor_strand_t *strand = ex->_ready_head;
+        if (strand != NULL) {
+            // Take the strand out of the ready list, so that its jobs are run by a single worker at a time
+            ex->_ready_head = strand->_next;
+            if (ex->_ready_head == NULL) {
+                ex->_ready_tail = NULL;
+            }
+            _z_executor_job_t *job = strand->_head;
+            strand->_head = job->_next;
+            if (strand->_head == NULL) {
+                strand->_tail = NULL;
+            }
+            _z_mutex_unlock(&ex->_mutex);
+
+            job->_run(job);
+
+            _z_mutex_lock(&ex->_mutex);
+            strand->_depth = strand->_depth - (size_t)1;
+            ex->_queued = ex->_queued - (size_t)1;
+            if (strand->_head != NULL) {
+                __z_executor_schedule(ex, strand);  // Behind the other strands, for fairness
+            } else {
+                strand->_is_scheduled = false;
+            }
+            _z_mutex_unlock(&ex->_mutex);
+
+            // Released once the strand is no longer accessed, as it may be released along with the job
+            job->_free(job);
+
+            _z_mutex_lock(&ex->_mutex);
+        } else if (ex->_is_running == true) {
+            _z_condvar_wait(&ex->_cv, &ex->_mutex);
+        } else {
+            is_running = false;  // Stopped, and all the queued jobs have been run
+        }
+    }
+    // Wake up the next worker, so that it notices the executor has been stopped as well
+    _z_condvar_signal(&ex->_cv);
+    _z_mutex_unlock(&ex->_mutex);
+
+    return NULL;
+}
+
+int8_t _z_executor_start(_z_executor_t *ex, size_t workers) {
+    int8_t ret = _Z_RES_OK;
+
+    _z_mutex_lock(&ex->_mutex);
+    if ((workers == (size_t)0) || (ex->_workers != NULL)) {
+        ret = _Z_ERR_TASK_START_FAILED;
+    } else {
+        ex->_workers = (_z_task_t *)z_malloc(workers * sizeof(_z_task_t));
+        if (ex->_workers != NULL) {
+            ex->_is_running = true;
+        } else {
+            ret = _Z_ERR_TASK_START_FAILED;
+        }
+    }
+    _z_mutex_unlock(&ex->_mutex);
+
+    for (size_t i = 0; (i < workers) && (ret == _Z_RES_OK); i++) {
+        if (_z_task_init(&ex->_workers[i], NULL, __z_executor_task, ex) == 0) {
+            ex->_workers_num = ex->_workers_num + (size_t)1;
+        } else {
+            ret = _Z_ERR_TASK_START_FAILED;
+        }
+    }
+    if ((ret != _Z_RES_OK) && (ex->_workers != NULL)) {
+        (void)_z_executor_stop(ex);  // Stop the workers started so far
+    }
+
+    return ret;
+}
+
+int8_t _z_executor_stop(_z_executor_t *ex) {
+    int8_t ret = _Z_RES_OK;
+
+    _z_mutex_lock(&ex->_mutex);
+    if (ex->_workers != NULL) {
+        ex->_is_running = false;
+        _z_condvar_signal(&ex->_cv);
+    } else {
+        ret = _Z_ERR_TASK_START_FAILED;
+    }
+    _z_mutex_unlock(&ex->_mutex);
+
+    if (ret == _Z_RES_OK) {
+        for (size_t i = 0; i < ex->_workers_num; i++) {
+            _z_task_join(&ex->_workers[i]);
+        }
+        z_free(ex->_workers);
+        ex->_workers = NULL;
+        ex->_workers_num = 0;
+    }
+
+    return ret;
+}
+
+_Bool _z_executor_is_running(_z_executor_t *ex) {
+    _z_mutex_lock(&ex->_mutex);
+    _Bool ret = ex->_is_running;
+    _z_mutex_unlock(&ex->_mutex);
+
+    return ret;
+}
+
+int8_t _z_executor_push(_z_executor_t *ex, _z_executor_strand_t *strand, _z_executor_job_t *job) {
+    int8_t ret = _Z_RES_OK;
+
+    job->_next = NULL;
+
+    _z_mutex_lock(&ex->_mutex);
+    if (ex->_is_running == true) {
+        if (strand->_tail != NULL) {
+            strand->_tail->_next = job;
+        } else {
+            strand->_head = job;
+        }
+        strand->_tail = job;
+        strand->_depth = strand->_depth + (size_t)1;
+
+        ex->_queued = ex->_queued + (size_t)1;
+        if (ex->_queued > ex->_high_water_mark) {
+            ex->_high_water_mark = ex->_queued;
+        }
+
+        // Otherwise, the job will be run after the ones of the strand that are already queued
+        if (strand->_is_scheduled == false) {
+            __z_executor_schedule(ex, strand);
+        }
+    } else {
+        ret = _Z_ERR_GENERIC;
+    }
+    _z_mutex_unlock(&ex->_mutex);
+
+    return ret;
+}
+
+size_t _z_executor_strand_depth(_z_executor_t *ex, const _z_executor_strand_t *strand) {
+    _z_mutex_lock(&ex->_mutex);
+    size_t ret = strand->_depth;
+    _z_mutex_unlock(&ex->_mutex);
+
+    return ret;
+}
+
+void _z_executor_stats(_z_executor_t *ex, size_t *queued, size_t *high_water_mark) {
+    _z_mutex_lock(&ex->_mutex);
+    *queued = ex->_queued;
+    *high_water_mark = ex->_high_water_mark;
+    _z_mutex_unlock(&ex->_mutex);
+}
+
+#endif  // Z_EXECUTOR == 1
@@ -16,6 +16,7 @@
 
 #include <stddef.h>
 
+#include "zenoh-pico/collections/intmap.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/net/memory.h"
 #include "zenoh-pico/protocol/keyexpr.h"
@@ -64,21 +65,8 @@ _Bool _z_pending_query_eq(const _z_pending_query_t *one, const _z_pending_query_
 /*------------------ Query ------------------*/
 _z_zint_t _z_get_query_id(_z_session_t *zn) { return zn->_query_id++; }
 
-_z_pending_query_t *__z_get_pending_query_by_id(_z_pending_query_list_t *pqls, const _z_zint_t id) {
-    _z_pending_query_t *ret = NULL;
-
-    _z_pending_query_list_t *xs = pqls;
-    while (xs != NULL) {
-        _z_pending_query_t *pql = _z_pending_query_list_head(xs);
-        if (pql->_id == id) {
-            ret = pql;
-            break;
-        }
-
-        xs = _z_pending_query_list_tail(xs);
-    }
-
-    return ret;
+_z_pending_query_t *__z_get_pending_query_by_id(const _z_int_void_map_t *ids, const _z_zint_t id) {
+    return (_z_pending_query_t *)_z_int_void_map_get(ids, (size_t)id);
 }
 
 /**
@@ -87,8 +75,7 @@ _z_pending_query_t *__z_get_pending_query_by_id(_z_pending_query_list_t *pqls, c
  *  - zn->_mutex_inner
  */
 _z_pending_query_t *__unsafe__z_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id) {
-    _z_pending_query_list_t *pqls = zn->_pending_queries;
-    return __z_get_pending_query_by_id(pqls, id);
+    return __z_get_pending_query_by_id(&zn->_pending_queries_by_id, id);
 }
 
 _z_pending_query_t *_z_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id) {
@@ -114,7 +101,8 @@ int8_t _z_register_pending_query(_z_session_t *zn, _z_pending_query_t *pen_qry)
 #endif  // Z_MULTI_THREAD == 1
 
     _z_pending_query_t *pql = __unsafe__z_get_pending_query_by_id(zn, pen_qry->_id);
-    if (pql == NULL) {  // Register query only if a pending one with the same ID does not exist
+    if ((pql == NULL) &&  // Register query only if a pending one with the same ID does not exist
+        (_z_int_void_map_insert(&zn->_pending_queries_by_id, (size_t)pen_qry->_id, pen_qry, _z_noop_free) != NULL)) {
         zn->_pending_queries = _z_pending_query_list_push(zn->_pending_queries, pen_qry);
     } else {
         ret = _Z_ERR_REGISTER_QUERY;
@@ -256,6 +244,7 @@ int8_t _z_trigger_query_reply_final(_z_session_t *zn, const _z_reply_context_t *
 
     if (ret == _Z_RES_OK) {
         // Dropping a pending query triggers the dropper callback that is now the equivalent to a reply with the FINAL
+        _z_int_void_map_remove(&zn->_pending_queries_by_id, (size_t)pen_qry->_id, _z_noop_free);
         zn->_pending_queries = _z_pending_query_list_drop_filter(zn->_pending_queries, _z_pending_query_eq, pen_qry);
     }
 
@@ -271,6 +260,7 @@ void _z_unregister_pending_query(_z_session_t *zn, _z_pending_query_t *pen_qry)
     _z_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
+    _z_int_void_map_remove(&zn->_pending_queries_by_id, (size_t)pen_qry->_id, _z_noop_free);
     zn->_pending_queries = _z_pending_query_list_drop_filter(zn->_pending_queries, _z_pending_query_eq, pen_qry);
 
 #if Z_MULTI_THREAD == 1
@@ -283,6 +273,7 @@ void _z_flush_pending_queries(_z_session_t *zn) {
     _z_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
+    _z_int_void_map_clear(&zn->_pending_queries_by_id, _z_noop_free);
     _z_pending_query_list_free(&zn->_pending_queries);
 
 #if Z_MULTI_THREAD == 1
@@ -14,6 +14,8 @@
 
 #include <stddef.h>
 
+#include "zenoh-pico/collections/intmap.h"
+#include "zenoh-pico/collections/string.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/net/resource.h"
 #include "zenoh-pico/protocol/keyexpr.h"
@@ -31,21 +33,8 @@ void _z_questionable_clear(_z_questionable_t *qle) {
 }
 
 /*------------------ Queryable ------------------*/
-_z_questionable_sptr_t *__z_get_questionable_by_id(_z_questionable_sptr_list_t *qles, const _z_zint_t id) {
-    _z_questionable_sptr_t *ret = NULL;
-
-    _z_questionable_sptr_list_t *xs = qles;
-    while (xs != NULL) {
-        _z_questionable_sptr_t *qle = _z_questionable_sptr_list_head(xs);
-        if (id == qle->ptr->_id) {
-            ret = qle;
-            break;
-        }
-
-        xs = _z_questionable_sptr_list_tail(xs);
-    }
-
-    return ret;
+_z_questionable_sptr_t *__z_get_questionable_by_id(const _z_int_void_map_t *ids, const _z_zint_t id) {
+    return (_z_questionable_sptr_t *)_z_int_void_map_get(ids, (size_t)id);
 }
 
 _z_questionable_sptr_list_t *__z_get_questionable_by_key(_z_questionable_sptr_list_t *qles, const _z_keyexpr_t key) {
@@ -71,8 +60,7 @@ _z_questionable_sptr_list_t *__z_get_questionable_by_key(_z_questionable_sptr_li
  *  - zn->_mutex_inner
  */
 _z_questionable_sptr_t *__unsafe_z_get_questionable_by_id(_z_session_t *zn, const _z_zint_t id) {
-    _z_questionable_sptr_list_t *qles = zn->_local_questionable;
-    return __z_get_questionable_by_id(qles, id);
+    return __z_get_questionable_by_id(&zn->_local_questionable_by_id, id);
 }
 
 /**
@@ -124,7 +112,13 @@ _z_questionable_sptr_t *_z_register_questionable(_z_session_t *zn, _z_questionab
 
     ret = (_z_questionable_sptr_t *)z_malloc(sizeof(_z_questionable_sptr_t));
     *ret = _z_questionable_sptr_new(*q);
-    zn->_local_questionable = _z_questionable_sptr_list_push(zn->_local_questionable, ret);
+    if (_z_int_void_map_insert(&zn->_local_questionable_by_id, (size_t)ret->ptr->_id, ret, _z_noop_free) != NULL) {
+        zn->_local_questionable = _z_questionable_sptr_list_push(zn->_local_questionable, ret);
+    } else {
+        _z_questionable_sptr_drop(ret);
+        z_free(ret);
+        ret = NULL;
+    }
 
 #if Z_MULTI_THREAD == 1
     _z_mutex_unlock(&zn->_mutex_inner);
@@ -133,6 +127,149 @@ _z_questionable_sptr_t *_z_register_questionable(_z_session_t *zn, _z_questionab
     return ret;
 }
 
+// Sends the final reply of a query, once all the matching queryables have replied
+static int8_t __z_send_final_reply(_z_session_t *zn, const _z_zint_t qid) {
+    int8_t ret = _Z_RES_OK;
+
+    // Final flagged reply context does not encode the ZID
+    _z_bytes_t zid;
+    _z_bytes_reset(&zid);
+    _Bool is_final = true;
+    _z_reply_context_t *rctx = _z_msg_make_reply_context(qid, zid, is_final);
+
+    // Congestion control
+    _Bool can_be_dropped = false;
+
+    // Create the final reply
+    _z_zenoh_message_t z_msg = _z_msg_make_unit(can_be_dropped);
+    z_msg._reply_context = rctx;
+
+    if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                      false) != _Z_RES_OK) {
+        ret = _Z_ERR_TRANSPORT_TX_FAILED;
+    }
+    _z_msg_clear(&z_msg);
+
+    return ret;
+}
+
+#if Z_EXECUTOR == 1
+// A copy of a query handed over to the executor, shared by the jobs of its queryables. The final reply is sent once
+// its last reference, held by the jobs and by the read task while it triggers the queryables, has been released.
+typedef struct {
+    z_query_t _query;
+    size_t _refs;  // Protected by the session mutex
+} __z_executed_query_t;
+
+static __z_executed_query_t *__z_executed_query_new(const z_query_t *q) {
+    __z_executed_query_t *eq = (__z_executed_query_t *)z_malloc(sizeof(__z_executed_query_t));
+    if (eq != NULL) {
+        eq->_query._zn = q->_zn;
+        eq->_query._qid = q->_qid;
+        eq->_query._key = _z_keyexpr_duplicate(&q->_key);
+        eq->_query._parameters = _z_str_clone(q->_parameters);
+        eq->_query._with_value.encoding.prefix = q->_with_value.encoding.prefix;
+        eq->_query._with_value.encoding.suffix = _z_bytes_duplicate(&q->_with_value.encoding.suffix);
+        eq->_query._with_value.payload = _z_bytes_duplicate(&q->_with_value.payload);
+        eq->_query._anyke = q->_anyke;
+        eq->_refs = 1;  // Held by the read task
+    }
+
+    return eq;
+}
+
+static void __z_executed_query_acquire(_z_session_t *zn, __z_executed_query_t *eq) {
+    _z_mutex_lock(&zn->_mutex_inner);
+    eq->_refs = eq->_refs + (size_t)1;
+    _z_mutex_unlock(&zn->_mutex_inner);
+}
+
+// Returns the result of sending the final reply if this was the last reference, _Z_RES_OK otherwise
+static int8_t __z_executed_query_release(_z_session_t *zn, __z_executed_query_t *eq) {
+    int8_t ret = _Z_RES_OK;
+
+    _z_mutex_lock(&zn->_mutex_inner);
+    eq->_refs = eq->_refs - (size_t)1;
+    _Bool is_last = eq->_refs == (size_t)0;
+    _z_mutex_unlock(&zn->_mutex_inner);
+
+    if (is_last == true) {
+        ret = __z_send_final_reply(zn, eq->_query._qid);
+        _z_keyexpr_clear(&eq->_query._key);
+        z_free(eq->_query._parameters);
+        _z_bytes_clear(&eq->_query._with_value.encoding.suffix);
+        _z_bytes_clear(&eq->_query._with_value.payload);
+        z_free(eq);
+    }
+
+    return ret;
+}
+
+// A query handed over to the executor, along with a reference to the queryable
+typedef struct {
+    _z_executor_job_t _job;  // Must be the first member
+    _z_questionable_sptr_t _qle;
+    __z_executed_query_t *_query;
+} __z_questionable_job_t;
+
+static void __z_questionable_job_run(_z_executor_job_t *job) {
+    __z_questionable_job_t *qjob = (__z_questionable_job_t *)job;
+    qjob->_qle.ptr->_callback(&qjob->_query->_query, qjob->_qle.ptr->_arg);
+}
+
+static void __z_questionable_job_free(_z_executor_job_t *job) {
+    __z_questionable_job_t *qjob = (__z_questionable_job_t *)job;
+    (void)__z_executed_query_release((_z_session_t *)qjob->_query->_query._zn, qjob->_query);
+    _z_questionable_sptr_drop(&qjob->_qle);
+    z_free(qjob);
+}
+
+// Hands the query over to the executor, copying it on the first call since it only lives until the callbacks return
+static int8_t __z_questionable_execute(_z_session_t *zn, _z_questionable_sptr_t *qle, const z_query_t *q,
+                                       __z_executed_query_t **eq) {
+    int8_t ret = _Z_RES_OK;
+
+    __z_questionable_job_t *qjob = NULL;
+    if (_z_executor_is_running(&zn->_executor) == true) {
+        if (*eq == NULL) {
+            *eq = __z_executed_query_new(q);
+        }
+        if (*eq != NULL) {
+            qjob = (__z_questionable_job_t *)z_malloc(sizeof(__z_questionable_job_t));
+        }
+    }
+    if (qjob != NULL) {
+        qjob->_job._run = __z_questionable_job_run;
+        qjob->_job._free = __z_questionable_job_free;
+        qjob->_qle = _z_questionable_sptr_clone(qle);
+        qjob->_query = *eq;
+        __z_executed_query_acquire(zn, *eq);
+
+        ret = _z_executor_push(&zn->_executor, &qle->ptr->_strand, &qjob->_job);
+        if (ret != _Z_RES_OK) {
+            __z_questionable_job_free(&qjob->_job);  // Stopped in the meantime, the read task still holds the query
+        }
+    } else {
+        ret = _Z_ERR_GENERIC;
+    }
+
+    return ret;
+}
+
+size_t _z_questionable_queue_depth(_z_session_t *zn, const _z_zint_t id) {
+    size_t ret = 0;
+
+    _z_mutex_lock(&zn->_mutex_inner);
+    _z_questionable_sptr_t *qle = __unsafe_z_get_questionable_by_id(zn, id);
+    if ((qle != NULL) && (qle->ptr->_is_executed == true)) {
+        ret = _z_executor_strand_depth(&zn->_executor, &qle->ptr->_strand);
+    }
+    _z_mutex_unlock(&zn->_mutex_inner);
+
+    return ret;
+}
+#endif  // Z_EXECUTOR == 1
+
 int8_t _z_trigger_queryables(_z_session_t *zn, const _z_msg_query_t *query) {
     int8_t ret = _Z_RES_OK;
 
@@ -140,7 +277,11 @@ int8_t _z_trigger_queryables(_z_session_t *zn, const _z_msg_query_t *query) {
     _z_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
-    _z_keyexpr_t key = __unsafe_z_get_expanded_key_from_key(zn, _Z_RESOURCE_IS_REMOTE, &query->_key);
+    _z_keyexpr_t key = query->_key;  // Borrowed from the message if it has no resource ID
+    _Bool is_borrowed = (query->_key._id == Z_RESOURCE_ID_NONE) && (query->_key._suffix != NULL);
+    if (is_borrowed == false) {
+        key = __unsafe_z_get_expanded_key_from_key(zn, _Z_RESOURCE_IS_REMOTE, &query->_key);
+    }
     if (key._suffix != NULL) {
         _z_questionable_sptr_list_t *qles = __unsafe_z_get_questionable_by_key(zn, key);
 
@@ -157,34 +298,36 @@ int8_t _z_trigger_queryables(_z_session_t *zn, const _z_msg_query_t *query) {
         q._with_value.encoding = query->_info._encoding;
         q._with_value.payload = query->_payload;
         q._anyke = (strstr(q._parameters, Z_SELECTOR_QUERY_MATCH) == NULL) ? false : true;
+#if Z_EXECUTOR == 1
+        __z_executed_query_t *eq = NULL;  // Only copied if handed over to the executor
+#endif  // Z_EXECUTOR == 1
         _z_questionable_sptr_list_t *xs = qles;
         while (xs != NULL) {
             _z_questionable_sptr_t *qle = _z_questionable_sptr_list_head(xs);
-            qle->ptr->_callback(&q, qle->ptr->_arg);
+#if Z_EXECUTOR == 1
+            // Run inline if the executor is not running
+            if ((qle->ptr->_is_executed == false) || (__z_questionable_execute(zn, qle, &q, &eq) != _Z_RES_OK))
+#endif  // Z_EXECUTOR == 1
+            {
+                qle->ptr->_callback(&q, qle->ptr->_arg);
+            }
             xs = _z_questionable_sptr_list_tail(xs);
         }
 
-        _z_keyexpr_clear(&key);
+        if (is_borrowed == false) {
+            _z_keyexpr_clear(&key);
+        }
         _z_questionable_sptr_list_free(&qles);
 
-        // Send the final reply
-        // Final flagged reply context does not encode the ZID
-        _z_bytes_t zid;
-        _z_bytes_reset(&zid);
-        _Bool is_final = true;
-        _z_reply_context_t *rctx = _z_msg_make_reply_context(query->_qid, zid, is_final);
-
-        // Congestion control
-        _Bool can_be_dropped = false;
-
-        // Create the final reply
-        _z_zenoh_message_t z_msg = _z_msg_make_unit(can_be_dropped);
-        z_msg._reply_context = rctx;
-
-        if (_z_send_z_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) != _Z_RES_OK) {
-            ret = _Z_ERR_TRANSPORT_TX_FAILED;
+#if Z_EXECUTOR == 1
+        if (eq != NULL) {
+            // The final reply is sent along with the release of the last reference to the query
+            ret = __z_executed_query_release(zn, eq);
+        } else
+#endif  // Z_EXECUTOR == 1
+        {
+            ret = __z_send_final_reply(zn, query->_qid);
         }
-        _z_msg_clear(&z_msg);
     } else {
 #if Z_MULTI_THREAD == 1
         _z_mutex_unlock(&zn->_mutex_inner);
@@ -201,6 +344,7 @@ void _z_unregister_questionable(_z_session_t *zn, _z_questionable_sptr_t *qle) {
     _z_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
+    _z_int_void_map_remove(&zn->_local_questionable_by_id, (size_t)qle->ptr->_id, _z_noop_free);
     zn->_local_questionable =
         _z_questionable_sptr_list_drop_filter(zn->_local_questionable, _z_questionable_sptr_eq, qle);
 
@@ -214,6 +358,7 @@ void _z_flush_questionables(_z_session_t *zn) {
     _z_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
+    _z_int_void_map_clear(&zn->_local_questionable_by_id, _z_noop_free);
     _z_questionable_sptr_list_free(&zn->_local_questionable);
 
 #if Z_MULTI_THREAD == 1
@@ -15,13 +15,18 @@
 #include "zenoh-pico/session/resource.h"
 
 #include <stddef.h>
+#include <string.h>
 
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/session/subscription.h"
 #include "zenoh-pico/utils/logging.h"
 
 _Bool _z_resource_eq(const _z_resource_t *other, const _z_resource_t *this) { return this->_id == other->_id; }
 
-void _z_resource_clear(_z_resource_t *res) { _z_keyexpr_clear(&res->_key); }
+void _z_resource_clear(_z_resource_t *res) {
+    _z_keyexpr_clear(&res->_key);
+    _z_string_clear(&res->_expanded);
+}
 
 void _z_resource_free(_z_resource_t **res) {
     _z_resource_t *ptr = *res;
@@ -36,95 +41,52 @@ _z_zint_t _z_get_entity_id(_z_session_t *zn) { return zn->_entity_id++; }
 _z_zint_t _z_get_resource_id(_z_session_t *zn) { return zn->_resource_id++; }
 
 /*------------------ Resource ------------------*/
-_z_resource_t *__z_get_resource_by_id(_z_resource_list_t *rl, const _z_zint_t id) {
-    _z_resource_t *ret = NULL;
-
-    _z_resource_list_t *xs = rl;
-    while (xs != NULL) {
-        _z_resource_t *r = _z_resource_list_head(xs);
-        if (r->_id == id) {
-            ret = r;
-            break;
-        }
-
-        xs = _z_resource_list_tail(xs);
-    }
-
-    return ret;
+_z_resource_t *__z_get_resource_by_id(const _z_int_void_map_t *ids, const _z_zint_t id) {
+    return (_z_resource_t *)_z_int_void_map_get(ids, (size_t)id);
 }
 
-_z_resource_t *__z_get_resource_by_key(_z_resource_list_t *rl, const _z_keyexpr_t *keyexpr) {
-    _z_resource_t *ret = NULL;
-
-    _z_resource_list_t *xs = rl;
-    while (xs != NULL) {
-        _z_resource_t *r = _z_resource_list_head(xs);
-        if ((r->_key._id == keyexpr->_id) && (_z_str_eq(r->_key._suffix, keyexpr->_suffix) == true)) {
-            ret = r;
-            break;
-        }
+static _Bool __z_resource_key_id_eq(const void *value, const void *arg) {
+    return ((const _z_resource_t *)value)->_key._id == ((const _z_keyexpr_t *)arg)->_id;
+}
 
-        xs = _z_resource_list_tail(xs);
-    }
+static _Bool __z_resource_id_eq(const void *value, const void *arg) {
+    return ((const _z_resource_t *)value)->_id == ((const _z_resource_t *)arg)->_id;
+}
 
-    return ret;
+_z_resource_t *__z_get_resource_by_key(const _z_keyexpr_tree_t *keys, const _z_keyexpr_t *keyexpr) {
+    const char *suffix = (keyexpr->_suffix != NULL) ? keyexpr->_suffix : "";
+    return (_z_resource_t *)_z_keyexpr_tree_get(keys, suffix, strlen(suffix), __z_resource_key_id_eq, keyexpr);
 }
 
-_z_keyexpr_t __z_get_expanded_key_from_key(_z_resource_list_t *xs, const _z_keyexpr_t *keyexpr) {
+_z_keyexpr_t __z_get_expanded_key_from_key(const _z_int_void_map_t *ids, const _z_keyexpr_t *keyexpr) {
     _z_keyexpr_t ret = {._id = Z_RESOURCE_ID_NONE, ._suffix = NULL};
 
-    // Need to build the complete resource name, by recursively look at RIDs
-    // Resource names are looked up from right to left
-    _z_str_list_t *strs = NULL;
-    size_t len = 1;  // Start with space for the null-terminator
-
-    // Append suffix as the right-most segment
-    if (keyexpr->_suffix != NULL) {
-        len = len + strlen(keyexpr->_suffix);
-        strs = _z_str_list_push(strs, (char *)keyexpr->_suffix);  // Warning: list must be release with
-                                                                  //   _z_list_free(&strs, _z_noop_free);
-                                                                  //   or will release the suffix as well
-    }
-
-    // Recursevely go through all the RIDs
-    _z_zint_t id = keyexpr->_id;
-    while (id != Z_RESOURCE_ID_NONE) {
-        _z_resource_t *res = __z_get_resource_by_id(xs, id);
-        if (res == NULL) {
-            len = 0;
-            break;
-        }
-
-        if (res->_key._suffix != NULL) {
-            len = len + strlen(res->_key._suffix);
-            strs = _z_str_list_push(strs, (char *)res->_key._suffix);  // Warning: list must be release with
-                                                                       //   _z_list_free(&strs, _z_noop_free);
-                                                                       //   or will release the suffix as well
+    // The resource of the ID already holds the expansion of its own chain of resource IDs
+    const char *prefix = NULL;
+    size_t prefix_len = 0;
+    if (keyexpr->_id != Z_RESOURCE_ID_NONE) {
+        _z_resource_t *res = __z_get_resource_by_id(ids, keyexpr->_id);
+        if (res != NULL) {
+            prefix = res->_expanded.val;
+            prefix_len = res->_expanded.len;
         }
-        id = res->_key._id;
+    } else {
+        prefix = "";
     }
 
-    if (len != (size_t)0) {
-        char *rname = NULL;
-        rname = (char *)z_malloc(len);
-        rname[0] = '\0';  // NULL terminator must be set (required to strcat)
-        len = len - (size_t)1;
-
-        // Concatenate all the partial resource names
-        _z_str_list_t *xstr = strs;
-        while (xstr != NULL) {
-            char *s = _z_str_list_head(xstr);
-            if (len > (size_t)0) {
-                (void)strncat(rname, s, len);
-                len = len - strlen(s);
+    if (prefix != NULL) {
+        size_t suffix_len = (keyexpr->_suffix != NULL) ? strlen(keyexpr->_suffix) : (size_t)0;
+        char *rname = (char *)z_malloc(prefix_len + suffix_len + (size_t)1);
+        if (rname != NULL) {
+            (void)memcpy(rname, prefix, prefix_len);
+            if (suffix_len > (size_t)0) {
+                (void)memcpy(&rname[prefix_len], keyexpr->_suffix, suffix_len);
             }
-            xstr = _z_str_list_tail(xstr);
+            rname[prefix_len + suffix_len] = '\0';
+            ret._suffix = rname;
         }
-        ret._suffix = rname;
     }
 
-    _z_list_free(&strs, _z_noop_free);
-
     return ret;
 }
 
@@ -134,8 +96,9 @@ _z_keyexpr_t __z_get_expanded_key_from_key(_z_resource_list_t *xs, const _z_keye
  *  - zn->_mutex_inner
  */
 _z_resource_t *__unsafe_z_get_resource_by_id(_z_session_t *zn, uint8_t is_local, _z_zint_t id) {
-    _z_resource_list_t *decls = (is_local == _Z_RESOURCE_IS_LOCAL) ? zn->_local_resources : zn->_remote_resources;
-    return __z_get_resource_by_id(decls, id);
+    _z_int_void_map_t *ids =
+        (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_resources_by_id : &zn->_remote_resources_by_id;
+    return __z_get_resource_by_id(ids, id);
 }
 
 /**
@@ -144,8 +107,9 @@ _z_resource_t *__unsafe_z_get_resource_by_id(_z_session_t *zn, uint8_t is_local,
  *  - zn->_mutex_inner
  */
 _z_resource_t *__unsafe_z_get_resource_by_key(_z_session_t *zn, uint8_t is_local, const _z_keyexpr_t *keyexpr) {
-    _z_resource_list_t *decls = (is_local == _Z_RESOURCE_IS_LOCAL) ? zn->_local_resources : zn->_remote_resources;
-    return __z_get_resource_by_key(decls, keyexpr);
+    _z_keyexpr_tree_t *keys =
+        (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_resources_by_key : &zn->_remote_resources_by_key;
+    return __z_get_resource_by_key(keys, keyexpr);
 }
 
 /**
@@ -154,8 +118,9 @@ _z_resource_t *__unsafe_z_get_resource_by_key(_z_session_t *zn, uint8_t is_local
  *  - zn->_mutex_inner
  */
 _z_keyexpr_t __unsafe_z_get_expanded_key_from_key(_z_session_t *zn, uint8_t is_local, const _z_keyexpr_t *keyexpr) {
-    _z_resource_list_t *decls = (is_local == _Z_RESOURCE_IS_LOCAL) ? zn->_local_resources : zn->_remote_resources;
-    return __z_get_expanded_key_from_key(decls, keyexpr);
+    _z_int_void_map_t *ids =
+        (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_resources_by_id : &zn->_remote_resources_by_id;
+    return __z_get_expanded_key_from_key(ids, keyexpr);
 }
 
 _z_resource_t *_z_get_resource_by_id(_z_session_t *zn, uint8_t is_local, _z_zint_t rid) {
@@ -209,15 +174,32 @@ int8_t _z_register_resource(_z_session_t *zn, uint8_t is_local, _z_resource_t *r
     _z_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
+    // Resolved once, so that the keys referring to this resource are then expanded with a single lookup
+    _z_keyexpr_t expanded = __unsafe_z_get_expanded_key_from_key(zn, is_local, &res->_key);
+    res->_expanded.val = (char *)expanded._suffix;
+    res->_expanded.len = (expanded._suffix != NULL) ? strlen(expanded._suffix) : (size_t)0;
+
     // FIXME: check by keyexpr instead
     _z_resource_t *r = __unsafe_z_get_resource_by_id(zn, is_local, res->_id);
     if (r == NULL) {
-        // Register the resource
-        if (is_local == _Z_RESOURCE_IS_LOCAL) {
+        _z_int_void_map_t *ids =
+            (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_resources_by_id : &zn->_remote_resources_by_id;
+        _z_keyexpr_tree_t *keys =
+            (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_resources_by_key : &zn->_remote_resources_by_key;
+        const char *suffix = (res->_key._suffix != NULL) ? res->_key._suffix : "";
+
+        // Index the resource before registering it, so that the caller keeps its ownership on failure
+        if (_z_int_void_map_insert(ids, (size_t)res->_id, res, _z_noop_free) == NULL) {
+            ret = _Z_ERR_DECLARE_KEYEXPR;
+        } else if (_z_keyexpr_tree_insert(keys, suffix, strlen(suffix), res) != _Z_RES_OK) {
+            _z_int_void_map_remove(ids, (size_t)res->_id, _z_noop_free);
+            ret = _Z_ERR_DECLARE_KEYEXPR;
+        } else if (is_local == _Z_RESOURCE_IS_LOCAL) {
             zn->_local_resources = _z_resource_list_push(zn->_local_resources, res);
         } else {
             zn->_remote_resources = _z_resource_list_push(zn->_remote_resources, res);
         }
+        __unsafe_z_invalidate_subscription_cache(zn);
     } else {
         ret = _Z_ERR_DECLARE_KEYEXPR;
     }
@@ -234,11 +216,22 @@ void _z_unregister_resource(_z_session_t *zn, uint8_t is_local, _z_resource_t *r
     _z_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
+    _z_int_void_map_t *ids =
+        (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_resources_by_id : &zn->_remote_resources_by_id;
+    _z_resource_t *r = __z_get_resource_by_id(ids, res->_id);
+    if (r != NULL) {
+        _z_keyexpr_tree_t *keys =
+            (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_resources_by_key : &zn->_remote_resources_by_key;
+        const char *suffix = (r->_key._suffix != NULL) ? r->_key._suffix : "";
+        _z_keyexpr_tree_remove(keys, suffix, strlen(suffix), __z_resource_id_eq, r);
+        _z_int_void_map_remove(ids, (size_t)r->_id, _z_noop_free);
+    }
     if (is_local == _Z_RESOURCE_IS_LOCAL) {
         zn->_local_resources = _z_resource_list_drop_filter(zn->_local_resources, _z_resource_eq, res);
     } else {
         zn->_remote_resources = _z_resource_list_drop_filter(zn->_remote_resources, _z_resource_eq, res);
     }
+    __unsafe_z_invalidate_subscription_cache(zn);
 
 #if Z_MULTI_THREAD == 1
     _z_mutex_unlock(&zn->_mutex_inner);
@@ -250,8 +243,13 @@ void _z_flush_resources(_z_session_t *zn) {
     _z_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
+    _z_int_void_map_clear(&zn->_local_resources_by_id, _z_noop_free);
+    _z_int_void_map_clear(&zn->_remote_resources_by_id, _z_noop_free);
+    _z_keyexpr_tree_clear(&zn->_local_resources_by_key);
+    _z_keyexpr_tree_clear(&zn->_remote_resources_by_key);
     _z_resource_list_free(&zn->_local_resources);
     _z_resource_list_free(&zn->_remote_resources);
+    __unsafe_z_invalidate_subscription_cache(zn);
 
 #if Z_MULTI_THREAD == 1
     _z_mutex_unlock(&zn->_mutex_inner);
@@ -83,6 +83,10 @@ int8_t _z_handle_zenoh_message(_z_session_t *zn, _z_zenoh_message_t *msg) {
                         s._callback = NULL;
                         s._dropper = NULL;
                         s._arg = NULL;
+#if Z_EXECUTOR == 1
+                        s._is_executed = false;
+                        _z_executor_strand_init(&s._strand);
+#endif  // Z_EXECUTOR == 1
 
                         _z_subscription_sptr_t *sp_s = _z_register_subscription(
                             zn, _Z_RESOURCE_IS_REMOTE, &s);  // This a pointer to the entry stored at session-level.
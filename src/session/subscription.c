@@ -16,10 +16,14 @@
 
 #include <stddef.h>
 
+#include "zenoh-pico/collections/intmap.h"
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/net/memory.h"
 #include "zenoh-pico/net/resource.h"
 #include "zenoh-pico/protocol/keyexpr.h"
+#include "zenoh-pico/protocol/keyexpr_tree.h"
 #include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/system/platform.h"
 #include "zenoh-pico/utils/logging.h"
 
 _Bool _z_subscription_eq(const _z_subscription_t *other, const _z_subscription_t *this) {
@@ -33,24 +37,18 @@ void _z_subscription_clear(_z_subscription_t *sub) {
     _z_keyexpr_clear(&sub->_key);
 }
 
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0 || Z_SUBSCRIPTION_SNAPSHOTS == 1
+void _z_subscription_match_clear(_z_subscription_match_t *match) {
+    _z_keyexpr_clear(&match->_key);
+    _z_subscription_sptr_list_free(&match->_subs);
+}
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0 || Z_SUBSCRIPTION_SNAPSHOTS == 1
+
 /*------------------ Pull ------------------*/
 _z_zint_t _z_get_pull_id(_z_session_t *zn) { return zn->_pull_id++; }
 
-_z_subscription_sptr_t *__z_get_subscription_by_id(_z_subscription_sptr_list_t *subs, const _z_zint_t id) {
-    _z_subscription_sptr_t *ret = NULL;
-
-    _z_subscription_sptr_list_t *xs = subs;
-    while (xs != NULL) {
-        _z_subscription_sptr_t *sub = _z_subscription_sptr_list_head(xs);
-        if (id == sub->ptr->_id) {
-            ret = sub;
-            break;
-        }
-
-        xs = _z_subscription_sptr_list_tail(xs);
-    }
-
-    return ret;
+_z_subscription_sptr_t *__z_get_subscription_by_id(const _z_int_void_map_t *ids, const _z_zint_t id) {
+    return (_z_subscription_sptr_t *)_z_int_void_map_get(ids, (size_t)id);
 }
 
 _z_subscription_sptr_list_t *__z_get_subscriptions_by_key(_z_subscription_sptr_list_t *subs, const _z_keyexpr_t key) {
@@ -76,9 +74,18 @@ _z_subscription_sptr_list_t *__z_get_subscriptions_by_key(_z_subscription_sptr_l
  *  - zn->_mutex_inner
  */
 _z_subscription_sptr_t *__unsafe_z_get_subscription_by_id(_z_session_t *zn, uint8_t is_local, const _z_zint_t id) {
-    _z_subscription_sptr_list_t *subs =
-        (is_local == _Z_RESOURCE_IS_LOCAL) ? zn->_local_subscriptions : zn->_remote_subscriptions;
-    return __z_get_subscription_by_id(subs, id);
+    _z_int_void_map_t *ids =
+        (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_subscriptions_by_id : &zn->_remote_subscriptions_by_id;
+    return __z_get_subscription_by_id(ids, id);
+}
+
+static void __z_subscriptions_tree_collect(void *value, void *arg) {
+    _z_subscription_sptr_list_t **subs = (_z_subscription_sptr_list_t **)arg;
+    *subs = _z_subscription_sptr_list_push(*subs, _z_subscription_sptr_clone_as_ptr((_z_subscription_sptr_t *)value));
+}
+
+static _Bool __z_subscriptions_tree_eq(const void *value, const void *arg) {
+    return ((const _z_subscription_sptr_t *)value)->ptr == ((const _z_subscription_sptr_t *)arg)->ptr;
 }
 
 /**
@@ -88,9 +95,21 @@ _z_subscription_sptr_t *__unsafe_z_get_subscription_by_id(_z_session_t *zn, uint
  */
 _z_subscription_sptr_list_t *__unsafe_z_get_subscriptions_by_key(_z_session_t *zn, uint8_t is_local,
                                                                  const _z_keyexpr_t key) {
-    _z_subscription_sptr_list_t *subs =
-        (is_local == _Z_RESOURCE_IS_LOCAL) ? zn->_local_subscriptions : zn->_remote_subscriptions;
-    return __z_get_subscriptions_by_key(subs, key);
+    _z_subscription_sptr_list_t *ret = NULL;
+
+    size_t len = strlen(key._suffix);
+    if (_z_keyexpr_tree_is_literal(key._suffix, len) == true) {
+        _z_keyexpr_tree_t *tree =
+            (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_subscriptions_tree : &zn->_remote_subscriptions_tree;
+        _z_keyexpr_tree_intersecting(tree, key._suffix, len, __z_subscriptions_tree_collect, &ret);
+    } else {
+        // The tree only walks the branches matching literal chunks, wildcard keys are matched against every entry
+        _z_subscription_sptr_list_t *subs =
+            (is_local == _Z_RESOURCE_IS_LOCAL) ? zn->_local_subscriptions : zn->_remote_subscriptions;
+        ret = __z_get_subscriptions_by_key(subs, key);
+    }
+
+    return ret;
 }
 
 _z_subscription_sptr_t *_z_get_subscription_by_id(_z_session_t *zn, uint8_t is_local, const _z_zint_t id) {
@@ -133,11 +152,33 @@ _z_subscription_sptr_t *_z_register_subscription(_z_session_t *zn, uint8_t is_lo
     if (subs == NULL) {  // A subscription for this name does not yet exists
         ret = (_z_subscription_sptr_t *)z_malloc(sizeof(_z_subscription_sptr_t));
         *ret = _z_subscription_sptr_new(*s);
-        if (is_local == _Z_RESOURCE_IS_LOCAL) {
+        _z_keyexpr_tree_t *tree =
+            (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_subscriptions_tree : &zn->_remote_subscriptions_tree;
+        _z_int_void_map_t *ids =
+            (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_subscriptions_by_id : &zn->_remote_subscriptions_by_id;
+
+        // A subscription missing from the indexes could not be found, so it is not registered at all
+        _Bool is_indexed = false;
+        if (_z_keyexpr_tree_insert(tree, ret->ptr->_key._suffix, strlen(ret->ptr->_key._suffix), ret) == _Z_RES_OK) {
+            is_indexed = (_z_int_void_map_insert(ids, (size_t)ret->ptr->_id, ret, _z_noop_free) != NULL);
+            if (is_indexed == false) {
+                _z_keyexpr_tree_remove(tree, ret->ptr->_key._suffix, strlen(ret->ptr->_key._suffix),
+                                       __z_subscriptions_tree_eq, ret);
+            }
+        }
+
+        if (is_indexed == false) {
+            _z_subscription_sptr_drop(ret);
+            z_free(ret);
+            ret = NULL;
+        } else if (is_local == _Z_RESOURCE_IS_LOCAL) {
             zn->_local_subscriptions = _z_subscription_sptr_list_push(zn->_local_subscriptions, ret);
         } else {
             zn->_remote_subscriptions = _z_subscription_sptr_list_push(zn->_remote_subscriptions, ret);
         }
+        if (ret != NULL) {
+            __unsafe_z_invalidate_subscription_cache(zn);
+        }
     }
 
 #if Z_MULTI_THREAD == 1
@@ -147,22 +188,421 @@ _z_subscription_sptr_t *_z_register_subscription(_z_session_t *zn, uint8_t is_lo
     return ret;
 }
 
+/*------------------ Snapshot ------------------*/
+#if Z_SUBSCRIPTION_SNAPSHOTS == 1
+static void __z_subscription_match_elem_free(void **elem) {
+    _z_subscription_match_t *match = (_z_subscription_match_t *)*elem;
+    if (match != NULL) {
+        _z_subscription_match_clear(match);
+        z_free(match);
+        *elem = NULL;
+    }
+}
+
+void _z_subscription_snapshot_clear(_z_subscription_snapshot_t *snap) {
+    _z_int_void_map_clear(&snap->_matches, __z_subscription_match_elem_free);
+    _z_keyexpr_tree_clear(&snap->_subs_tree);
+    _z_subscription_sptr_list_free(&snap->_subs);
+}
+
+static void __z_subscription_snapshot_collect(void *value, void *arg) {
+    _z_subscription_sptr_list_t **subs = (_z_subscription_sptr_list_t **)arg;
+    _z_subscription_sptr_t *sub = (_z_subscription_sptr_t *)value;
+
+    // The read-only lookup visits the subscriptions reached through several ``**`` chunks several times
+    _Bool is_collected = false;
+    _z_subscription_sptr_list_t *xs = *subs;
+    while ((xs != NULL) && (is_collected == false)) {
+        is_collected = (_z_subscription_sptr_list_head(xs)->ptr == sub->ptr);
+        xs = _z_subscription_sptr_list_tail(xs);
+    }
+    if (is_collected == false) {
+        *subs = _z_subscription_sptr_list_push(*subs, _z_subscription_sptr_clone_as_ptr(sub));
+    }
+}
+
+// Can be called concurrently on a published snapshot
+static _z_subscription_sptr_list_t *__z_subscription_snapshot_get_by_key(const _z_subscription_snapshot_t *snap,
+                                                                         const _z_keyexpr_t key) {
+    _z_subscription_sptr_list_t *ret = NULL;
+
+    size_t len = strlen(key._suffix);
+    if (_z_keyexpr_tree_is_literal(key._suffix, len) == true) {
+        _z_keyexpr_tree_intersecting_readonly(&snap->_subs_tree, key._suffix, len, __z_subscription_snapshot_collect,
+                                              &ret);
+    } else {
+        ret = __z_get_subscriptions_by_key(snap->_subs, key);
+    }
+
+    return ret;
+}
+
+/**
+ * Copies the local subscriptions and the matches of the remote resources, or returns NULL if they cannot be copied.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static _z_subscription_snapshot_sptr_t *__unsafe_z_subscription_snapshot_make(_z_session_t *zn) {
+    _z_subscription_snapshot_sptr_t *ret = NULL;
+
+    _z_subscription_snapshot_t snap;
+    snap._subs = NULL;
+    snap._subs_tree = _z_keyexpr_tree_make();
+    snap._matches = _z_int_void_map_make(_Z_DEFAULT_INT_MAP_CAPACITY);
+    snap._busy_readers = (uint8_t)0;
+
+    _Bool is_complete = true;
+    _z_subscription_sptr_list_t *xs = zn->_local_subscriptions;
+    while ((xs != NULL) && (is_complete == true)) {
+        _z_subscription_sptr_t *sub = _z_subscription_sptr_clone_as_ptr(_z_subscription_sptr_list_head(xs));
+        snap._subs = _z_subscription_sptr_list_push(snap._subs, sub);
+        is_complete =
+            (_z_keyexpr_tree_insert(&snap._subs_tree, sub->ptr->_key._suffix, strlen(sub->ptr->_key._suffix), sub) ==
+             _Z_RES_OK);
+        xs = _z_subscription_sptr_list_tail(xs);
+    }
+
+    _z_resource_list_t *rs = zn->_remote_resources;
+    while ((rs != NULL) && (is_complete == true)) {
+        _z_resource_t *res = _z_resource_list_head(rs);
+        _z_subscription_match_t *match = (_z_subscription_match_t *)z_malloc(sizeof(_z_subscription_match_t));
+        if (match != NULL) {
+            match->_key = _z_rname(_z_str_clone(res->_expanded.val));
+            match->_subs = __z_subscription_snapshot_get_by_key(&snap, match->_key);
+            if (_z_int_void_map_insert(&snap._matches, (size_t)res->_id, match, _z_noop_free) == NULL) {
+                _z_subscription_match_clear(match);
+                z_free(match);
+                is_complete = false;
+            }
+        } else {
+            is_complete = false;
+        }
+        rs = _z_resource_list_tail(rs);
+    }
+
+    if (is_complete == true) {
+        ret = (_z_subscription_snapshot_sptr_t *)z_malloc(sizeof(_z_subscription_snapshot_sptr_t));
+    }
+    if (ret != NULL) {
+        *ret = _z_subscription_snapshot_sptr_new(snap);
+    } else {
+        _z_subscription_snapshot_clear(&snap);
+    }
+
+    return ret;
+}
+
+/**
+ * Releases the retired snapshots once both reader counts have been seen at zero since their retirement, so that the
+ * readers that may have loaded them without having taken their reference yet are done. A reader of the previous epoch
+ * may have loaded the snapshot published in its place as well, which is why the current count is waited for too.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static void __unsafe_z_subscription_snapshot_release_retired(_z_session_t *zn) {
+    uint8_t idle_readers = 0;
+    for (size_t i = 0; i < (size_t)2; i++) {
+        if (atomic_load(&zn->_subscription_snapshot_readers[i]) == (size_t)0) {
+            idle_readers = idle_readers | (uint8_t)(1U << i);
+        }
+    }
+
+    _z_list_t *retired = NULL;
+    _z_list_t *xs = atomic_load(&zn->_subscription_snapshot_retired);
+    while (xs != NULL) {
+        _z_subscription_snapshot_sptr_t *snap = (_z_subscription_snapshot_sptr_t *)_z_list_head(xs);
+        snap->ptr->_busy_readers = snap->ptr->_busy_readers & (uint8_t)~idle_readers;
+        if (snap->ptr->_busy_readers == (uint8_t)0) {
+            (void)_z_subscription_snapshot_sptr_drop(snap);
+            z_free(snap);
+        } else {
+            retired = _z_list_push(retired, snap);
+        }
+        xs = _z_list_pop(xs, _z_noop_free);
+    }
+    atomic_store(&zn->_subscription_snapshot_retired, retired);
+}
+
+/**
+ * Replaces the snapshot read by the dispatch of the samples, which falls back on the session tables if it is NULL.
+ *
+ * The replaced snapshot is retired and released by whoever sees the readers done last: either this function or the
+ * last of them. It never waits for the readers, and the readers of the new epoch load the new snapshot.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static void __unsafe_z_subscription_snapshot_publish(_z_session_t *zn, _z_subscription_snapshot_sptr_t *snap) {
+    _z_subscription_snapshot_sptr_t *old = atomic_exchange(&zn->_subscription_snapshot, snap);
+    if (old != NULL) {
+        (void)atomic_fetch_xor(&zn->_subscription_snapshot_epoch, (size_t)1);
+        old->ptr->_busy_readers = (uint8_t)0x03;
+        atomic_store(&zn->_subscription_snapshot_retired,
+                     _z_list_push(atomic_load(&zn->_subscription_snapshot_retired), old));
+        __unsafe_z_subscription_snapshot_release_retired(zn);
+    }
+}
+
+// Expands a key made of the resource ID of the match and of a suffix
+static _z_keyexpr_t __z_subscription_match_expand(const _z_subscription_match_t *match, const char *suffix) {
+    size_t prefix_len = strlen(match->_key._suffix);
+    size_t suffix_len = strlen(suffix);
+    char *rname = (char *)z_malloc(prefix_len + suffix_len + (size_t)1);
+    if (rname != NULL) {
+        (void)memcpy(rname, match->_key._suffix, prefix_len);
+        (void)memcpy(&rname[prefix_len], suffix, suffix_len + (size_t)1);
+    }
+    return _z_rname(rname);
+}
+
+// Stops counting a reader in an epoch, and releases the retired snapshots if it kept a publication from doing it
+static void __z_subscription_snapshot_leave(_z_session_t *zn, size_t epoch) {
+    if ((atomic_fetch_sub(&zn->_subscription_snapshot_readers[epoch], (size_t)1) == (size_t)1) &&
+        (atomic_load(&zn->_subscription_snapshot_retired) != NULL)) {
+        _z_mutex_lock(&zn->_mutex_inner);
+        __unsafe_z_subscription_snapshot_release_retired(zn);
+        _z_mutex_unlock(&zn->_mutex_inner);
+    }
+}
+
+// Returns a reference on the last published snapshot, or one whose ptr is NULL if there is none
+static _z_subscription_snapshot_sptr_t __z_subscription_snapshot_acquire(_z_session_t *zn) {
+    _z_subscription_snapshot_sptr_t ret = {.ptr = NULL, ._cnt = NULL};
+
+    size_t epoch = atomic_load(&zn->_subscription_snapshot_epoch);
+    (void)atomic_fetch_add(&zn->_subscription_snapshot_readers[epoch], (size_t)1);
+    // A publication that flipped the epoch in between may not have seen this reader: count it in the new epoch
+    while (atomic_load(&zn->_subscription_snapshot_epoch) != epoch) {
+        __z_subscription_snapshot_leave(zn, epoch);
+        epoch = atomic_load(&zn->_subscription_snapshot_epoch);
+        (void)atomic_fetch_add(&zn->_subscription_snapshot_readers[epoch], (size_t)1);
+    }
+    _z_subscription_snapshot_sptr_t *snap = atomic_load(&zn->_subscription_snapshot);
+    if (snap != NULL) {
+        ret = _z_subscription_snapshot_sptr_clone(snap);
+    }
+    __z_subscription_snapshot_leave(zn, epoch);
+
+    return ret;
+}
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 1
+
+/*------------------ Cache ------------------*/
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+void __unsafe_z_invalidate_subscription_cache(_z_session_t *zn) {
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0
+    zn->_subscription_cache_gen = zn->_subscription_cache_gen + (size_t)1;
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0
+#if Z_SUBSCRIPTION_SNAPSHOTS == 1
+    __unsafe_z_subscription_snapshot_publish(zn, __unsafe_z_subscription_snapshot_make(zn));
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 1
+#if Z_SUBSCRIPTION_CACHE_SIZE == 0 && Z_SUBSCRIPTION_SNAPSHOTS == 0
+    (void)(zn);
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE == 0 && Z_SUBSCRIPTION_SNAPSHOTS == 0
+}
+
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0
+static void __z_subscription_cache_entry_clear(_z_subscription_cache_entry_t *entry) {
+    if (entry->_match.ptr != NULL) {
+        (void)_z_subscription_match_sptr_drop(&entry->_match);
+        entry->_match.ptr = NULL;
+    }
+    _z_str_clear(entry->_suffix);
+    entry->_suffix = NULL;
+}
+
+// Releases the cached matches, and with them the references they hold on the subscriptions
+static void __z_subscription_cache_clear(_z_session_t *zn) {
+    for (size_t i = 0; i < (size_t)Z_SUBSCRIPTION_CACHE_SIZE; i++) {
+        __z_subscription_cache_entry_clear(&zn->_subscription_cache[i]);
+    }
+}
+
+/**
+ * Returns the match of a key made of a resource ID, from the cache or after caching it, or NULL if the key has no
+ * resource ID or is unknown.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static _z_subscription_match_sptr_t *__unsafe_z_get_subscription_match(_z_session_t *zn, const _z_keyexpr_t *keyexpr) {
+    _z_subscription_match_sptr_t *ret = NULL;
+
+    if (keyexpr->_id != Z_RESOURCE_ID_NONE) {
+        const char *suffix = (keyexpr->_suffix != NULL) ? keyexpr->_suffix : "";
+        size_t hash = (size_t)keyexpr->_id;
+        for (const char *c = suffix; *c != '\0'; c++) {
+            hash = (hash * (size_t)31) + (size_t)(uint8_t)*c;
+        }
+        _z_subscription_cache_entry_t *entry =
+            &zn->_subscription_cache[hash & ((size_t)Z_SUBSCRIPTION_CACHE_SIZE - (size_t)1)];
+
+        if ((entry->_match.ptr != NULL) && (entry->_gen == zn->_subscription_cache_gen) &&
+            (entry->_rid == keyexpr->_id) && (strcmp(entry->_suffix, suffix) == 0)) {
+            ret = &entry->_match;
+        } else {
+            _z_keyexpr_t key = __unsafe_z_get_expanded_key_from_key(zn, _Z_RESOURCE_IS_REMOTE, keyexpr);
+            if (key._suffix != NULL) {
+                _z_subscription_match_t match;
+                match._subs = __unsafe_z_get_subscriptions_by_key(zn, _Z_RESOURCE_IS_LOCAL, key);
+                match._key = key;
+
+                __z_subscription_cache_entry_clear(entry);
+                entry->_rid = keyexpr->_id;
+                entry->_suffix = _z_str_clone(suffix);
+                entry->_gen = zn->_subscription_cache_gen;
+                entry->_match = _z_subscription_match_sptr_new(match);
+                ret = &entry->_match;
+            }
+        }
+    }
+
+    return ret;
+}
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0
+
+#if Z_EXECUTOR == 1
+// A sample handed over to the executor, along with a reference to the subscription
+typedef struct {
+    _z_executor_job_t _job;  // Must be the first member
+    _z_subscription_sptr_t _sub;
+    _z_sample_t _sample;
+} __z_subscription_job_t;
+
+static void __z_subscription_job_run(_z_executor_job_t *job) {
+    __z_subscription_job_t *sjob = (__z_subscription_job_t *)job;
+    sjob->_sub.ptr->_callback(&sjob->_sample, sjob->_sub.ptr->_arg);
+}
+
+static void __z_subscription_job_free(_z_executor_job_t *job) {
+    __z_subscription_job_t *sjob = (__z_subscription_job_t *)job;
+    _z_sample_clear(&sjob->_sample);
+    _z_subscription_sptr_drop(&sjob->_sub);
+    z_free(sjob);
+}
+
+// Hands a copy of the sample over to the executor, the sample itself only living until the callbacks return
+static int8_t __z_subscription_execute(_z_session_t *zn, _z_subscription_sptr_t *sub, const _z_sample_t *s) {
+    int8_t ret = _Z_RES_OK;
+
+    __z_subscription_job_t *sjob = NULL;
+    if (_z_executor_is_running(&zn->_executor) == true) {
+        sjob = (__z_subscription_job_t *)z_malloc(sizeof(__z_subscription_job_t));
+    }
+    if (sjob != NULL) {
+        sjob->_job._run = __z_subscription_job_run;
+        sjob->_job._free = __z_subscription_job_free;
+        sjob->_sub = _z_subscription_sptr_clone(sub);
+        sjob->_sample.keyexpr = _z_keyexpr_duplicate(&s->keyexpr);
+        sjob->_sample.payload = _z_bytes_duplicate(&s->payload);
+        sjob->_sample.encoding.prefix = s->encoding.prefix;
+        sjob->_sample.encoding.suffix = _z_bytes_duplicate(&s->encoding.suffix);
+        sjob->_sample.kind = s->kind;
+        sjob->_sample.timestamp = _z_timestamp_duplicate(&s->timestamp);
+
+        ret = _z_executor_push(&zn->_executor, &sub->ptr->_strand, &sjob->_job);
+        if (ret != _Z_RES_OK) {
+            __z_subscription_job_free(&sjob->_job);  // Stopped in the meantime
+        }
+    } else {
+        ret = _Z_ERR_GENERIC;
+    }
+
+    return ret;
+}
+
+size_t _z_subscription_queue_depth(_z_session_t *zn, const _z_zint_t id) {
+    size_t ret = 0;
+
+    _z_mutex_lock(&zn->_mutex_inner);
+    _z_subscription_sptr_t *sub = __unsafe_z_get_subscription_by_id(zn, _Z_RESOURCE_IS_LOCAL, id);
+    if ((sub != NULL) && (sub->ptr->_is_executed == true)) {
+        ret = _z_executor_strand_depth(&zn->_executor, &sub->ptr->_strand);
+    }
+    _z_mutex_unlock(&zn->_mutex_inner);
+
+    return ret;
+}
+#endif  // Z_EXECUTOR == 1
+
 int8_t _z_trigger_subscriptions(_z_session_t *zn, const _z_keyexpr_t keyexpr, const _z_bytes_t payload,
                                 const _z_encoding_t encoding, const _z_zint_t kind, const _z_timestamp_t timestamp) {
     int8_t ret = _Z_RES_OK;
 
+    _z_keyexpr_t key = {._id = Z_RESOURCE_ID_NONE, ._suffix = NULL};
+    _Bool is_borrowed = false;
+    _z_subscription_sptr_list_t *subs = NULL;
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0
+    _z_subscription_match_sptr_t match = {.ptr = NULL, ._cnt = NULL};
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0
+#if Z_SUBSCRIPTION_SNAPSHOTS == 1
+    _Bool is_matched = false;  // Whether the key and the subscriptions are the ones of a match of the snapshot
+    _z_subscription_snapshot_sptr_t snap = __z_subscription_snapshot_acquire(zn);
+    if (snap.ptr != NULL) {
+        if (keyexpr._id == Z_RESOURCE_ID_NONE) {
+            if (keyexpr._suffix != NULL) {
+                key = keyexpr;  // Borrowed from the message, which outlives the callbacks
+                is_borrowed = true;
+                subs = __z_subscription_snapshot_get_by_key(snap.ptr, key);
+            }
+        } else {
+            _z_subscription_match_t *m =
+                (_z_subscription_match_t *)_z_int_void_map_get(&snap.ptr->_matches, (size_t)keyexpr._id);
+            if ((m != NULL) && ((keyexpr._suffix == NULL) || (keyexpr._suffix[0] == '\0'))) {
+                // Borrowed from the snapshot, which is released once the callbacks have returned
+                key = m->_key;
+                subs = m->_subs;
+                is_matched = true;
+            } else if (m != NULL) {
+                key = __z_subscription_match_expand(m, keyexpr._suffix);
+                if (key._suffix != NULL) {
+                    subs = __z_subscription_snapshot_get_by_key(snap.ptr, key);
+                }
+            }
+        }
+    } else
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 1
+    {
 #if Z_MULTI_THREAD == 1
-    _z_mutex_lock(&zn->_mutex_inner);
+        _z_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
-    _z_keyexpr_t key = __unsafe_z_get_expanded_key_from_key(zn, _Z_RESOURCE_IS_REMOTE, &keyexpr);
-    if (key._suffix != NULL) {
-        _z_subscription_sptr_list_t *subs = __unsafe_z_get_subscriptions_by_key(zn, _Z_RESOURCE_IS_LOCAL, key);
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0
+        _z_subscription_match_sptr_t *cached = __unsafe_z_get_subscription_match(zn, &keyexpr);
+        if (cached != NULL) {
+            // Keep the match alive while the callbacks run, even if its entry gets replaced in the meantime
+            match = _z_subscription_match_sptr_clone(cached);
+            key = match.ptr->_key;
+            subs = match.ptr->_subs;
+        } else
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0
+        if ((keyexpr._id == Z_RESOURCE_ID_NONE) && (keyexpr._suffix != NULL)) {
+            key = keyexpr;  // Borrowed from the message, which outlives the callbacks
+            is_borrowed = true;
+            subs = __unsafe_z_get_subscriptions_by_key(zn, _Z_RESOURCE_IS_LOCAL, key);
+        } else {
+            key = __unsafe_z_get_expanded_key_from_key(zn, _Z_RESOURCE_IS_REMOTE, &keyexpr);
+            if (key._suffix != NULL) {
+                subs = __unsafe_z_get_subscriptions_by_key(zn, _Z_RESOURCE_IS_LOCAL, key);
+            }
+        }
 
 #if Z_MULTI_THREAD == 1
         _z_mutex_unlock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
+    }
 
+    if (key._suffix != NULL) {
         // Build the sample
         _z_sample_t s;
         s.keyexpr = key;
@@ -173,16 +613,41 @@ int8_t _z_trigger_subscriptions(_z_session_t *zn, const _z_keyexpr_t keyexpr, co
         _z_subscription_sptr_list_t *xs = subs;
         while (xs != NULL) {
             _z_subscription_sptr_t *sub = _z_subscription_sptr_list_head(xs);
-            sub->ptr->_callback(&s, sub->ptr->_arg);
+#if Z_EXECUTOR == 1
+            // Run inline if the executor is not running
+            if ((sub->ptr->_is_executed == false) || (__z_subscription_execute(zn, sub, &s) != _Z_RES_OK))
+#endif  // Z_EXECUTOR == 1
+            {
+                sub->ptr->_callback(&s, sub->ptr->_arg);
+            }
             xs = _z_subscription_sptr_list_tail(xs);
         }
-
-        _z_keyexpr_clear(&key);
-        _z_subscription_sptr_list_free(&subs);
     } else {
         ret = _Z_ERR_DECLARE_KEYEXPR;
     }
 
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0
+    if (match.ptr != NULL) {
+        (void)_z_subscription_match_sptr_drop(&match);
+    } else
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0
+#if Z_SUBSCRIPTION_SNAPSHOTS == 1
+    if (is_matched == true) {
+        // Released along with the snapshot
+    } else
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 1
+    {
+        if (is_borrowed == false) {
+            _z_keyexpr_clear(&key);
+        }
+        _z_subscription_sptr_list_free(&subs);
+    }
+#if Z_SUBSCRIPTION_SNAPSHOTS == 1
+    if (snap.ptr != NULL) {
+        (void)_z_subscription_snapshot_sptr_drop(&snap);
+    }
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 1
+
     return ret;
 }
 
@@ -191,6 +656,19 @@ void _z_unregister_subscription(_z_session_t *zn, uint8_t is_local, _z_subscript
     _z_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0
+    // Release the references of the cache right away, so that the subscription is dropped along with the list entry
+    __z_subscription_cache_clear(zn);
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0
+    if (sub != NULL) {
+        _z_keyexpr_tree_t *tree =
+            (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_subscriptions_tree : &zn->_remote_subscriptions_tree;
+        _z_keyexpr_tree_remove(tree, sub->ptr->_key._suffix, strlen(sub->ptr->_key._suffix),
+                               __z_subscriptions_tree_eq, sub);
+        _z_int_void_map_t *ids =
+            (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_subscriptions_by_id : &zn->_remote_subscriptions_by_id;
+        _z_int_void_map_remove(ids, (size_t)sub->ptr->_id, _z_noop_free);
+    }
     if (is_local == _Z_RESOURCE_IS_LOCAL) {
         zn->_local_subscriptions =
             _z_subscription_sptr_list_drop_filter(zn->_local_subscriptions, _z_subscription_sptr_eq, sub);
@@ -198,6 +676,7 @@ void _z_unregister_subscription(_z_session_t *zn, uint8_t is_local, _z_subscript
         zn->_remote_subscriptions =
             _z_subscription_sptr_list_drop_filter(zn->_remote_subscriptions, _z_subscription_sptr_eq, sub);
     }
+    __unsafe_z_invalidate_subscription_cache(zn);
 
 #if Z_MULTI_THREAD == 1
     _z_mutex_unlock(&zn->_mutex_inner);
@@ -211,6 +690,16 @@ void _z_flush_subscriptions(_z_session_t *zn) {
 
     _z_subscription_sptr_list_free(&zn->_local_subscriptions);
     _z_subscription_sptr_list_free(&zn->_remote_subscriptions);
+    _z_keyexpr_tree_clear(&zn->_local_subscriptions_tree);
+    _z_keyexpr_tree_clear(&zn->_remote_subscriptions_tree);
+    _z_int_void_map_clear(&zn->_local_subscriptions_by_id, _z_noop_free);
+    _z_int_void_map_clear(&zn->_remote_subscriptions_by_id, _z_noop_free);
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0
+    __z_subscription_cache_clear(zn);
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0
+#if Z_SUBSCRIPTION_SNAPSHOTS == 1
+    __unsafe_z_subscription_snapshot_publish(zn, NULL);
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 1
 
 #if Z_MULTI_THREAD == 1
     _z_mutex_unlock(&zn->_mutex_inner);
@@ -17,18 +17,18 @@
 #include "zenoh-pico/utils/logging.h"
 
 int8_t _z_send_z_msg(_z_session_t *zn, _z_zenoh_message_t *z_msg, z_reliability_t reliability,
-                     z_congestion_control_t cong_ctrl) {
+                     z_congestion_control_t cong_ctrl, z_priority_t priority, _Bool is_express) {
     int8_t ret = _Z_RES_OK;
     _Z_DEBUG(">> send zenoh message\n");
 
 #if Z_UNICAST_TRANSPORT == 1
     if (zn->_tp->_type == _Z_TRANSPORT_UNICAST_TYPE) {
-        ret = _z_unicast_send_z_msg(zn, z_msg, reliability, cong_ctrl);
+        ret = _z_unicast_send_z_msg(zn, z_msg, reliability, cong_ctrl, priority, is_express);
     } else
 #endif  // Z_UNICAST_TRANSPORT == 1
 #if Z_MULTICAST_TRANSPORT == 1
         if (zn->_tp->_type == _Z_TRANSPORT_MULTICAST_TYPE) {
-        ret = _z_multicast_send_z_msg(zn, z_msg, reliability, cong_ctrl);
+        ret = _z_multicast_send_z_msg(zn, z_msg, reliability, cong_ctrl, priority, is_express);
     } else
 #endif  // Z_MULTICAST_TRANSPORT == 1
     {
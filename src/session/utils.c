@@ -13,6 +13,7 @@
 //
 
 #include <stddef.h>
+#include <string.h>
 
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/session/query.h"
@@ -57,10 +58,31 @@ _z_session_t *_z_session_init(void) {
     // Initialize the data structs
     zn->_local_resources = NULL;
     zn->_remote_resources = NULL;
+    zn->_local_resources_by_id = _z_int_void_map_make(_Z_DEFAULT_INT_MAP_CAPACITY);
+    zn->_remote_resources_by_id = _z_int_void_map_make(_Z_DEFAULT_INT_MAP_CAPACITY);
+    zn->_local_resources_by_key = _z_keyexpr_tree_make();
+    zn->_remote_resources_by_key = _z_keyexpr_tree_make();
     zn->_local_subscriptions = NULL;
     zn->_remote_subscriptions = NULL;
+    zn->_local_subscriptions_tree = _z_keyexpr_tree_make();
+    zn->_remote_subscriptions_tree = _z_keyexpr_tree_make();
+    zn->_local_subscriptions_by_id = _z_int_void_map_make(_Z_DEFAULT_INT_MAP_CAPACITY);
+    zn->_remote_subscriptions_by_id = _z_int_void_map_make(_Z_DEFAULT_INT_MAP_CAPACITY);
+#if Z_SUBSCRIPTION_CACHE_SIZE > 0
+    (void)memset(zn->_subscription_cache, 0, sizeof(zn->_subscription_cache));
+    zn->_subscription_cache_gen = 0;
+#endif  // Z_SUBSCRIPTION_CACHE_SIZE > 0
+#if Z_SUBSCRIPTION_SNAPSHOTS == 1
+    atomic_init(&zn->_subscription_snapshot, NULL);
+    atomic_init(&zn->_subscription_snapshot_epoch, 0);
+    atomic_init(&zn->_subscription_snapshot_readers[0], 0);
+    atomic_init(&zn->_subscription_snapshot_readers[1], 0);
+    atomic_init(&zn->_subscription_snapshot_retired, NULL);
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 1
     zn->_local_questionable = NULL;
     zn->_pending_queries = NULL;
+    zn->_local_questionable_by_id = _z_int_void_map_make(_Z_DEFAULT_INT_MAP_CAPACITY);
+    zn->_pending_queries_by_id = _z_int_void_map_make(_Z_DEFAULT_INT_MAP_CAPACITY);
 
     // Associate a transport with the session
     zn->_tp = NULL;
@@ -71,12 +93,23 @@ _z_session_t *_z_session_init(void) {
     _z_mutex_init(&zn->_mutex_inner);
 #endif  // Z_MULTI_THREAD == 1
 
+#if Z_EXECUTOR == 1
+    // The workers are only started on demand
+    _z_executor_init(&zn->_executor);
+#endif  // Z_EXECUTOR == 1
+
     return zn;
 }
 
 void _z_session_free(_z_session_t **zn) {
     _z_session_t *ptr = *zn;
 
+#if Z_EXECUTOR == 1
+    // Run the callbacks still queued, which may reply to queries, before the transport is released. The read task
+    // may still be running until then, but it runs the callbacks inline from now on.
+    (void)_z_executor_stop(&ptr->_executor);
+#endif  // Z_EXECUTOR == 1
+
     // Clean up transports and manager
     _z_transport_manager_free(&ptr->_tp_manager);
     if (ptr->_tp != NULL) {
@@ -89,6 +122,10 @@ void _z_session_free(_z_session_t **zn) {
     _z_flush_questionables(ptr);
     _z_flush_pending_queries(ptr);
 
+#if Z_EXECUTOR == 1
+    _z_executor_clear(&ptr->_executor);
+#endif  // Z_EXECUTOR == 1
+
 #if Z_MULTI_THREAD == 1
     // Clean up the mutexes
     _z_mutex_free(&ptr->_mutex_inner);
@@ -93,6 +93,8 @@ int _z_condvar_free(_z_condvar_t *cv) { return -1; }
 int _z_condvar_signal(_z_condvar_t *cv) { return -1; }
 
 int _z_condvar_wait(_z_condvar_t *cv, _z_mutex_t *m) { return -1; }
+
+int _z_condvar_timedwait(_z_condvar_t *cv, _z_mutex_t *m, unsigned int time) { return -1; }
 #endif  // Z_MULTI_THREAD == 1
 
 /*------------------ Sleep ------------------*/
@@ -59,6 +59,14 @@ _z_sys_net_socket_t _z_open_tcp(_z_sys_net_endpoint_t rep, uint32_t tout) {
             sock._err = true;
         }
 
+#if defined(TCP_NODELAY)
+        // Zenoh messages are batched by the transport: let express messages be sent without delay
+        if ((sock._err == false) &&
+            (setsockopt(sock._fd, IPPROTO_TCP, TCP_NODELAY, (void *)&optflag, sizeof(optflag)) < 0)) {
+            sock._err = true;
+        }
+#endif
+
 #if LWIP_SO_LINGER == 1
         struct linger ling;
         ling.l_onoff = 1;
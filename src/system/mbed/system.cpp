@@ -89,22 +89,51 @@ int _z_mutex_unlock(_z_mutex_t *m) {
 }
 
 /*------------------ Condvar ------------------*/
-int _z_condvar_init(_z_condvar_t *cv) { return 0; }
+// A ConditionVariable is bound to a mutex when it is constructed, while the waits are given theirs: each condvar
+// comes with a mutex of its own, taken by a waiter before it releases its mutex so that no signal is lost.
+struct __z_condvar_t {
+    Mutex _mutex;
+    ConditionVariable _cv;
+
+    __z_condvar_t() : _cv(_mutex) {}
+};
+
+int _z_condvar_init(_z_condvar_t *cv) {
+    *cv = new __z_condvar_t();
+    return 0;
+}
 
 int _z_condvar_free(_z_condvar_t *cv) {
-    delete ((ConditionVariable *)*cv);
+    delete ((__z_condvar_t *)*cv);
+    *cv = NULL;
     return 0;
 }
 
 int _z_condvar_signal(_z_condvar_t *cv) {
-    ((ConditionVariable *)*cv)->notify_all();
+    __z_condvar_t *c = (__z_condvar_t *)*cv;
+    c->_mutex.lock();
+    c->_cv.notify_all();
+    c->_mutex.unlock();
     return 0;
 }
 
 int _z_condvar_wait(_z_condvar_t *cv, _z_mutex_t *m) {
-    *cv = new ConditionVariable(*((Mutex *)*m));
-    ((ConditionVariable *)*cv)->wait();
-    return 0;
+    __z_condvar_t *c = (__z_condvar_t *)*cv;
+    c->_mutex.lock();
+    _z_mutex_unlock(m);
+    c->_cv.wait();
+    c->_mutex.unlock();
+    return _z_mutex_lock(m);
+}
+
+int _z_condvar_timedwait(_z_condvar_t *cv, _z_mutex_t *m, unsigned int time) {
+    __z_condvar_t *c = (__z_condvar_t *)*cv;
+    c->_mutex.lock();
+    _z_mutex_unlock(m);
+    cv_status status = c->_cv.wait_for(chrono::milliseconds(time));
+    c->_mutex.unlock();
+    _z_mutex_lock(m);
+    return (status == cv_status::timeout) ? -1 : 0;
 }
 #endif  // Z_MULTI_THREAD == 1
 
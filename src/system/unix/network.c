@@ -12,25 +12,76 @@
 //   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
 //
 
+#if defined(ZENOH_LINUX)
+#define _GNU_SOURCE  // Required for sendmmsg and recvmmsg
+#endif
+
 #include <arpa/inet.h>
 #include <errno.h>
 #include <ifaddrs.h>
 #include <net/if.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
 #include <sys/ioctl.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "zenoh-pico/collections/string.h"
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/protocol/iobuf.h"
 #include "zenoh-pico/system/platform.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/pointers.h"
 
+#if Z_LINK_TCP == 1 || Z_LINK_UDP_MULTICAST == 1 || Z_LINK_UDP_UNICAST == 1
+#define __Z_SENDV_IOV_STACK_SIZE 8
+
+// Sends all the readable bytes of a wbuf with a single sendmsg call
+size_t __z_sendmsg_wbuf(int fd, const _z_wbuf_t *wbf, struct sockaddr *addr, socklen_t addrlen, int flags) {
+    size_t ret = SIZE_MAX;
+
+    struct iovec iov_stack[__Z_SENDV_IOV_STACK_SIZE];
+    struct iovec *iov = iov_stack;
+    size_t iov_len = _z_wbuf_len_iosli(wbf);
+    if (iov_len > (size_t)__Z_SENDV_IOV_STACK_SIZE) {
+        iov = (struct iovec *)z_malloc(iov_len * sizeof(struct iovec));
+    }
+
+    if (iov != NULL) {
+        size_t iov_cnt = 0;
+        for (size_t i = 0; i < iov_len; i++) {
+            _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, i);
+            size_t readable = _z_iosli_readable(ios);
+            if (readable > (size_t)0) {
+                iov[iov_cnt].iov_base = ios->_buf + ios->_r_pos;
+                iov[iov_cnt].iov_len = readable;
+                iov_cnt = iov_cnt + (size_t)1;
+            }
+        }
+
+        struct msghdr msg;
+        (void)memset(&msg, 0, sizeof(msg));
+        msg.msg_name = addr;
+        msg.msg_namelen = addrlen;
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iov_cnt;
+        ret = sendmsg(fd, &msg, flags);
+
+        if (iov != iov_stack) {
+            z_free(iov);
+        }
+    }
+
+    return ret;
+}
+#endif
+
 #if Z_LINK_TCP == 1
 
 /*------------------ TCP sockets ------------------*/
@@ -74,6 +125,12 @@ _z_sys_net_socket_t _z_open_tcp(_z_sys_net_endpoint_t rep, uint32_t tout) {
             sock._err = true;
         }
 
+        // Zenoh messages are batched by the transport: let express messages be sent without delay
+        if ((sock._err == false) &&
+            (setsockopt(sock._fd, IPPROTO_TCP, TCP_NODELAY, (void *)&flags, sizeof(flags)) < 0)) {
+            sock._err = true;
+        }
+
         struct linger ling;
         ling.l_onoff = 1;
         ling.l_linger = Z_TRANSPORT_LEASE / 1000;
@@ -159,9 +216,165 @@ size_t _z_send_tcp(_z_sys_net_socket_t sock, const uint8_t *ptr, size_t len) {
     return send(sock._fd, ptr, len, 0);
 #endif
 }
+
+size_t _z_sendv_tcp(_z_sys_net_socket_t sock, const _z_wbuf_t *wbf) {
+#if defined(ZENOH_LINUX)
+    return __z_sendmsg_wbuf(sock._fd, wbf, NULL, 0, MSG_NOSIGNAL);
+#else
+    return __z_sendmsg_wbuf(sock._fd, wbf, NULL, 0, 0);
+#endif
+}
 #endif
 
 #if Z_LINK_UDP_UNICAST == 1 || Z_LINK_UDP_MULTICAST == 1
+#if defined(_Z_SYS_NET_SENDMMSG)
+#define __Z_SENDMMSG_MAX_MSGS 64
+#define __Z_GSO_MAX_SEGMENTS 64
+#define __Z_GSO_MAX_SIZE 65507
+// Each fragment of a burst is usually made of two ioslices: the frame header and a view on the payload
+#define __Z_SENDMMSG_IOV_STACK_SIZE (2 * __Z_SENDMMSG_MAX_MSGS)
+
+size_t __z_iovec_from_wbuf(struct iovec *iov, const _z_wbuf_t *wbf) {
+    size_t iov_cnt = 0;
+    for (size_t i = 0; i < _z_wbuf_len_iosli(wbf); i++) {
+        _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, i);
+        size_t readable = _z_iosli_readable(ios);
+        if (readable > (size_t)0) {
+            iov[iov_cnt].iov_base = ios->_buf + ios->_r_pos;
+            iov[iov_cnt].iov_len = readable;
+            iov_cnt = iov_cnt + (size_t)1;
+        }
+    }
+    return iov_cnt;
+}
+
+#if defined(UDP_SEGMENT)
+// Sends the first wbufs as a single GSO datagram, segmented by the kernel. All of them but the last one must have
+// the same length. Returns the number of wbufs sent, 0 if GSO cannot be applied, or SIZE_MAX on error.
+size_t __z_sendmsg_gso_wbufs(int fd, const _z_wbuf_t *wbfs, size_t n, size_t iov_len, struct sockaddr *addr,
+                             socklen_t addrlen) {
+    size_t ret = 0;
+
+    size_t seg_size = _z_wbuf_len(&wbfs[0]);
+    size_t total = seg_size;
+    size_t cnt = 1;
+    while ((cnt < n) && (cnt < (size_t)__Z_GSO_MAX_SEGMENTS)) {
+        size_t len = _z_wbuf_len(&wbfs[cnt]);
+        if ((len > seg_size) || ((total + len) > (size_t)__Z_GSO_MAX_SIZE)) {
+            break;
+        }
+        total = total + len;
+        cnt = cnt + (size_t)1;
+        if (len < seg_size) {
+            break;  // A shorter segment can only be the last one
+        }
+    }
+
+    if ((cnt > (size_t)1) && (seg_size > (size_t)0)) {
+        struct iovec iov_stack[__Z_SENDMMSG_IOV_STACK_SIZE];
+        struct iovec *iov = iov_stack;
+        if (iov_len > (size_t)__Z_SENDMMSG_IOV_STACK_SIZE) {
+            iov = (struct iovec *)z_malloc(iov_len * sizeof(struct iovec));
+        }
+        if (iov != NULL) {
+            size_t iov_cnt = 0;
+            for (size_t i = 0; i < cnt; i++) {
+                iov_cnt = iov_cnt + __z_iovec_from_wbuf(&iov[iov_cnt], &wbfs[i]);
+            }
+
+            union {
+                char buf[CMSG_SPACE(sizeof(uint16_t))];
+                struct cmsghdr align;
+            } ctrl;
+            (void)memset(&ctrl, 0, sizeof(ctrl));
+
+            struct msghdr msg;
+            (void)memset(&msg, 0, sizeof(msg));
+            msg.msg_name = addr;
+            msg.msg_namelen = addrlen;
+            msg.msg_iov = iov;
+            msg.msg_iovlen = iov_cnt;
+            msg.msg_control = ctrl.buf;
+            msg.msg_controllen = sizeof(ctrl.buf);
+
+            struct cmsghdr *cm = CMSG_FIRSTHDR(&msg);
+            cm->cmsg_level = IPPROTO_UDP;
+            cm->cmsg_type = UDP_SEGMENT;
+            cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            uint16_t gso_size = (uint16_t)seg_size;
+            (void)memcpy(CMSG_DATA(cm), &gso_size, sizeof(gso_size));
+
+            if (sendmsg(fd, &msg, 0) >= 0) {
+                ret = cnt;
+            } else if ((errno != EIO) && (errno != EINVAL) && (errno != ENOPROTOOPT) && (errno != EOPNOTSUPP) &&
+                       (errno != EMSGSIZE)) {
+                ret = SIZE_MAX;
+            } else {
+                ret = 0;  // GSO not supported on this socket or device, or segments exceed its MTU: use sendmmsg
+            }
+
+            if (iov != iov_stack) {
+                z_free(iov);
+            }
+        } else {
+            ret = SIZE_MAX;
+        }
+    }
+
+    return ret;
+}
+#endif
+
+// Sends each wbuf as a datagram, with as few syscalls as possible.
+// Returns the number of wbufs sent, or SIZE_MAX on error.
+size_t __z_sendmmsg_wbufs(int fd, const _z_wbuf_t *wbfs, size_t n, struct sockaddr *addr, socklen_t addrlen) {
+    size_t ret = SIZE_MAX;
+
+    size_t cnt = (n < (size_t)__Z_SENDMMSG_MAX_MSGS) ? n : (size_t)__Z_SENDMMSG_MAX_MSGS;
+    size_t iov_len = 0;
+    for (size_t i = 0; i < cnt; i++) {
+        iov_len = iov_len + _z_wbuf_len_iosli(&wbfs[i]);
+    }
+
+#if defined(UDP_SEGMENT)
+    ret = __z_sendmsg_gso_wbufs(fd, wbfs, cnt, iov_len, addr, addrlen);
+    if (ret == (size_t)0)
+#endif
+    {
+        ret = SIZE_MAX;
+        struct iovec iov_stack[__Z_SENDMMSG_IOV_STACK_SIZE];
+        struct iovec *iov = iov_stack;
+        if (iov_len > (size_t)__Z_SENDMMSG_IOV_STACK_SIZE) {
+            iov = (struct iovec *)z_malloc(iov_len * sizeof(struct iovec));
+        }
+        struct mmsghdr msgs[__Z_SENDMMSG_MAX_MSGS];
+        if (iov != NULL) {
+            (void)memset(msgs, 0, cnt * sizeof(struct mmsghdr));
+            size_t iov_cnt = 0;
+            for (size_t i = 0; i < cnt; i++) {
+                size_t iov_msg = __z_iovec_from_wbuf(&iov[iov_cnt], &wbfs[i]);
+                msgs[i].msg_hdr.msg_name = addr;
+                msgs[i].msg_hdr.msg_namelen = addrlen;
+                msgs[i].msg_hdr.msg_iov = &iov[iov_cnt];
+                msgs[i].msg_hdr.msg_iovlen = iov_msg;
+                iov_cnt = iov_cnt + iov_msg;
+            }
+
+            int sent = sendmmsg(fd, msgs, (unsigned int)cnt, 0);
+            if (sent >= 0) {
+                ret = (size_t)sent;
+            }
+
+            if (iov != iov_stack) {
+                z_free(iov);
+            }
+        }
+    }
+
+    return ret;
+}
+#endif
+
 /*------------------ UDP sockets ------------------*/
 _z_sys_net_endpoint_t _z_create_endpoint_udp(const char *s_addr, const char *s_port) {
     _z_sys_net_endpoint_t ep;
@@ -258,9 +471,23 @@ size_t _z_read_exact_udp_unicast(_z_sys_net_socket_t sock, uint8_t *ptr, size_t
 size_t _z_send_udp_unicast(_z_sys_net_socket_t sock, const uint8_t *ptr, size_t len, _z_sys_net_endpoint_t rep) {
     return sendto(sock._fd, ptr, len, 0, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen);
 }
+
+size_t _z_sendv_udp_unicast(_z_sys_net_socket_t sock, const _z_wbuf_t *wbf, _z_sys_net_endpoint_t rep) {
+    return __z_sendmsg_wbuf(sock._fd, wbf, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen, 0);
+}
+
+#if defined(_Z_SYS_NET_SENDMMSG)
+size_t _z_sendmmsg_udp_unicast(_z_sys_net_socket_t sock, const _z_wbuf_t *wbfs, size_t n, _z_sys_net_endpoint_t rep) {
+    return __z_sendmmsg_wbufs(sock._fd, wbfs, n, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen);
+}
+#endif
 #endif
 
 #if Z_LINK_UDP_MULTICAST == 1
+#if defined(_Z_SYS_NET_RECVMMSG)
+#define __Z_RECVMMSG_MAX_MSGS 64
+#endif
+
 unsigned int __get_ip_from_iface(const char *iface, int sa_family, struct sockaddr **lsockaddr) {
     unsigned int addrlen = 0U;
 
@@ -488,6 +715,47 @@ void _z_close_udp_multicast(_z_sys_net_socket_t sockrecv, _z_sys_net_socket_t so
     }
 }
 
+// Returns the size of the address of the sender of a datagram, or 0 if it must be ignored because it has been
+// sent by the local endpoint lep itself
+size_t __z_udp_multicast_raddr_len(_z_sys_net_endpoint_t lep, const struct sockaddr_storage *raddr) {
+    size_t ret = 0;
+
+    if (lep._iptcp->ai_family == AF_INET) {
+        struct sockaddr_in *a = ((struct sockaddr_in *)lep._iptcp->ai_addr);
+        const struct sockaddr_in *b = ((const struct sockaddr_in *)raddr);
+        if (!((a->sin_port == b->sin_port) && (a->sin_addr.s_addr == b->sin_addr.s_addr))) {
+            ret = sizeof(in_addr_t) + sizeof(in_port_t);
+        }
+    } else if (lep._iptcp->ai_family == AF_INET6) {
+        struct sockaddr_in6 *a = ((struct sockaddr_in6 *)lep._iptcp->ai_addr);
+        const struct sockaddr_in6 *b = ((const struct sockaddr_in6 *)raddr);
+        if (!((a->sin6_port == b->sin6_port) &&
+              (memcmp(a->sin6_addr.s6_addr, b->sin6_addr.s6_addr, sizeof(struct in6_addr)) == 0))) {
+            ret = sizeof(struct in6_addr) + sizeof(in_port_t);
+        }
+    } else {
+        // FIXME: support error report on invalid packet to the upper layer
+    }
+
+    return ret;
+}
+
+// Writes the address and port of the sender of a datagram, as sized by __z_udp_multicast_raddr_len
+void __z_udp_multicast_raddr_write(uint8_t *dst, _z_sys_net_endpoint_t lep, const struct sockaddr_storage *raddr) {
+    if (lep._iptcp->ai_family == AF_INET) {
+        const struct sockaddr_in *b = ((const struct sockaddr_in *)raddr);
+        (void)memcpy(dst, &b->sin_addr.s_addr, sizeof(in_addr_t));
+        (void)memcpy(_z_ptr_u8_offset(dst, sizeof(in_addr_t)), &b->sin_port, sizeof(in_port_t));
+    } else if (lep._iptcp->ai_family == AF_INET6) {
+        const struct sockaddr_in6 *b = ((const struct sockaddr_in6 *)raddr);
+        (void)memcpy(dst, &b->sin6_addr.s6_addr, sizeof(struct in6_addr));
+        (void)memcpy(_z_ptr_u8_offset(dst, sizeof(struct in6_addr)), &b->sin6_port, sizeof(in_port_t));
+    } else {
+        // Do nothing. It must never not enter here.
+        // Required to be compliant with MISRA 15.7 rule
+    }
+}
+
 size_t _z_read_udp_multicast(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len, _z_sys_net_endpoint_t lep,
                              _z_bytes_t *addr) {
     struct sockaddr_storage raddr;
@@ -501,39 +769,62 @@ size_t _z_read_udp_multicast(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len,
             break;
         }
 
-        if (lep._iptcp->ai_family == AF_INET) {
-            struct sockaddr_in *a = ((struct sockaddr_in *)lep._iptcp->ai_addr);
-            struct sockaddr_in *b = ((struct sockaddr_in *)&raddr);
-            if (!((a->sin_port == b->sin_port) && (a->sin_addr.s_addr == b->sin_addr.s_addr))) {
-                // If addr is not NULL, it means that the rep was requested by the upper-layers
-                if (addr != NULL) {
-                    *addr = _z_bytes_make(sizeof(in_addr_t) + sizeof(in_port_t));
-                    (void)memcpy((uint8_t *)addr->start, &b->sin_addr.s_addr, sizeof(in_addr_t));
-                    (void)memcpy((uint8_t *)(addr->start + sizeof(in_addr_t)), &b->sin_port, sizeof(in_port_t));
-                }
-                break;
+        size_t addr_len = __z_udp_multicast_raddr_len(lep, &raddr);
+        if (addr_len > (size_t)0) {
+            // If addr is not NULL, it means that the rep was requested by the upper-layers
+            if (addr != NULL) {
+                *addr = _z_bytes_make(addr_len);
+                __z_udp_multicast_raddr_write((uint8_t *)addr->start, lep, &raddr);
             }
-        } else if (lep._iptcp->ai_family == AF_INET6) {
-            struct sockaddr_in6 *a = ((struct sockaddr_in6 *)lep._iptcp->ai_addr);
-            struct sockaddr_in6 *b = ((struct sockaddr_in6 *)&raddr);
-            if (!((a->sin6_port == b->sin6_port) &&
-                  (memcmp(a->sin6_addr.s6_addr, b->sin6_addr.s6_addr, sizeof(struct in6_addr)) == 0))) {
-                // If addr is not NULL, it means that the rep was requested by the upper-layers
-                if (addr != NULL) {
-                    *addr = _z_bytes_make(sizeof(struct in6_addr) + sizeof(in_port_t));
-                    (void)memcpy((uint8_t *)addr->start, &b->sin6_addr.s6_addr, sizeof(struct in6_addr));
-                    (void)memcpy((uint8_t *)(addr->start + sizeof(struct in6_addr)), &b->sin6_port, sizeof(in_port_t));
-                }
-                break;
-            }
-        } else {
-            continue;  // FIXME: support error report on invalid packet to the upper layer
+            break;
         }
     } while (1);
 
     return rb;
 }
 
+#if defined(_Z_SYS_NET_RECVMMSG)
+size_t _z_recvmmsg_udp_multicast(_z_sys_net_socket_t sock, _z_zbuf_t *zbfs, _z_bytes_t *addrs, size_t n,
+                                 _z_sys_net_endpoint_t lep) {
+    size_t ret = SIZE_MAX;
+
+    size_t cnt = (n < (size_t)__Z_RECVMMSG_MAX_MSGS) ? n : (size_t)__Z_RECVMMSG_MAX_MSGS;
+    struct iovec iov[__Z_RECVMMSG_MAX_MSGS];
+    struct sockaddr_storage raddrs[__Z_RECVMMSG_MAX_MSGS];
+    struct mmsghdr msgs[__Z_RECVMMSG_MAX_MSGS];
+    (void)memset(msgs, 0, cnt * sizeof(struct mmsghdr));
+    for (size_t i = 0; i < cnt; i++) {
+        _z_zbuf_reset(&zbfs[i]);
+        iov[i].iov_base = _z_zbuf_get_wptr(&zbfs[i]);
+        iov[i].iov_len = _z_zbuf_space_left(&zbfs[i]);
+        msgs[i].msg_hdr.msg_name = &raddrs[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // Block until the first datagram is available, then take all those already queued up to cnt
+    int rcvd = recvmmsg(sock._fd, msgs, (unsigned int)cnt, MSG_WAITFORONE, NULL);
+    if (rcvd >= 0) {
+        ret = (size_t)rcvd;
+        for (size_t i = 0; i < ret; i++) {
+            size_t addr_len = __z_udp_multicast_raddr_len(lep, &raddrs[i]);
+            if ((addr_len > (size_t)0) && (addr_len <= addrs[i].len) &&
+                ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) == 0)) {
+                _z_zbuf_set_wpos(&zbfs[i], msgs[i].msg_len);
+                __z_udp_multicast_raddr_write((uint8_t *)addrs[i].start, lep, &raddrs[i]);
+                addrs[i].len = addr_len;
+            } else {
+                // Own or truncated datagram: leave the slot empty
+                addrs[i].len = 0;
+            }
+        }
+    }
+
+    return ret;
+}
+#endif
+
 size_t _z_read_exact_udp_multicast(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len, _z_sys_net_endpoint_t lep,
                                    _z_bytes_t *addr) {
     size_t n = 0;
@@ -557,6 +848,17 @@ size_t _z_send_udp_multicast(_z_sys_net_socket_t sock, const uint8_t *ptr, size_
     return sendto(sock._fd, ptr, len, 0, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen);
 }
 
+size_t _z_sendv_udp_multicast(_z_sys_net_socket_t sock, const _z_wbuf_t *wbf, _z_sys_net_endpoint_t rep) {
+    return __z_sendmsg_wbuf(sock._fd, wbf, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen, 0);
+}
+
+#if defined(_Z_SYS_NET_SENDMMSG)
+size_t _z_sendmmsg_udp_multicast(_z_sys_net_socket_t sock, const _z_wbuf_t *wbfs, size_t n,
+                                 _z_sys_net_endpoint_t rep) {
+    return __z_sendmmsg_wbufs(sock._fd, wbfs, n, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen);
+}
+#endif
+
 #endif
 
 #if Z_LINK_BLUETOOTH == 1
@@ -0,0 +1,382 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <string.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/result.h"
+
+#if Z_REACTOR == 1
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#define __Z_REACTOR_EVENTS_NUM 16
+#define __Z_REACTOR_SLOTS_INITIAL_CAPACITY 16
+
+// The event of the eventfd used to stop the workers, no source has a generation of 0
+#define __Z_REACTOR_WAKE_ID ((uint64_t)0)
+
+/*------------------ Reactor ------------------*/
+// Every fd is watched in one-shot mode, so that an event is delivered to a single worker and the source stays
+// disarmed until its callback has returned. Events carry the index of the slot of their source and its generation,
+// so that an event already fetched by a worker for a source that has been detached in the meantime is discarded.
+
+typedef struct {
+    int _fd;
+    _Bool _is_timer;  // If true, _fd is a timerfd owned by the slot
+    _Bool _is_used;
+    _Bool _is_busy;   // A worker is running the callback
+    _Bool _is_fired;  // The timer has been fired while its callback was running
+    uint32_t _gen;
+    _z_reactor_read_f _read_f;
+    _z_reactor_timer_f _timer_f;
+    void *_arg;
+} _z_reactor_slot_t;
+
+typedef struct {
+    int _epfd;
+    int _wakefd;
+    _z_task_t _workers[Z_REACTOR_WORKERS];
+    size_t _workers_num;
+
+    // Protects the slots, the workers only hold it to claim and release a source around its callback
+    _z_mutex_t _mutex;
+    _z_condvar_t _cv_idle;
+    _z_reactor_slot_t **_slots;
+    size_t _capacity;
+    size_t _len;
+} _z_reactor_t;
+
+// Serializes the attachments and detachments, along with the start and stop of the reactor
+static pthread_mutex_t __z_reactor_lifecycle = PTHREAD_MUTEX_INITIALIZER;
+static _z_reactor_t *__z_reactor = NULL;
+
+static uint64_t __z_reactor_source_id(size_t idx, uint32_t gen) { return ((uint64_t)gen << 32) | (uint64_t)idx; }
+
+// Returns the slot of a source if it is still attached, the mutex being held
+static _z_reactor_slot_t *__z_reactor_slot_get(const _z_reactor_t *r, uint64_t id) {
+    _z_reactor_slot_t *ret = NULL;
+
+    size_t idx = (size_t)(id & UINT32_MAX);
+    if (idx < r->_capacity) {
+        _z_reactor_slot_t *slot = r->_slots[idx];
+        if ((slot != NULL) && (slot->_is_used == true) && (slot->_gen == (uint32_t)(id >> 32))) {
+            ret = slot;
+        }
+    }
+
+    return ret;
+}
+
+static int __z_reactor_arm(const _z_reactor_t *r, int op, int fd, uint64_t id) {
+    struct epoll_event ev;
+    (void)memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.u64 = id;
+    return epoll_ctl(r->_epfd, op, fd, &ev);
+}
+
+static int __z_reactor_timer_set(int fd, uint32_t delay) {
+    struct itimerspec its;
+    (void)memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = (time_t)(delay / 1000U);
+    its.it_value.tv_nsec = (long)(delay % 1000U) * 1000000L;
+    if (delay == 0U) {
+        its.it_value.tv_nsec = 1;  // A zero value would disarm the timer
+    }
+    return timerfd_settime(fd, 0, &its, NULL);
+}
+
+static void __z_reactor_dispatch(_z_reactor_t *r, uint64_t id) {
+    _z_mutex_lock(&r->_mutex);
+    _z_reactor_slot_t *slot = __z_reactor_slot_get(r, id);
+    if (slot != NULL) {
+        slot->_is_busy = true;
+    }
+    _z_mutex_unlock(&r->_mutex);
+
+    if (slot != NULL) {
+        _Bool rearm = false;
+        uint32_t delay = 0;
+        if (slot->_is_timer == true) {
+            uint64_t expirations = 0;
+            (void)read(slot->_fd, &expirations, sizeof(expirations));
+            delay = slot->_timer_f(slot->_arg);
+            rearm = delay != _Z_REACTOR_TIMER_STOP;
+        } else {
+            rearm = slot->_read_f(slot->_arg);
+        }
+
+        _z_mutex_lock(&r->_mutex);
+        slot->_is_busy = false;
+        if ((rearm == true) && (slot->_is_used == true)) {
+            if (slot->_is_timer == true) {
+                if (slot->_is_fired == true) {
+                    slot->_is_fired = false;
+                    delay = 0;
+                }
+                (void)__z_reactor_timer_set(slot->_fd, delay);
+            }
+            (void)__z_reactor_arm(r, EPOLL_CTL_MOD, slot->_fd, id);
+        }
+        _z_condvar_signal(&r->_cv_idle);
+        _z_mutex_unlock(&r->_mutex);
+    }
+}
+
+static void *__z_reactor_worker(void *arg) {
+    _z_reactor_t *r = (_z_reactor_t *)arg;
+
+    struct epoll_event events[__Z_REACTOR_EVENTS_NUM];
+    _Bool is_running = true;
+    while (is_running == true) {
+        int n = epoll_wait(r->_epfd, events, __Z_REACTOR_EVENTS_NUM, -1);
+        if ((n < 0) && (errno != EINTR)) {
+            _Z_ERROR("Reactor worker stopped after epoll_wait failed with errno %d\n", errno);
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.u64 == __Z_REACTOR_WAKE_ID) {
+                is_running = false;
+            } else {
+                __z_reactor_dispatch(r, events[i].data.u64);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void __z_reactor_free(_z_reactor_t **r) {
+    _z_reactor_t *ptr = *r;
+
+    for (size_t i = 0; i < ptr->_capacity; i++) {
+        z_free(ptr->_slots[i]);
+    }
+    z_free(ptr->_slots);
+    _z_condvar_free(&ptr->_cv_idle);
+    _z_mutex_free(&ptr->_mutex);
+    if (ptr->_wakefd >= 0) {
+        close(ptr->_wakefd);
+    }
+    if (ptr->_epfd >= 0) {
+        close(ptr->_epfd);
+    }
+    z_free(ptr);
+    *r = NULL;
+}
+
+static void __z_reactor_stop(_z_reactor_t **r) {
+    _z_reactor_t *ptr = *r;
+
+    // The eventfd stays readable, so that it wakes up every worker
+    uint64_t one = 1;
+    (void)write(ptr->_wakefd, &one, sizeof(one));
+    for (size_t i = 0; i < ptr->_workers_num; i++) {
+        _z_task_join(&ptr->_workers[i]);
+    }
+    __z_reactor_free(r);
+}
+
+static _z_reactor_t *__z_reactor_start(void) {
+    _z_reactor_t *r = (_z_reactor_t *)z_malloc(sizeof(_z_reactor_t));
+    if (r != NULL) {
+        (void)memset(r, 0, sizeof(_z_reactor_t));
+        _z_mutex_init(&r->_mutex);
+        _z_condvar_init(&r->_cv_idle);
+        r->_epfd = epoll_create1(EPOLL_CLOEXEC);
+        r->_wakefd = eventfd(0, EFD_CLOEXEC);
+
+        struct epoll_event ev;
+        (void)memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u64 = __Z_REACTOR_WAKE_ID;
+        if ((r->_epfd < 0) || (r->_wakefd < 0) || (epoll_ctl(r->_epfd, EPOLL_CTL_ADD, r->_wakefd, &ev) != 0)) {
+            __z_reactor_free(&r);
+        }
+    }
+
+    for (size_t i = 0; (r != NULL) && (i < (size_t)Z_REACTOR_WORKERS); i++) {
+        if (_z_task_init(&r->_workers[i], NULL, __z_reactor_worker, r) == 0) {
+            r->_workers_num = r->_workers_num + (size_t)1;
+        } else if (r->_workers_num == (size_t)0) {
+            __z_reactor_free(&r);
+        } else {
+            break;  // Go on with fewer workers
+        }
+    }
+
+    return r;
+}
+
+// Returns the index of a free slot, growing the slots if needed, or the capacity on failure. The mutex is held.
+static size_t __z_reactor_slot_alloc(_z_reactor_t *r) {
+    size_t ret = 0;
+    while ((ret < r->_capacity) && (r->_slots[ret] != NULL) && (r->_slots[ret]->_is_used == true)) {
+        ret = ret + (size_t)1;
+    }
+
+    if (ret == r->_capacity) {
+        size_t capacity =
+            (r->_capacity == (size_t)0) ? (size_t)__Z_REACTOR_SLOTS_INITIAL_CAPACITY : (r->_capacity * (size_t)2);
+        _z_reactor_slot_t **slots =
+            (_z_reactor_slot_t **)z_realloc(r->_slots, capacity * sizeof(_z_reactor_slot_t *));
+        if (slots != NULL) {
+            (void)memset(&slots[r->_capacity], 0, (capacity - r->_capacity) * sizeof(_z_reactor_slot_t *));
+            r->_slots = slots;
+            r->_capacity = capacity;
+        }
+    }
+
+    if ((ret < r->_capacity) && (r->_slots[ret] == NULL)) {
+        r->_slots[ret] = (_z_reactor_slot_t *)z_malloc(sizeof(_z_reactor_slot_t));
+        if (r->_slots[ret] != NULL) {
+            (void)memset(r->_slots[ret], 0, sizeof(_z_reactor_slot_t));
+        } else {
+            ret = r->_capacity;
+        }
+    }
+
+    return ret;
+}
+
+static int8_t __z_reactor_attach(int fd, _Bool is_timer, _z_reactor_read_f read_f, _z_reactor_timer_f timer_f,
+                                 void *arg, _z_reactor_source_t *src) {
+    int8_t ret = _Z_RES_OK;
+
+    pthread_mutex_lock(&__z_reactor_lifecycle);
+    if (__z_reactor == NULL) {
+        __z_reactor = __z_reactor_start();
+    }
+
+    _z_reactor_t *r = __z_reactor;
+    if (r != NULL) {
+        _z_mutex_lock(&r->_mutex);
+        size_t idx = __z_reactor_slot_alloc(r);
+        if (idx < r->_capacity) {
+            _z_reactor_slot_t *slot = r->_slots[idx];
+            slot->_fd = fd;
+            slot->_is_timer = is_timer;
+            slot->_is_used = true;
+            slot->_is_busy = false;
+            slot->_is_fired = false;
+            slot->_gen = slot->_gen + (uint32_t)1;
+            if (slot->_gen == (uint32_t)0) {
+                slot->_gen = 1;  // Keep the generation 0 for the eventfd
+            }
+            slot->_read_f = read_f;
+            slot->_timer_f = timer_f;
+            slot->_arg = arg;
+
+            *src = __z_reactor_source_id(idx, slot->_gen);
+            if (__z_reactor_arm(r, EPOLL_CTL_ADD, fd, *src) == 0) {
+                r->_len = r->_len + (size_t)1;
+            } else {
+                slot->_is_used = false;
+                *src = _Z_REACTOR_SOURCE_NONE;
+                ret = _Z_ERR_GENERIC;
+            }
+        } else {
+            ret = _Z_ERR_GENERIC;
+        }
+        _z_mutex_unlock(&r->_mutex);
+
+        if (r->_len == (size_t)0) {
+            __z_reactor_stop(&__z_reactor);
+        }
+    } else {
+        ret = _Z_ERR_TASK_START_FAILED;
+    }
+    pthread_mutex_unlock(&__z_reactor_lifecycle);
+
+    return ret;
+}
+
+int8_t _z_reactor_attach_socket(const _z_sys_net_socket_t *sock, _z_reactor_read_f f, void *arg,
+                                _z_reactor_source_t *src) {
+    return __z_reactor_attach(sock->_fd, false, f, NULL, arg, src);
+}
+
+int8_t _z_reactor_attach_timer(uint32_t delay, _z_reactor_timer_f f, void *arg, _z_reactor_source_t *src) {
+    int8_t ret = _Z_RES_OK;
+
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if ((fd >= 0) && (__z_reactor_timer_set(fd, delay) == 0)) {
+        ret = __z_reactor_attach(fd, true, NULL, f, arg, src);
+    } else {
+        ret = _Z_ERR_GENERIC;
+    }
+
+    if ((ret != _Z_RES_OK) && (fd >= 0)) {
+        close(fd);
+    }
+
+    return ret;
+}
+
+void _z_reactor_fire_timer(const _z_reactor_source_t *src) {
+    // The reactor is not stopped while the source is attached, so the lifecycle mutex is not needed. Taking it here
+    // would deadlock with a detachment waiting for the callback this function is called from.
+    _z_reactor_t *r = __z_reactor;
+    if ((r != NULL) && (*src != _Z_REACTOR_SOURCE_NONE)) {
+        _z_mutex_lock(&r->_mutex);
+        _z_reactor_slot_t *slot = __z_reactor_slot_get(r, *src);
+        if ((slot != NULL) && (slot->_is_timer == true)) {
+            if (slot->_is_busy == true) {
+                slot->_is_fired = true;  // Rearmed with no delay once the callback has returned
+            } else {
+                (void)__z_reactor_timer_set(slot->_fd, 0);
+            }
+        }
+        _z_mutex_unlock(&r->_mutex);
+    }
+}
+
+void _z_reactor_detach(_z_reactor_source_t *src) {
+    pthread_mutex_lock(&__z_reactor_lifecycle);
+    _z_reactor_t *r = __z_reactor;
+    if ((r != NULL) && (*src != _Z_REACTOR_SOURCE_NONE)) {
+        _z_mutex_lock(&r->_mutex);
+        _z_reactor_slot_t *slot = __z_reactor_slot_get(r, *src);
+        if (slot != NULL) {
+            // Events already fetched by a worker will not find the source anymore
+            slot->_is_used = false;
+            (void)epoll_ctl(r->_epfd, EPOLL_CTL_DEL, slot->_fd, NULL);
+            while (slot->_is_busy == true) {
+                _z_condvar_wait(&r->_cv_idle, &r->_mutex);
+            }
+            if (slot->_is_timer == true) {
+                close(slot->_fd);
+            }
+            r->_len = r->_len - (size_t)1;
+        }
+        _z_mutex_unlock(&r->_mutex);
+
+        if (r->_len == (size_t)0) {
+            __z_reactor_stop(&__z_reactor);
+        }
+    }
+    *src = _Z_REACTOR_SOURCE_NONE;
+    pthread_mutex_unlock(&__z_reactor_lifecycle);
+}
+
+#endif  // Z_REACTOR == 1
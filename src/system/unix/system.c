@@ -16,14 +16,19 @@
 #include <stdlib.h>
 
 #if defined(ZENOH_LINUX)
+#include <sys/eventfd.h>
 #include <sys/random.h>
 #include <sys/time.h>
+#include <time.h>
 #endif
 
+#include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/result.h"
 
 /*------------------ Random ------------------*/
 uint8_t z_random_u8(void) {
@@ -131,6 +136,100 @@ int _z_condvar_free(_z_condvar_t *cv) { return pthread_cond_destroy(cv); }
 int _z_condvar_signal(_z_condvar_t *cv) { return pthread_cond_signal(cv); }
 
 int _z_condvar_wait(_z_condvar_t *cv, _z_mutex_t *m) { return pthread_cond_wait(cv, m); }
+
+int _z_condvar_timedwait(_z_condvar_t *cv, _z_mutex_t *m, unsigned int time) {
+    struct timespec abstime;
+    clock_gettime(CLOCK_REALTIME, &abstime);
+    abstime.tv_sec += (time_t)(time / 1000U);
+    abstime.tv_nsec += (long)(time % 1000U) * 1000000L;
+    if (abstime.tv_nsec >= 1000000000L) {
+        abstime.tv_sec += 1;
+        abstime.tv_nsec -= 1000000000L;
+    }
+    return pthread_cond_timedwait(cv, m, &abstime);
+}
+
+/*------------------ Waker ------------------*/
+int8_t _z_waker_init(_z_waker_t *w) {
+    int8_t ret = _Z_RES_OK;
+
+#if defined(ZENOH_LINUX)
+    w->_rfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    w->_wfd = w->_rfd;
+#else
+    int fds[2];
+    if (pipe(fds) == 0) {
+        (void)fcntl(fds[0], F_SETFL, O_NONBLOCK);
+        (void)fcntl(fds[1], F_SETFL, O_NONBLOCK);
+        w->_rfd = fds[0];
+        w->_wfd = fds[1];
+    } else {
+        w->_rfd = -1;
+        w->_wfd = -1;
+    }
+#endif
+    if (w->_rfd < 0) {
+        ret = _Z_ERR_GENERIC;
+    }
+
+    return ret;
+}
+
+void _z_waker_free(_z_waker_t *w) {
+    if (w->_wfd != w->_rfd) {
+        (void)close(w->_wfd);
+    }
+    if (w->_rfd >= 0) {
+        (void)close(w->_rfd);
+    }
+    w->_rfd = -1;
+    w->_wfd = -1;
+}
+
+void _z_waker_signal(const _z_waker_t *w) {
+    if (w->_wfd >= 0) {
+        // Counted by an eventfd, or a few bytes in a pipe: the waker stays readable until drained
+        uint64_t one = 1;
+        ssize_t wb = write(w->_wfd, &one, sizeof(one));
+        (void)(wb);
+    }
+}
+
+// Waits for fd, if valid, to be readable or for the waker to be signaled, and consumes the signal
+static _Bool __z_waker_poll(const _z_waker_t *w, int fd, int timeout) {
+    _Bool ret = false;
+
+    struct pollfd pfds[2];
+    pfds[0].fd = fd;  // Ignored by poll if negative
+    pfds[0].events = POLLIN;
+    pfds[0].revents = 0;
+    pfds[1].fd = w->_rfd;
+    pfds[1].events = POLLIN;
+    pfds[1].revents = 0;
+    if ((w->_rfd < 0) && (timeout < 0)) {
+        timeout = Z_CONFIG_SOCKET_TIMEOUT;  // Nothing could wake the caller up
+    }
+
+    if ((poll(pfds, 2, timeout) > 0) && ((pfds[1].revents & POLLIN) != 0)) {
+        uint64_t buf[8];
+        while (read(w->_rfd, buf, sizeof(buf)) > 0) {
+        }
+        ret = true;
+    }
+
+    return ret;
+}
+
+_Bool _z_waker_sleep_ms(const _z_waker_t *w, unsigned int time) { return __z_waker_poll(w, -1, (int)time); }
+
+_Bool _z_waker_wait_socket(const _z_waker_t *w, const _z_sys_net_socket_t *sock) {
+#if Z_LINK_TCP == 1 || Z_LINK_UDP_MULTICAST == 1 || Z_LINK_UDP_UNICAST == 1
+    return __z_waker_poll(w, sock->_fd, -1);
+#else
+    (void)(sock);
+    return __z_waker_poll(w, -1, Z_CONFIG_SOCKET_TIMEOUT);
+#endif
+}
 #endif  // Z_MULTI_THREAD == 1
 
 /*------------------ Sleep ------------------*/
@@ -15,6 +15,7 @@
 #include <random/rand32.h>
 #include <stddef.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 #include <zephyr.h>
 
@@ -97,6 +98,18 @@ int _z_condvar_free(_z_condvar_t *cv) { return pthread_cond_destroy(cv); }
 int _z_condvar_signal(_z_condvar_t *cv) { return pthread_cond_signal(cv); }
 
 int _z_condvar_wait(_z_condvar_t *cv, _z_mutex_t *m) { return pthread_cond_wait(cv, m); }
+
+int _z_condvar_timedwait(_z_condvar_t *cv, _z_mutex_t *m, unsigned int time) {
+    struct timespec abstime;
+    clock_gettime(CLOCK_REALTIME, &abstime);
+    abstime.tv_sec += (time_t)(time / 1000U);
+    abstime.tv_nsec += (long)(time % 1000U) * 1000000L;
+    if (abstime.tv_nsec >= 1000000000L) {
+        abstime.tv_sec += 1;
+        abstime.tv_nsec -= 1000000000L;
+    }
+    return pthread_cond_timedwait(cv, m, &abstime);
+}
 #endif  // Z_MULTI_THREAD == 1
 
 /*------------------ Sleep ------------------*/
@@ -0,0 +1,280 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/transport/link/queue.h"
+
+#include <stdint.h>
+
+#include "zenoh-pico/protocol/msgcodec.h"
+#include "zenoh-pico/utils/result.h"
+
+#if Z_TX_QUEUE == 1
+
+#if (Z_TX_QUEUE_SIZE & (Z_TX_QUEUE_SIZE - 1)) != 0
+#error "Z_TX_QUEUE_SIZE must be a power of two"
+#endif
+
+/*------------------ Queue ------------------*/
+// The queue follows the design of the bounded MPMC queue of Dmitry Vyukov: each slot carries a sequence
+// number telling if it is free to be written (seq == pos) or ready to be read (seq == pos + 1) at a given
+// position of the producers (head) and consumers (tail).
+
+int8_t _z_tx_queue_init(_z_tx_queue_t *q) {
+    int8_t ret = _Z_RES_OK;
+
+    q->_slots = (_z_tx_queue_slot_t *)z_malloc(Z_TX_QUEUE_SIZE * sizeof(_z_tx_queue_slot_t));
+    if (q->_slots != NULL) {
+        q->_mask = (size_t)Z_TX_QUEUE_SIZE - (size_t)1;
+        for (size_t i = 0; i < (size_t)Z_TX_QUEUE_SIZE; i++) {
+            _z_tx_queue_slot_t *slot = &q->_slots[i];
+            atomic_init(&slot->_seq, i);
+            slot->_pos = i;
+            slot->_wbuf = _z_wbuf_make(Z_TX_QUEUE_SLOT_SIZE, false);
+            slot->_large = _z_zbuf_make(0);
+            slot->_is_large = false;
+            slot->_is_valid = false;
+            slot->_is_droppable = false;
+            slot->_is_express = false;
+        }
+        atomic_init(&q->_head, 0);
+        atomic_init(&q->_tail, 0);
+
+        _z_mutex_init(&q->_mutex);
+        _z_condvar_init(&q->_cv_not_empty);
+        _z_condvar_init(&q->_cv_not_full);
+        atomic_init(&q->_waiting_not_empty, 0);
+        atomic_init(&q->_waiting_not_full, 0);
+    } else {
+        ret = _Z_ERR_IOBUF_NO_SPACE;
+    }
+
+    return ret;
+}
+
+void _z_tx_queue_clear(_z_tx_queue_t *q) {
+    if (q->_slots != NULL) {
+        for (size_t i = 0; i < (size_t)Z_TX_QUEUE_SIZE; i++) {
+            _z_wbuf_clear(&q->_slots[i]._wbuf);
+            _z_zbuf_clear(&q->_slots[i]._large);
+        }
+        z_free(q->_slots);
+        q->_slots = NULL;
+
+        _z_condvar_free(&q->_cv_not_full);
+        _z_condvar_free(&q->_cv_not_empty);
+        _z_mutex_free(&q->_mutex);
+    }
+}
+
+_z_tx_queue_slot_t *_z_tx_queue_push_begin(_z_tx_queue_t *q) {
+    _z_tx_queue_slot_t *ret = NULL;
+
+    size_t pos = atomic_load_explicit(&q->_head, memory_order_relaxed);
+    while (ret == NULL) {
+        _z_tx_queue_slot_t *slot = &q->_slots[pos & q->_mask];
+        size_t seq = atomic_load_explicit(&slot->_seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            // The slot is free: try to claim it, pos is updated if another producer was faster
+            if (atomic_compare_exchange_weak_explicit(&q->_head, &pos, pos + (size_t)1, memory_order_relaxed,
+                                                      memory_order_relaxed) == true) {
+                slot->_pos = pos;
+                ret = slot;
+            }
+        } else if (diff < 0) {
+            break;  // The queue is full
+        } else {
+            pos = atomic_load_explicit(&q->_head, memory_order_relaxed);
+        }
+    }
+
+    return ret;
+}
+
+void _z_tx_queue_push_end(_z_tx_queue_t *q, _z_tx_queue_slot_t *slot) {
+    atomic_store_explicit(&slot->_seq, slot->_pos + (size_t)1, memory_order_release);
+    _z_tx_queue_wake_consumer(q);
+}
+
+static _z_tx_queue_slot_t *__z_tx_queue_pop_begin(_z_tx_queue_t *q, _Bool only_droppable) {
+    _z_tx_queue_slot_t *ret = NULL;
+
+    size_t pos = atomic_load_explicit(&q->_tail, memory_order_relaxed);
+    while (ret == NULL) {
+        _z_tx_queue_slot_t *slot = &q->_slots[pos & q->_mask];
+        size_t seq = atomic_load_explicit(&slot->_seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + (size_t)1);
+        if ((diff == 0) && (only_droppable == true) && (slot->_is_droppable == false)) {
+            break;  // The oldest message must be sent
+        } else if (diff == 0) {
+            // The slot is ready: try to claim it, pos is updated if another consumer was faster
+            if (atomic_compare_exchange_weak_explicit(&q->_tail, &pos, pos + (size_t)1, memory_order_relaxed,
+                                                      memory_order_relaxed) == true) {
+                ret = slot;
+            }
+        } else if (diff < 0) {
+            break;  // The queue is empty, or the next message is still being encoded
+        } else {
+            pos = atomic_load_explicit(&q->_tail, memory_order_relaxed);
+        }
+    }
+
+    return ret;
+}
+
+_z_tx_queue_slot_t *_z_tx_queue_pop_begin(_z_tx_queue_t *q) { return __z_tx_queue_pop_begin(q, false); }
+
+// Claims the oldest message only if it can be dropped, so that it makes room for a newer one
+_z_tx_queue_slot_t *_z_tx_queue_pop_droppable_begin(_z_tx_queue_t *q) { return __z_tx_queue_pop_begin(q, true); }
+
+void _z_tx_queue_pop_end(_z_tx_queue_t *q, _z_tx_queue_slot_t *slot) {
+    _z_tx_queue_slot_reset(slot);
+    atomic_store_explicit(&slot->_seq, slot->_pos + q->_mask + (size_t)1, memory_order_release);
+
+    // Wake up a producer if any is waiting for free slots
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&q->_waiting_not_full, memory_order_relaxed) > 0U) {
+        _z_mutex_lock(&q->_mutex);
+        _z_condvar_signal(&q->_cv_not_full);
+        _z_mutex_unlock(&q->_mutex);
+    }
+}
+
+_Bool _z_tx_queue_is_empty(_z_tx_queue_t *q) {
+    size_t pos = atomic_load_explicit(&q->_tail, memory_order_relaxed);
+    size_t seq = atomic_load_explicit(&q->_slots[pos & q->_mask]._seq, memory_order_acquire);
+    return seq != (pos + (size_t)1);
+}
+
+static _Bool __z_tx_queue_is_full(_z_tx_queue_t *q) {
+    size_t pos = atomic_load_explicit(&q->_head, memory_order_relaxed);
+    size_t seq = atomic_load_explicit(&q->_slots[pos & q->_mask]._seq, memory_order_acquire);
+    return seq != pos;
+}
+
+void _z_tx_queue_wait_not_empty(_z_tx_queue_t *q, volatile _Bool *is_running) {
+    _z_mutex_lock(&q->_mutex);
+    atomic_fetch_add_explicit(&q->_waiting_not_empty, 1U, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    if ((*is_running == true) && (_z_tx_queue_is_empty(q) == true)) {
+        _z_condvar_wait(&q->_cv_not_empty, &q->_mutex);
+    }
+    atomic_fetch_sub_explicit(&q->_waiting_not_empty, 1U, memory_order_relaxed);
+    _z_mutex_unlock(&q->_mutex);
+}
+
+void _z_tx_queue_wait_not_full(_z_tx_queue_t *q, volatile _Bool *is_running, unsigned int timeout) {
+    _z_mutex_lock(&q->_mutex);
+    atomic_fetch_add_explicit(&q->_waiting_not_full, 1U, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    if ((*is_running == true) && (__z_tx_queue_is_full(q) == true)) {
+        if (timeout > 0U) {
+            (void)_z_condvar_timedwait(&q->_cv_not_full, &q->_mutex, timeout);
+        } else {
+            _z_condvar_wait(&q->_cv_not_full, &q->_mutex);
+        }
+    }
+    atomic_fetch_sub_explicit(&q->_waiting_not_full, 1U, memory_order_relaxed);
+    if (*is_running == false) {
+        _z_condvar_signal(&q->_cv_not_full);  // Wake up the next blocked producer, so that it notices it as well
+    }
+    _z_mutex_unlock(&q->_mutex);
+}
+
+void _z_tx_queue_wait_producers(_z_tx_queue_t *q, atomic_size_t *producers) {
+    _z_mutex_lock(&q->_mutex);
+    atomic_fetch_add_explicit(&q->_waiting_not_empty, 1U, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    if ((atomic_load_explicit(producers, memory_order_acquire) > (size_t)0) && (_z_tx_queue_is_empty(q) == true)) {
+        _z_condvar_wait(&q->_cv_not_empty, &q->_mutex);
+    }
+    atomic_fetch_sub_explicit(&q->_waiting_not_empty, 1U, memory_order_relaxed);
+    _z_mutex_unlock(&q->_mutex);
+}
+
+// Wakes up the consumer if it is waiting for messages, or for the producers to be done
+void _z_tx_queue_wake_consumer(_z_tx_queue_t *q) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&q->_waiting_not_empty, memory_order_relaxed) > 0U) {
+        _z_mutex_lock(&q->_mutex);
+        _z_condvar_signal(&q->_cv_not_empty);
+        _z_mutex_unlock(&q->_mutex);
+    }
+}
+
+void _z_tx_queue_notify(_z_tx_queue_t *q) {
+    _z_mutex_lock(&q->_mutex);
+    _z_condvar_signal(&q->_cv_not_empty);
+    _z_condvar_signal(&q->_cv_not_full);
+    _z_mutex_unlock(&q->_mutex);
+}
+
+/*------------------ Slot ------------------*/
+int8_t _z_tx_queue_slot_encode(_z_tx_queue_slot_t *slot, const _z_zenoh_message_t *z_msg) {
+    int8_t ret = _Z_RES_OK;
+
+    _z_wbuf_reset(&slot->_wbuf);
+    ret = _z_zenoh_message_encode(&slot->_wbuf, z_msg);
+    if (ret != _Z_RES_OK) {
+        // The message does not fit in the slot: encode it apart and copy it, since the
+        // payload is only wrapped by an expandable wbuf and must not be referenced once queued
+        _z_wbuf_t wbf = _z_wbuf_make(Z_IOSLICE_SIZE, true);
+        ret = _z_zenoh_message_encode(&wbf, z_msg);
+        if (ret == _Z_RES_OK) {
+            // Reuse the buffer of the previous large messages of the slot, unless this one is larger
+            size_t len = _z_wbuf_len(&wbf);
+            if (_z_zbuf_capacity(&slot->_large) < len) {
+                _z_zbuf_clear(&slot->_large);
+                slot->_large = _z_zbuf_make(len);
+                if (slot->_large._ios._buf == NULL) {
+                    slot->_large._ios._capacity = 0;
+                    ret = _Z_ERR_IOBUF_NO_SPACE;
+                }
+            }
+        }
+        if (ret == _Z_RES_OK) {
+            for (size_t i = wbf._r_idx; i <= wbf._w_idx; i++) {
+                _z_iosli_t *ios = _z_wbuf_get_iosli(&wbf, i);
+                _z_iosli_write_bytes(&slot->_large._ios, ios->_buf, ios->_r_pos, _z_iosli_readable(ios));
+            }
+            slot->_is_large = true;
+        }
+        _z_wbuf_clear(&wbf);
+    }
+    slot->_is_valid = ret == _Z_RES_OK;
+
+    return ret;
+}
+
+_z_bytes_t _z_tx_queue_slot_bytes(const _z_tx_queue_slot_t *slot) {
+    _z_bytes_t ret;
+    if (slot->_is_large == true) {
+        ret = _z_bytes_wrap(_z_zbuf_get_rptr(&slot->_large), _z_zbuf_len(&slot->_large));
+    } else {
+        ret = _z_bytes_wrap(_z_wbuf_get_iosli(&slot->_wbuf, 0)->_buf, _z_wbuf_len(&slot->_wbuf));
+    }
+    return ret;
+}
+
+void _z_tx_queue_slot_reset(_z_tx_queue_slot_t *slot) {
+    if (slot->_is_large == true) {
+        _z_zbuf_reset(&slot->_large);  // Kept for the next large message of the slot
+        slot->_is_large = false;
+    }
+    slot->_is_valid = false;
+    slot->_is_droppable = false;
+    slot->_is_express = false;
+}
+
+#endif  // Z_TX_QUEUE == 1
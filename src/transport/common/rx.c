@@ -16,6 +16,8 @@
 
 #include <stddef.h>
 
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/utils.h"
 #include "zenoh-pico/utils/logging.h"
 
 /*------------------ Reception helper ------------------*/
@@ -64,3 +66,256 @@ _z_transport_message_result_t _z_link_recv_t_msg(const _z_link_t *zl) {
 
     return ret;
 }
+
+/*------------------ Defragmentation helpers ------------------*/
+void _z_transport_defrag_append(_z_wbuf_t *dbuf, _Bool *is_dropping, const _z_payload_t *fragment) {
+    if (*is_dropping == false) {
+        size_t len = _z_wbuf_len(dbuf) + fragment->len;
+        if (len > (size_t)Z_FRAG_MAX_SIZE) {
+            // Drop the message, ignoring its remaining fragments. Otherwise, last (smaller) fragments could be
+            // understood as a complete message.
+            *is_dropping = true;
+        } else if (len > _z_wbuf_capacity(dbuf)) {
+            // Grow the defragmentation buffer, the message being reassembled in place
+            size_t capacity = _z_wbuf_capacity(dbuf) * (size_t)2;
+            if (capacity < len) {
+                capacity = len;
+            }
+            if (capacity > (size_t)Z_FRAG_MAX_SIZE) {
+                capacity = Z_FRAG_MAX_SIZE;
+            }
+            if (_z_wbuf_reserve(dbuf, capacity) != _Z_RES_OK) {
+                *is_dropping = true;
+            }
+        }
+
+        if (*is_dropping == false) {
+            (void)_z_wbuf_write_bytes(dbuf, fragment->start, 0, fragment->len);
+        } else {
+            _z_wbuf_reset(dbuf);
+        }
+    }
+}
+
+void _z_transport_defrag_reset(_z_wbuf_t *dbuf, _Bool *is_dropping) {
+    _z_wbuf_reset(dbuf);
+    *is_dropping = false;
+}
+
+/*------------------ Frame handling ------------------*/
+static void __z_transport_rx_channel_dispatch(const _z_transport_rx_channel_t *ch, uint8_t header,
+                                              _z_t_msg_frame_t *frame) {
+    if (_Z_HAS_FLAG(header, _Z_FLAG_T_F) == true) {
+        // Add the fragment to the defragmentation buffer
+        _z_transport_defrag_append(ch->_dbuf, ch->_dbuf_dropping, &frame->_payload._fragment);
+
+        // Check if this is the last fragment
+        if (_Z_HAS_FLAG(header, _Z_FLAG_T_E) == true) {
+            // Drop message if it is bigger the max buffer size
+            if (*ch->_dbuf_dropping == false) {
+                // Decode the zenoh message straight from the defragmentation buffer
+                _z_zbuf_t zbf = _z_wbuf_as_zbuf(ch->_dbuf);
+                _z_zenoh_message_result_t r_zm = _z_zenoh_message_decode(&zbf);
+                if (r_zm._tag == _Z_RES_OK) {
+                    _z_zenoh_message_t d_zm = r_zm._value;
+                    _z_handle_zenoh_message(ch->_session, &d_zm);
+
+                    // Clear must be explicitly called for fragmented zenoh messages.
+                    // Non-fragmented zenoh messages are released when their transport message is released.
+                    _z_msg_clear(&d_zm);
+                }
+            }
+
+            // Reset the defragmentation buffer
+            _z_transport_defrag_reset(ch->_dbuf, ch->_dbuf_dropping);
+        }
+    } else {
+#if Z_RX_STREAMING == 1
+        // Decode and handle the zenoh messages one by one
+        _z_zenoh_message_t *zm = _z_frame_decode_next(frame, ch->_arena);
+        while (zm != NULL) {
+            _z_handle_zenoh_message(ch->_session, zm);
+            zm = _z_frame_decode_next(frame, ch->_arena);
+        }
+#else
+        // Handle all the zenoh message, one by one
+        size_t len = _z_vec_len(&frame->_payload._messages);
+        for (size_t i = 0; i < len; i++) {
+            _z_handle_zenoh_message(ch->_session, (_z_zenoh_message_t *)_z_vec_get(&frame->_payload._messages, i));
+        }
+#endif  // Z_RX_STREAMING == 1
+    }
+}
+
+#if Z_RX_REORDER_WINDOW > 0
+void _z_transport_reorder_init(_z_transport_reorder_t *ro) { ro->_len = 0; }
+
+void _z_transport_reorder_clear(_z_transport_reorder_t *ro) {
+    for (size_t i = 0; i < ro->_len; i++) {
+        _z_zbuf_clear(&ro->_slots[i]._body);
+    }
+    ro->_len = 0;
+}
+
+void _z_transport_reorder_copy(_z_transport_reorder_t *dst, const _z_transport_reorder_t *src) {
+    for (size_t i = 0; i < src->_len; i++) {
+        dst->_slots[i]._sn = src->_slots[i]._sn;
+        dst->_slots[i]._header = src->_slots[i]._header;
+        _z_iosli_copy(&dst->_slots[i]._body._ios, &src->_slots[i]._body._ios);
+    }
+    dst->_len = src->_len;
+    dst->_since = src->_since;
+}
+
+// Removes the slot from the window, its body being then owned by the caller
+static _z_transport_reorder_slot_t __z_transport_reorder_take(_z_transport_reorder_t *ro, size_t idx) {
+    _z_transport_reorder_slot_t slot = ro->_slots[idx];
+    ro->_len = ro->_len - (size_t)1;
+    ro->_slots[idx] = ro->_slots[ro->_len];
+    if (ro->_len > (size_t)0) {
+        ro->_since = z_clock_now();  // The timeout is restarted for the frames left, as progress has been made
+    }
+    return slot;
+}
+
+// Returns the index of the frame with the given SN in the window, or the length of the window if there is none
+static size_t __z_transport_reorder_find(const _z_transport_reorder_t *ro, _z_zint_t sn) {
+    size_t idx = 0;
+    while ((idx < ro->_len) && (ro->_slots[idx]._sn != sn)) {
+        idx = idx + (size_t)1;
+    }
+    return idx;
+}
+
+// Returns the index of the frame with the lowest SN in the window, which is expected not to be empty
+static size_t __z_transport_reorder_first(const _z_transport_reorder_t *ro, _z_zint_t sn_resolution_half) {
+    size_t idx = 0;
+    for (size_t i = 1; i < ro->_len; i++) {
+        if (_z_sn_precedes(sn_resolution_half, ro->_slots[i]._sn, ro->_slots[idx]._sn) == true) {
+            idx = i;
+        }
+    }
+    return idx;
+}
+
+static void __z_transport_reorder_hold(_z_transport_reorder_t *ro, uint8_t header, const _z_t_msg_frame_t *frame) {
+    _z_transport_reorder_slot_t *slot = &ro->_slots[ro->_len];
+    slot->_sn = frame->_sn;
+    slot->_header = header;
+
+    _z_wbuf_t wbf = _z_wbuf_make(Z_IOSLICE_SIZE, true);
+    int8_t ret = _Z_RES_OK;
+#if Z_RX_STREAMING == 1
+    if (_Z_HAS_FLAG(header, _Z_FLAG_T_F) == false) {
+        // The zenoh messages have been left encoded
+        ret = _z_zint_encode(&wbf, frame->_sn);
+        if (ret == _Z_RES_OK) {
+            ret = _z_wbuf_write_bytes(&wbf, frame->_payload._encoded.start, 0, frame->_payload._encoded.len);
+        }
+    } else
+#endif  // Z_RX_STREAMING == 1
+    {
+        ret = _z_frame_encode(&wbf, header, frame);
+    }
+    if (ret == _Z_RES_OK) {
+        slot->_body = _z_wbuf_to_zbuf(&wbf);
+        if (ro->_len == (size_t)0) {
+            ro->_since = z_clock_now();
+        }
+        ro->_len = ro->_len + (size_t)1;
+    } else {
+        _Z_INFO("Out of order frame dropped because it could not be held back\n");
+    }
+    _z_wbuf_clear(&wbf);
+}
+
+// Handles a frame held back, decoding it as the frames received from the link
+static void __z_transport_rx_channel_dispatch_held(const _z_transport_rx_channel_t *ch,
+                                                   _z_transport_reorder_slot_t *slot) {
+    _z_frame_result_t r;
+    _z_frame_decode_ar(&slot->_body, slot->_header, ch->_arena, &r);
+    if (r._tag == _Z_RES_OK) {
+        __z_transport_rx_channel_dispatch(ch, slot->_header, &r._value);
+    }
+    _z_zbuf_clear(&slot->_body);
+}
+
+// Handles the frames held back that directly follow the last frame handled
+static void __z_transport_rx_channel_release(const _z_transport_rx_channel_t *ch) {
+    _z_transport_reorder_t *ro = ch->_reorder;
+    size_t idx = __z_transport_reorder_find(ro, _z_sn_increment(ch->_sn_resolution, *ch->_sn));
+    while (idx < ro->_len) {
+        _z_transport_reorder_slot_t slot = __z_transport_reorder_take(ro, idx);
+        *ch->_sn = slot._sn;
+        __z_transport_rx_channel_dispatch_held(ch, &slot);
+        idx = __z_transport_reorder_find(ro, _z_sn_increment(ch->_sn_resolution, *ch->_sn));
+    }
+}
+
+// Gives up on the frames missing before the first frame held back, which is handled along with the ones following it
+static void __z_transport_rx_channel_skip(const _z_transport_rx_channel_t *ch) {
+    _z_transport_reorder_t *ro = ch->_reorder;
+    size_t idx = __z_transport_reorder_first(ro, ch->_sn_resolution_half);
+    _z_transport_reorder_slot_t slot = __z_transport_reorder_take(ro, idx);
+    if (_z_sn_precedes(ch->_sn_resolution_half, *ch->_sn, slot._sn) == true) {
+        // The message being reassembled, if any, has lost some of its fragments
+        _z_transport_defrag_reset(ch->_dbuf, ch->_dbuf_dropping);
+        if (_Z_HAS_FLAG(slot._header, _Z_FLAG_T_F) == true) {
+            // So may have the message of this fragment: drop it up to its last fragment, which must not be decoded
+            // as a complete message
+            *ch->_dbuf_dropping = true;
+        }
+        *ch->_sn = slot._sn;
+        __z_transport_rx_channel_dispatch_held(ch, &slot);
+        __z_transport_rx_channel_release(ch);
+    } else {
+        _z_zbuf_clear(&slot._body);  // Overtaken in the meantime, e.g. by the SNs of a JOIN message
+    }
+}
+
+void _z_transport_rx_channel_handle_frame(const _z_transport_rx_channel_t *ch, uint8_t header,
+                                          _z_t_msg_frame_t *frame) {
+    _z_transport_reorder_t *ro = ch->_reorder;
+
+    if (_z_sn_precedes(ch->_sn_resolution_half, *ch->_sn, frame->_sn) == false) {
+        // Either a duplicate or a frame that has been given up on, the defragmentation buffer having been reset then
+        _Z_INFO("Message dropped because it is out of order\n");
+    } else if (frame->_sn == _z_sn_increment(ch->_sn_resolution, *ch->_sn)) {
+        *ch->_sn = frame->_sn;
+        __z_transport_rx_channel_dispatch(ch, header, frame);
+        __z_transport_rx_channel_release(ch);
+    } else if (__z_transport_reorder_find(ro, frame->_sn) == ro->_len) {
+        // Held back even if the window is full, as handling the frames held back reuses the arena it is decoded on
+        __z_transport_reorder_hold(ro, header, frame);
+        while (ro->_len > (size_t)Z_RX_REORDER_WINDOW) {
+            __z_transport_rx_channel_skip(ch);
+        }
+    } else {
+        // Duplicate of a frame already held back
+    }
+}
+
+void _z_transport_rx_channel_expire(const _z_transport_rx_channel_t *ch) {
+    _z_transport_reorder_t *ro = ch->_reorder;
+    while ((ro->_len > (size_t)0) && (z_clock_elapsed_ms(&ro->_since) >= (unsigned long)Z_RX_REORDER_TIMEOUT)) {
+        __z_transport_rx_channel_skip(ch);
+    }
+}
+#else
+void _z_transport_rx_channel_handle_frame(const _z_transport_rx_channel_t *ch, uint8_t header,
+                                          _z_t_msg_frame_t *frame) {
+    // @TODO: amend once reliability is in place. For the time being only
+    //        monothonic SNs are ensured
+    if (_z_sn_precedes(ch->_sn_resolution_half, *ch->_sn, frame->_sn) == true) {
+        *ch->_sn = frame->_sn;
+        __z_transport_rx_channel_dispatch(ch, header, frame);
+    } else {
+        _z_transport_defrag_reset(ch->_dbuf, ch->_dbuf_dropping);
+        if (_Z_HAS_FLAG(header, _Z_FLAG_T_R) == true) {
+            _Z_INFO("Reliable message dropped because it is out of order\n");
+        } else {
+            _Z_INFO("Best effort message dropped because it is out of order\n");
+        }
+    }
+}
+#endif  // Z_RX_REORDER_WINDOW > 0
@@ -48,11 +48,13 @@ void __unsafe_z_finalize_wbuf(_z_wbuf_t *buf, _Bool is_streamed) {
     }
 }
 
-_z_transport_message_t _z_frame_header(z_reliability_t reliability, _Bool is_fragment, _Bool is_final, _z_zint_t sn) {
+_z_transport_message_t _z_frame_header(z_priority_t priority, z_reliability_t reliability, _Bool is_fragment,
+                                       _Bool is_final, _z_zint_t sn) {
     // Create the frame session message that carries the zenoh message
     _Bool is_reliable = reliability == Z_RELIABILITY_RELIABLE;
 
     _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, is_reliable, is_fragment, is_final);
+    t_msg._body._frame._priority = priority;
 
     return t_msg;
 }
@@ -61,8 +63,13 @@ _z_transport_message_t _z_frame_header(z_reliability_t reliability, _Bool is_fra
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
  *  - ztu->mutex_tx
+ *
+ * On scatter-gather links, the fragment payload is not copied: dst points into src, which must
+ * then outlive the transmission of dst. Other links need the whole fragment to be contiguous,
+ * hence the payload is copied on them.
  */
-int8_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z_reliability_t reliability, size_t sn) {
+int8_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z_priority_t priority,
+                                           z_reliability_t reliability, size_t sn, _Bool is_scatter_gather) {
     int8_t ret = _Z_RES_OK;
 
     // Assume first that this is not the final fragment
@@ -70,7 +77,7 @@ int8_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z_rel
     do {
         size_t w_pos = _z_wbuf_get_wpos(dst);  // Mark the buffer for the writing operation
 
-        _z_transport_message_t f_hdr = _z_frame_header(reliability, true, is_final, sn);
+        _z_transport_message_t f_hdr = _z_frame_header(priority, reliability, true, is_final, sn);
         ret = _z_transport_message_encode(dst, &f_hdr);  // Encode the frame header
         if (ret == _Z_RES_OK) {
             size_t space_left = _z_wbuf_space_left(dst);
@@ -83,7 +90,11 @@ int8_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z_rel
             }
 
             size_t to_copy = (bytes_left <= space_left) ? bytes_left : space_left;  // Compute bytes to write
-            ret = _z_wbuf_siphon(dst, src, to_copy);                                // Write the fragment
+            if (is_scatter_gather == true) {
+                ret = _z_wbuf_siphon_wrap(dst, src, to_copy);  // Point the fragment to the source
+            } else {
+                ret = _z_wbuf_siphon(dst, src, to_copy);  // Write the fragment
+            }
             break;
         } else {
             ret = _Z_ERR_SERIALIZING_TRANSPORT_MESSAGE;
@@ -114,6 +125,26 @@ int8_t _z_send_t_msg(_z_transport_t *zt, const _z_transport_message_t *t_msg) {
     return ret;
 }
 
+int8_t _z_flush(_z_transport_t *zt) {
+    int8_t ret = _Z_RES_OK;
+
+#if Z_UNICAST_TRANSPORT == 1
+    if (zt->_type == _Z_TRANSPORT_UNICAST_TYPE) {
+        ret = _z_unicast_flush(&zt->_transport._unicast);
+    } else
+#endif  // Z_UNICAST_TRANSPORT == 1
+#if Z_MULTICAST_TRANSPORT == 1
+        if (zt->_type == _Z_TRANSPORT_MULTICAST_TYPE) {
+        ret = _Z_RES_OK;  // Zenoh messages are not batched on multicast transports
+    } else
+#endif  // Z_MULTICAST_TRANSPORT == 1
+    {
+        ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+    }
+
+    return ret;
+}
+
 #if Z_UNICAST_TRANSPORT == 1 || Z_MULTICAST_TRANSPORT == 1
 int8_t _z_link_send_t_msg(const _z_link_t *zl, const _z_transport_message_t *t_msg) {
     int8_t ret = _Z_RES_OK;
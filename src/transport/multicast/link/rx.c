@@ -23,24 +23,6 @@
 
 #if Z_MULTICAST_TRANSPORT == 1
 
-_z_transport_peer_entry_t *_z_find_peer_entry(_z_transport_peer_entry_list_t *l, _z_bytes_t *remote_addr) {
-    _z_transport_peer_entry_t *ret = NULL;
-
-    _z_transport_peer_entry_list_t *xs = l;
-    for (; xs != NULL; xs = _z_transport_peer_entry_list_tail(xs)) {
-        _z_transport_peer_entry_t *val = _z_transport_peer_entry_list_head(xs);
-        if (val->_remote_addr.len != remote_addr->len) {
-            continue;
-        }
-
-        if (memcmp(val->_remote_addr.start, remote_addr->start, remote_addr->len) == 0) {
-            ret = val;
-        }
-    }
-
-    return ret;
-}
-
 /*------------------ Reception helper ------------------*/
 void _z_multicast_recv_t_msg_na(_z_transport_multicast_t *ztm, _z_transport_message_result_t *r, _z_bytes_t *addr) {
     r->_tag = _Z_RES_OK;
@@ -83,7 +65,7 @@ void _z_multicast_recv_t_msg_na(_z_transport_multicast_t *ztm, _z_transport_mess
 
     _Z_DEBUG(">> \t transport_message_decode\n");
     if (r->_tag == _Z_RES_OK) {
-        _z_transport_message_decode_na(&ztm->_zbuf, r);
+        _z_transport_message_decode_ar(&ztm->_zbuf, &ztm->_arena, r);
     }
 
 #if Z_MULTI_THREAD == 1
@@ -98,6 +80,25 @@ _z_transport_message_result_t _z_multicast_recv_t_msg(_z_transport_multicast_t *
     return r;
 }
 
+// Returns the reception state of the frames sent by the peer with the given reliability
+static _z_transport_rx_channel_t __z_multicast_rx_channel(_z_transport_multicast_t *ztm,
+                                                          _z_transport_peer_entry_t *entry, _Bool is_reliable) {
+    _z_transport_rx_channel_t ch;
+    ch._session = ztm->_session;
+    ch._arena = &ztm->_arena;
+    ch._sn_resolution = entry->_sn_resolution;
+    ch._sn_resolution_half = entry->_sn_resolution_half;
+    ch._sn = (is_reliable == true) ? &entry->_sn_rx_sns._val._plain._reliable
+                                   : &entry->_sn_rx_sns._val._plain._best_effort;
+    ch._dbuf = (is_reliable == true) ? &entry->_dbuf_reliable : &entry->_dbuf_best_effort;
+    ch._dbuf_dropping =
+        (is_reliable == true) ? &entry->_dbuf_reliable_dropping : &entry->_dbuf_best_effort_dropping;
+#if Z_RX_REORDER_WINDOW > 0
+    ch._reorder = (is_reliable == true) ? &entry->_reorder_reliable : &entry->_reorder_best_effort;
+#endif  // Z_RX_REORDER_WINDOW > 0
+    return ch;
+}
+
 int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_transport_message_t *t_msg,
                                              _z_bytes_t *addr) {
 #if Z_MULTI_THREAD == 1
@@ -106,7 +107,7 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
 #endif  // Z_MULTI_THREAD == 1
 
     // Mark the session that we have received data from this peer
-    _z_transport_peer_entry_t *entry = _z_find_peer_entry(ztm->_peers, addr);
+    _z_transport_peer_entry_t *entry = _z_transport_peer_table_get(&ztm->_peers, addr);
     switch (_Z_MID(t_msg->_header)) {
         case _Z_MID_SCOUT: {
             // Do nothing, multicast transports are not expected to handle SCOUT messages on established sessions
@@ -136,6 +137,12 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
                 }
             }
 
+            // A peer announcing another PID on a known address has been restarted: replace its entry
+            if ((entry != NULL) && (_z_bytes_eq(&entry->_remote_pid, &t_msg->_body._join._pid) == false)) {
+                _z_transport_peer_table_remove(&ztm->_peers, entry);
+                entry = NULL;
+            }
+
             if (entry == NULL)  // New peer
             {
                 entry = (_z_transport_peer_entry_t *)z_malloc(sizeof(_z_transport_peer_entry_t));
@@ -152,19 +159,29 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
                 _z_conduit_sn_list_decrement(entry->_sn_resolution, &entry->_sn_rx_sns);
 
 #if Z_DYNAMIC_MEMORY_ALLOCATION == 1
-                entry->_dbuf_reliable = _z_wbuf_make(0, true);
-                entry->_dbuf_best_effort = _z_wbuf_make(0, true);
+                // Initialize the defragmentation buffers, grown on demand by the fragments
+                entry->_dbuf_reliable = _z_wbuf_make(0, false);
+                entry->_dbuf_best_effort = _z_wbuf_make(0, false);
 #else
+                // Initialize the defragmentation buffers for the largest message, so that they are never grown
                 entry->_dbuf_reliable = _z_wbuf_make(Z_FRAG_MAX_SIZE, false);
                 entry->_dbuf_best_effort = _z_wbuf_make(Z_FRAG_MAX_SIZE, false);
 #endif
+                entry->_dbuf_reliable_dropping = false;
+                entry->_dbuf_best_effort_dropping = false;
+#if Z_RX_REORDER_WINDOW > 0
+                _z_transport_reorder_init(&entry->_reorder_reliable);
+                _z_transport_reorder_init(&entry->_reorder_best_effort);
+#endif  // Z_RX_REORDER_WINDOW > 0
 
                 // Update lease time (set as ms during)
                 entry->_lease = t_msg->_body._join._lease;
                 entry->_next_lease = entry->_lease;
                 entry->_received = true;
 
-                ztm->_peers = _z_transport_peer_entry_list_push(ztm->_peers, entry);
+                if (_z_transport_peer_table_insert(&ztm->_peers, entry) != _Z_RES_OK) {
+                    _z_transport_peer_entry_elem_free((void **)&entry);
+                }
             } else  // Existing peer
             {
                 entry->_received = true;
@@ -172,7 +189,7 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
                 // Check if the sn resolution remains the same
                 if ((_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_S) == true) &&
                     (entry->_sn_resolution != t_msg->_body._join._sn_resolution)) {
-                    _z_transport_peer_entry_list_drop_filter(ztm->_peers, _z_transport_peer_entry_eq, entry);
+                    _z_transport_peer_table_remove(&ztm->_peers, entry);
                     break;
                 }
 
@@ -200,7 +217,7 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
                     break;
                 }
             }
-            ztm->_peers = _z_transport_peer_entry_list_drop_filter(ztm->_peers, _z_transport_peer_entry_eq, entry);
+            _z_transport_peer_table_remove(&ztm->_peers, entry);
 
             break;
         }
@@ -221,6 +238,13 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
                 break;
             }
             entry->_received = true;
+#if Z_RX_REORDER_WINDOW > 0
+            // Handle the frames held back for too long, in case no frame has been received since
+            _z_transport_rx_channel_t ch = __z_multicast_rx_channel(ztm, entry, true);
+            _z_transport_rx_channel_expire(&ch);
+            ch = __z_multicast_rx_channel(ztm, entry, false);
+            _z_transport_rx_channel_expire(&ch);
+#endif  // Z_RX_REORDER_WINDOW > 0
 
             break;
         }
@@ -237,82 +261,13 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
             }
             entry->_received = true;
 
-            // Check if the SN is correct
-            if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_R) == true) {
-                // @TODO: amend once reliability is in place. For the time being only
-                //        monothonic SNs are ensured
-                if (_z_sn_precedes(entry->_sn_resolution_half, entry->_sn_rx_sns._val._plain._reliable,
-                                   t_msg->_body._frame._sn) == true) {
-                    entry->_sn_rx_sns._val._plain._reliable = t_msg->_body._frame._sn;
-                } else {
-                    _z_wbuf_clear(&entry->_dbuf_reliable);
-                    _Z_INFO("Reliable message dropped because it is out of order");
-                    break;
-                }
-            } else {
-                if (_z_sn_precedes(entry->_sn_resolution_half, entry->_sn_rx_sns._val._plain._best_effort,
-                                   t_msg->_body._frame._sn) == true) {
-                    entry->_sn_rx_sns._val._plain._best_effort = t_msg->_body._frame._sn;
-                } else {
-                    _z_wbuf_clear(&entry->_dbuf_best_effort);
-                    _Z_INFO("Best effort message dropped because it is out of order");
-                    break;
-                }
-            }
-
-            if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_F) == true) {
-                // Select the right defragmentation buffer
-                _z_wbuf_t *dbuf = (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_R) == true) ? &entry->_dbuf_reliable
-                                                                                     : &entry->_dbuf_best_effort;
-
-                _Bool drop = false;
-                if ((_z_wbuf_len(dbuf) + t_msg->_body._frame._payload._fragment.len) > Z_FRAG_MAX_SIZE) {
-                    // Filling the wbuf capacity as a way to signling the last fragment to reset the dbuf
-                    // Otherwise, last (smaller) fragments can be understood as a complete message
-                    _z_wbuf_write_bytes(dbuf, t_msg->_body._frame._payload._fragment.start, 0,
-                                        _z_wbuf_space_left(dbuf));
-                    drop = true;
-                } else {
-                    // Add the fragment to the defragmentation buffer
-                    _z_wbuf_write_bytes(dbuf, t_msg->_body._frame._payload._fragment.start, 0,
-                                        t_msg->_body._frame._payload._fragment.len);
-                }
-
-                // Check if this is the last fragment
-                if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_E) == true) {
-                    // Drop message if it is bigger the max buffer size
-                    if (drop == true) {
-                        _z_wbuf_reset(dbuf);
-                        break;
-                    }
-
-                    // Convert the defragmentation buffer into a decoding buffer
-                    _z_zbuf_t zbf = _z_wbuf_to_zbuf(dbuf);
-
-                    // Decode the zenoh message
-                    _z_zenoh_message_result_t r_zm = _z_zenoh_message_decode(&zbf);
-                    if (r_zm._tag == _Z_RES_OK) {
-                        _z_zenoh_message_t d_zm = r_zm._value;
-                        _z_handle_zenoh_message(ztm->_session, &d_zm);
-
-                        // Clear must be explicitly called for fragmented zenoh messages.
-                        // Non-fragmented zenoh messages are released when their transport message is released.
-                        _z_msg_clear(&d_zm);
-                    }
-
-                    // Free the decoding buffer
-                    _z_zbuf_clear(&zbf);
-                    // Reset the defragmentation buffer
-                    _z_wbuf_reset(dbuf);
-                }
-            } else {
-                // Handle all the zenoh message, one by one
-                unsigned int len = _z_vec_len(&t_msg->_body._frame._payload._messages);
-                for (unsigned int i = 0; i < len; i++) {
-                    _z_handle_zenoh_message(
-                        ztm->_session, (_z_zenoh_message_t *)_z_vec_get(&t_msg->_body._frame._payload._messages, i));
-                }
-            }
+            _z_transport_rx_channel_t ch =
+                __z_multicast_rx_channel(ztm, entry, _Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_R));
+            _z_transport_rx_channel_handle_frame(&ch, t_msg->_header, &t_msg->_body._frame);
+#if Z_RX_REORDER_WINDOW > 0
+            // Only once the frame has been handled, as the frames held back are decoded on the same arena
+            _z_transport_rx_channel_expire(&ch);
+#endif  // Z_RX_REORDER_WINDOW > 0
             break;
         }
 
@@ -24,40 +24,54 @@
 
 #if Z_MULTICAST_TRANSPORT == 1
 
-_z_zint_t _z_get_minimum_lease(_z_transport_peer_entry_list_t *peers, _z_zint_t local_lease) {
+_z_zint_t _z_get_minimum_lease(const _z_transport_peer_table_t *peers, _z_zint_t local_lease) {
     _z_zint_t ret = local_lease;
 
-    _z_transport_peer_entry_list_t *it = peers;
-    while (it != NULL) {
-        _z_transport_peer_entry_t *val = _z_transport_peer_entry_list_head(it);
+    size_t pos = 0;
+    _z_transport_peer_entry_t *val = _z_transport_peer_table_next(peers, &pos);
+    while (val != NULL) {
         _z_zint_t lease = val->_lease;
         if (lease < ret) {
             ret = lease;
         }
 
-        it = _z_transport_peer_entry_list_tail(it);
+        val = _z_transport_peer_table_next(peers, &pos);
     }
 
     return ret;
 }
 
-_z_zint_t _z_get_next_lease(_z_transport_peer_entry_list_t *peers) {
+_z_zint_t _z_get_next_lease(const _z_transport_peer_table_t *peers) {
     _z_zint_t ret = SIZE_MAX;
 
-    _z_transport_peer_entry_list_t *it = peers;
-    while (it != NULL) {
-        _z_transport_peer_entry_t *val = _z_transport_peer_entry_list_head(it);
+    size_t pos = 0;
+    _z_transport_peer_entry_t *val = _z_transport_peer_table_next(peers, &pos);
+    while (val != NULL) {
         _z_zint_t next_lease = val->_next_lease;
         if (next_lease < ret) {
             ret = next_lease;
         }
 
-        it = _z_transport_peer_entry_list_tail(it);
+        val = _z_transport_peer_table_next(peers, &pos);
     }
 
     return ret;
 }
 
+#if Z_MULTI_THREAD == 1
+// Keeps the peers heard of since the last lease check, resetting their lease
+static _Bool __z_multicast_keep_unexpired_peer(_z_transport_peer_entry_t *entry) {
+    _Bool ret = entry->_received;
+    if (ret == true) {
+        entry->_received = false;
+        entry->_next_lease = entry->_lease;
+    } else {
+        _Z_INFO("Remove peer from know list because it has expired after %zums\n", entry->_lease);
+    }
+    return ret;
+}
+#endif  // Z_MULTI_THREAD == 1
+
 int8_t _zp_multicast_send_keep_alive(_z_transport_multicast_t *ztm) {
     int8_t ret = _Z_RES_OK;
 
@@ -70,95 +84,99 @@ int8_t _zp_multicast_send_keep_alive(_z_transport_multicast_t *ztm) {
     return ret;
 }
 
-void *_zp_multicast_lease_task(void *ztm_arg) {
 #if Z_MULTI_THREAD == 1
-    _z_transport_multicast_t *ztm = (_z_transport_multicast_t *)ztm_arg;
-    ztm->_lease_task_running = true;
-    ztm->_transmitted = false;
+// Runs the lease, join and keep alive checks that are due, and returns the interval in milliseconds until the next
+// step. The peer mutex is held.
+static _z_zint_t __z_multicast_lease_step(_z_transport_multicast_t *ztm, _z_zint_t *next_lease,
+                                          _z_zint_t *next_keep_alive, _z_zint_t *next_join) {
+    if (*next_lease <= 0) {
+        _z_transport_peer_table_retain(&ztm->_peers, __z_multicast_keep_unexpired_peer);
+    }
 
-    // From all peers, get the next lease time (minimum)
-    _z_zint_t next_lease = _z_get_minimum_lease(ztm->_peers, ztm->_lease);
-    _z_zint_t next_keep_alive = next_lease / Z_TRANSPORT_LEASE_EXPIRE_FACTOR;
-    _z_zint_t next_join = Z_JOIN_INTERVAL;
+    if (*next_join <= 0) {
+        _zp_multicast_send_join(ztm);
+        ztm->_transmitted = true;
 
-    _z_transport_peer_entry_list_t *it = NULL;
-    while (ztm->_lease_task_running == true) {
-        _z_mutex_lock(&ztm->_mutex_peer);
+        // Reset the join parameters
+        *next_join = Z_JOIN_INTERVAL;
+    }
 
-        if (next_lease <= 0) {
-            it = ztm->_peers;
-            while (it != NULL) {
-                _z_transport_peer_entry_t *entry = _z_transport_peer_entry_list_head(it);
-                if (entry->_received == true) {
-                    // Reset the lease parameters
-                    entry->_received = false;
-                    entry->_next_lease = entry->_lease;
-                    it = _z_transport_peer_entry_list_tail(it);
-                } else {
-                    _Z_INFO("Remove peer from know list because it has expired after %zums\n", entry->_lease);
-                    ztm->_peers =
-                        _z_transport_peer_entry_list_drop_filter(ztm->_peers, _z_transport_peer_entry_eq, entry);
-                    it = ztm->_peers;
-                }
+    if (*next_keep_alive <= 0) {
+        // Check if need to send a keep alive
+        if (ztm->_transmitted == false) {
+            if (_zp_multicast_send_keep_alive(ztm) < 0) {
+                // TODO: Handle retransmission or error
             }
         }
 
-        if (next_join <= 0) {
-            _zp_multicast_send_join(ztm);
-            ztm->_transmitted = true;
+        // Reset the keep alive parameters
+        ztm->_transmitted = false;
+        *next_keep_alive = _z_get_minimum_lease(&ztm->_peers, ztm->_lease) / Z_TRANSPORT_LEASE_EXPIRE_FACTOR;
+    }
 
-            // Reset the join parameters
-            next_join = Z_JOIN_INTERVAL;
+    // Compute the target interval to sleep
+    _z_zint_t interval;
+    if (*next_lease > 0) {
+        interval = *next_lease;
+        if (*next_keep_alive < interval) {
+            interval = *next_keep_alive;
+        }
+        if (*next_join < interval) {
+            interval = *next_join;
+        }
+    } else {
+        interval = *next_keep_alive;
+        if (*next_join < interval) {
+            interval = *next_join;
         }
+    }
 
-        if (next_keep_alive <= 0) {
-            // Check if need to send a keep alive
-            if (ztm->_transmitted == false) {
-                if (_zp_multicast_send_keep_alive(ztm) < 0) {
-                    // TODO: Handle retransmission or error
-                }
-            }
+    return interval;
+}
 
-            // Reset the keep alive parameters
-            ztm->_transmitted = false;
-            next_keep_alive = _z_get_minimum_lease(ztm->_peers, ztm->_lease) / Z_TRANSPORT_LEASE_EXPIRE_FACTOR;
-        }
+// Decrements all intervals once the time returned by the last step has elapsed. The peer mutex is held.
+static void __z_multicast_lease_elapse(_z_transport_multicast_t *ztm, _z_zint_t interval, _z_zint_t *next_lease,
+                                       _z_zint_t *next_keep_alive, _z_zint_t *next_join) {
+    size_t pos = 0;
+    _z_transport_peer_entry_t *entry = _z_transport_peer_table_next(&ztm->_peers, &pos);
+    while (entry != NULL) {
+        entry->_next_lease = entry->_next_lease - interval;
+        entry = _z_transport_peer_table_next(&ztm->_peers, &pos);
+    }
+    *next_lease = _z_get_next_lease(&ztm->_peers);
+    *next_keep_alive = *next_keep_alive - interval;
+    *next_join = *next_join - interval;
+}
+#endif  // Z_MULTI_THREAD == 1
 
-        // Compute the target interval to sleep
-        _z_zint_t interval;
-        if (next_lease > 0) {
-            interval = next_lease;
-            if (next_keep_alive < interval) {
-                interval = next_keep_alive;
-            }
-            if (next_join < interval) {
-                interval = next_join;
-            }
-        } else {
-            interval = next_keep_alive;
-            if (next_join < interval) {
-                interval = next_join;
-            }
-        }
+void *_zp_multicast_lease_task(void *ztm_arg) {
+#if Z_MULTI_THREAD == 1
+    _z_transport_multicast_t *ztm = (_z_transport_multicast_t *)ztm_arg;
+    ztm->_lease_task_running = true;
+    ztm->_transmitted = false;
+
+    // From all peers, get the next lease time (minimum)
+    _z_zint_t next_lease = _z_get_minimum_lease(&ztm->_peers, ztm->_lease);
+    _z_zint_t next_keep_alive = next_lease / Z_TRANSPORT_LEASE_EXPIRE_FACTOR;
+    _z_zint_t next_join = Z_JOIN_INTERVAL;
 
+    while (ztm->_lease_task_running == true) {
+        _z_mutex_lock(&ztm->_mutex_peer);
+        _z_zint_t interval = __z_multicast_lease_step(ztm, &next_lease, &next_keep_alive, &next_join);
         _z_mutex_unlock(&ztm->_mutex_peer);
 
         // The keep alive and lease intervals are expressed in milliseconds
+#if defined(_Z_SYS_WAKER)
+        // The interval has not fully elapsed if the task has been woken up to be stopped
+        if (_z_waker_sleep_ms(&ztm->_lease_waker, (unsigned int)interval) == true) {
+            continue;
+        }
+#else
         z_sleep_ms(interval);
+#endif  // defined(_Z_SYS_WAKER)
 
-        // Decrement all intervals
         _z_mutex_lock(&ztm->_mutex_peer);
-
-        it = ztm->_peers;
-        while (it != NULL) {
-            _z_transport_peer_entry_t *entry = _z_transport_peer_entry_list_head(it);
-            entry->_next_lease = entry->_next_lease - interval;
-            it = _z_transport_peer_entry_list_tail(it);
-        }
-        next_lease = _z_get_next_lease(ztm->_peers);
-        next_keep_alive = next_keep_alive - interval;
-        next_join = next_join - interval;
-
+        __z_multicast_lease_elapse(ztm, interval, &next_lease, &next_keep_alive, &next_join);
         _z_mutex_unlock(&ztm->_mutex_peer);
     }
 #endif  // Z_MULTI_THREAD == 1
@@ -166,4 +184,44 @@ void *_zp_multicast_lease_task(void *ztm_arg) {
     return 0;
 }
 
+#if Z_REACTOR == 1
+static uint32_t __z_multicast_lease_expired(void *ztm_arg) {
+    _z_transport_multicast_t *ztm = (_z_transport_multicast_t *)ztm_arg;
+
+    uint32_t ret = _Z_REACTOR_TIMER_STOP;
+    if (ztm->_lease_task_running == true) {
+        _z_mutex_lock(&ztm->_mutex_peer);
+        __z_multicast_lease_elapse(ztm, ztm->_lease_interval, &ztm->_next_lease, &ztm->_next_keep_alive,
+                                   &ztm->_next_join);
+        ztm->_lease_interval =
+            __z_multicast_lease_step(ztm, &ztm->_next_lease, &ztm->_next_keep_alive, &ztm->_next_join);
+        _z_mutex_unlock(&ztm->_mutex_peer);
+        ret = (uint32_t)ztm->_lease_interval;
+    }
+
+    return ret;
+}
+
+int8_t _zp_multicast_attach_lease(_z_transport_multicast_t *ztm) {
+    ztm->_lease_task_running = true;
+    ztm->_transmitted = false;
+
+    // Run the first step right away, as the lease task does, then arm the timer for the next one
+    _z_mutex_lock(&ztm->_mutex_peer);
+    ztm->_next_lease = _z_get_minimum_lease(&ztm->_peers, ztm->_lease);
+    ztm->_next_keep_alive = ztm->_next_lease / Z_TRANSPORT_LEASE_EXPIRE_FACTOR;
+    ztm->_next_join = Z_JOIN_INTERVAL;
+    ztm->_lease_interval = __z_multicast_lease_step(ztm, &ztm->_next_lease, &ztm->_next_keep_alive, &ztm->_next_join);
+    _z_mutex_unlock(&ztm->_mutex_peer);
+
+    int8_t ret =
+        _z_reactor_attach_timer((uint32_t)ztm->_lease_interval, __z_multicast_lease_expired, ztm, &ztm->_lease_source);
+    if (ret != _Z_RES_OK) {
+        ztm->_lease_task_running = false;
+    }
+
+    return ret;
+}
+#endif  // Z_REACTOR == 1
+
 #endif  // Z_MULTICAST_TRANSPORT == 1
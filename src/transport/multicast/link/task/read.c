@@ -29,7 +29,7 @@ int8_t _zp_multicast_read(_z_transport_multicast_t *ztm) {
     _z_transport_message_result_t r_s = _z_multicast_recv_t_msg(ztm, &addr);
     if (r_s._tag == _Z_RES_OK) {
         ret = _z_multicast_handle_transport_message(ztm, &r_s._value, &addr);
-        _z_t_msg_clear(&r_s._value);
+        _z_t_msg_clear_ar(&r_s._value, &ztm->_arena);
     } else {
         ret = r_s._tag;
     }
@@ -37,6 +37,43 @@ int8_t _zp_multicast_read(_z_transport_multicast_t *ztm) {
     return ret;
 }
 
+#if Z_MULTI_THREAD == 1
+// Receives a burst of datagrams with a single call and handles the messages of each datagram in turn, with the
+// address of its sender kept in the inline storage of the transport
+static void __z_multicast_read_burst(_z_transport_multicast_t *ztm) {
+    for (size_t i = 0; i < (size_t)Z_RX_BURST_SIZE; i++) {
+        ztm->_addr_burst[i] =
+            _z_bytes_wrap(&ztm->_addr_burst_buf[i * (size_t)_Z_LINK_ADDR_MAX_SIZE], _Z_LINK_ADDR_MAX_SIZE);
+    }
+
+    size_t n = _z_link_recv_zbuf_burst(ztm->_link, ztm->_zbuf_burst, ztm->_addr_burst, Z_RX_BURST_SIZE);
+    if (n == SIZE_MAX) {
+        n = 0;
+    }
+
+    _z_transport_message_result_t r;
+    for (size_t i = 0; (i < n) && (ztm->_read_task_running == true); i++) {
+        _z_zbuf_t *zbf = &ztm->_zbuf_burst[i];
+        while ((_z_zbuf_len(zbf) > (size_t)0) && (ztm->_read_task_running == true)) {
+            // Decode one session message
+            _z_transport_message_decode_ar(zbf, &ztm->_arena, &r);
+
+            if (r._tag == _Z_RES_OK) {
+                int8_t res = _z_multicast_handle_transport_message(ztm, &r._value, &ztm->_addr_burst[i]);
+                if (res == _Z_RES_OK) {
+                    _z_t_msg_clear_ar(&r._value, &ztm->_arena);
+                } else {
+                    ztm->_read_task_running = false;
+                }
+            } else {
+                _Z_ERROR("Connection closed due to malformed message\n");
+                ztm->_read_task_running = false;
+            }
+        }
+    }
+}
+#endif  // Z_MULTI_THREAD == 1
+
 void *_zp_multicast_read_task(void *ztm_arg) {
 #if Z_MULTI_THREAD == 1
     _z_transport_multicast_t *ztm = (_z_transport_multicast_t *)ztm_arg;
@@ -53,6 +90,18 @@ void *_zp_multicast_read_task(void *ztm_arg) {
 
     _z_bytes_t addr = _z_bytes_wrap(NULL, 0);
     while (ztm->_read_task_running == true) {
+#if defined(_Z_SYS_WAKER)
+        // Sleep until a datagram is received, or until the task is stopped
+        if (_z_link_wait_readable(ztm->_link, &ztm->_read_waker) == true) {
+            continue;
+        }
+#endif  // defined(_Z_SYS_WAKER)
+
+        if (ztm->_zbuf_burst != NULL) {
+            __z_multicast_read_burst(ztm);
+            continue;
+        }
+
         // Read bytes from socket to the main buffer
         size_t to_read = 0;
         if (_Z_LINK_IS_STREAMED(ztm->_link->_capabilities) == true) {
@@ -87,13 +136,13 @@ void *_zp_multicast_read_task(void *ztm_arg) {
 
         while (_z_zbuf_len(&zbuf) > 0) {
             // Decode one session message
-            _z_transport_message_decode_na(&zbuf, &r);
+            _z_transport_message_decode_ar(&zbuf, &ztm->_arena, &r);
 
             if (r._tag == _Z_RES_OK) {
                 int8_t res = _z_multicast_handle_transport_message(ztm, &r._value, &addr);
 
                 if (res == _Z_RES_OK) {
-                    _z_t_msg_clear(&r._value);
+                    _z_t_msg_clear_ar(&r._value, &ztm->_arena);
                     _z_bytes_clear(&addr);
                 } else {
                     ztm->_read_task_running = false;
@@ -117,4 +166,34 @@ void *_zp_multicast_read_task(void *ztm_arg) {
     return NULL;
 }
 
+#if Z_REACTOR == 1
+static _Bool __z_multicast_read_ready(void *ztm_arg) {
+    _z_transport_multicast_t *ztm = (_z_transport_multicast_t *)ztm_arg;
+
+    _z_mutex_lock(&ztm->_mutex_rx);
+    if (ztm->_read_task_running == true) {
+        __z_multicast_read_burst(ztm);
+    }
+    _z_mutex_unlock(&ztm->_mutex_rx);
+
+    return ztm->_read_task_running;
+}
+
+int8_t _zp_multicast_attach_read(_z_transport_multicast_t *ztm) {
+    int8_t ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+
+    // Each readiness event is served by a single burst receive, which never blocks once a datagram is available
+    const _z_sys_net_socket_t *sock = _z_link_get_rx_socket(ztm->_link);
+    if ((sock != NULL) && (ztm->_zbuf_burst != NULL)) {
+        ztm->_read_task_running = true;
+        ret = _z_reactor_attach_socket(sock, __z_multicast_read_ready, ztm, &ztm->_read_source);
+        if (ret != _Z_RES_OK) {
+            ztm->_read_task_running = false;
+        }
+    }
+
+    return ret;
+}
+#endif  // Z_REACTOR == 1
+
 #endif  // Z_MULTICAST_TRANSPORT == 1
@@ -70,10 +70,15 @@ int8_t _z_multicast_send_t_msg(_z_transport_multicast_t *ztm, const _z_transport
 }
 
 int8_t _z_multicast_send_z_msg(_z_session_t *zn, _z_zenoh_message_t *z_msg, z_reliability_t reliability,
-                               z_congestion_control_t cong_ctrl) {
+                               z_congestion_control_t cong_ctrl, z_priority_t priority, _Bool is_express) {
     int8_t ret = _Z_RES_OK;
     _Z_DEBUG(">> send zenoh message\n");
 
+    // QoS is not negotiated on multicast transports: all messages are sent on the default priority
+    (void)(priority);
+    // Zenoh messages are not batched on multicast transports: all messages are sent right away
+    (void)(is_express);
+
     _z_transport_multicast_t *ztm = &zn->_tp->_transport._multicast;
 
     // Acquire the lock and drop the message if needed
@@ -99,7 +104,7 @@ int8_t _z_multicast_send_z_msg(_z_session_t *zn, _z_zenoh_message_t *z_msg, z_re
 
         _z_zint_t sn = __unsafe_z_multicast_get_sn(ztm, reliability);  // Get the next sequence number
 
-        _z_transport_message_t t_msg = _z_frame_header(reliability, 0, 0, sn);
+        _z_transport_message_t t_msg = _z_frame_header(Z_PRIORITY_DEFAULT, reliability, 0, 0, sn);
         ret = _z_transport_message_encode(&ztm->_wbuf, &t_msg);  // Encode the frame header
         if (ret == _Z_RES_OK) {
             ret = _z_zenoh_message_encode(&ztm->_wbuf, z_msg);  // Encode the zenoh message
@@ -113,28 +118,45 @@ int8_t _z_multicast_send_z_msg(_z_session_t *zn, _z_zenoh_message_t *z_msg, z_re
                 }
             } else {
                 // The message does not fit in the current batch, let's fragment it
-                // Create an expandable wbuf for fragmentation
-                _z_wbuf_t fbf = _z_wbuf_make(Z_IOSLICE_SIZE, true);
+                // Encode the message on the fragmentation buffer, which only wraps the payload
+                _z_wbuf_t *fbf = &ztm->_fbuf;
+                _z_wbuf_reset(fbf);
+                ret = _z_zenoh_message_encode(fbf, z_msg);
 
-                ret = _z_zenoh_message_encode(&fbf, z_msg);  // Encode the message on the expandable wbuf
                 if (ret == _Z_RES_OK) {
                     _Bool is_first = true;  // Fragment and send the message
-                    while (_z_wbuf_len(&fbf) > 0) {
+                    size_t n_burst = 0;     // Number of fragments waiting to be sent in the current burst
+                    while ((_z_wbuf_len(fbf) > 0) && (ret == _Z_RES_OK)) {
                         if (is_first == false) {  // Get the fragment sequence number
                             sn = __unsafe_z_multicast_get_sn(ztm, reliability);
                         }
                         is_first = false;
 
+                        // Serialize fragments on the burst buffers, if any, to send them all at once
+                        _z_wbuf_t *wbf = &ztm->_wbuf;
+                        if (ztm->_wbuf_burst != NULL) {
+                            wbf = &ztm->_wbuf_burst[n_burst];
+                        }
+
                         // Clear the buffer for serialization
-                        __unsafe_z_prepare_wbuf(&ztm->_wbuf, _Z_LINK_IS_STREAMED(ztm->_link->_capabilities));
+                        __unsafe_z_prepare_wbuf(wbf, _Z_LINK_IS_STREAMED(ztm->_link->_capabilities));
 
                         // Serialize one fragment
-                        ret = __unsafe_z_serialize_zenoh_fragment(&ztm->_wbuf, &fbf, reliability, sn);
+                        ret = __unsafe_z_serialize_zenoh_fragment(wbf, fbf, Z_PRIORITY_DEFAULT, reliability, sn,
+                                                                  _z_link_is_scatter_gather(ztm->_link));
                         if (ret == _Z_RES_OK) {
                             // Write the message length in the reserved space if needed
-                            __unsafe_z_finalize_wbuf(&ztm->_wbuf, _Z_LINK_IS_STREAMED(ztm->_link->_capabilities));
-
-                            ret = _z_link_send_wbuf(ztm->_link, &ztm->_wbuf);  // Send the wbuf on the socket
+                            __unsafe_z_finalize_wbuf(wbf, _Z_LINK_IS_STREAMED(ztm->_link->_capabilities));
+
+                            if (ztm->_wbuf_burst != NULL) {
+                                n_burst = n_burst + (size_t)1;
+                                if ((n_burst == (size_t)Z_TX_BURST_SIZE) || (_z_wbuf_len(fbf) == (size_t)0)) {
+                                    ret = _z_link_send_wbuf_burst(ztm->_link, ztm->_wbuf_burst, n_burst);
+                                    n_burst = 0;
+                                }
+                            } else {
+                                ret = _z_link_send_wbuf(ztm->_link, wbf);  // Send the wbuf on the socket
+                            }
                             if (ret == _Z_RES_OK) {
                                 ztm->_transmitted = true;  // Mark the session that we have transmitted data
                             }
@@ -142,7 +164,13 @@ int8_t _z_multicast_send_z_msg(_z_session_t *zn, _z_zenoh_message_t *z_msg, z_re
                     }
                 }
 
-                _z_wbuf_clear(&fbf);  // Free the fragmentation buffer memory
+                // Drop any reference to the fragmentation buffer memory
+                _z_wbuf_reset(&ztm->_wbuf);
+                if (ztm->_wbuf_burst != NULL) {
+                    for (size_t i = 0; i < (size_t)Z_TX_BURST_SIZE; i++) {
+                        _z_wbuf_reset(&ztm->_wbuf_burst[i]);
+                    }
+                }
             }
         }
 
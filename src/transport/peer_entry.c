@@ -18,6 +18,10 @@
 void _z_transport_peer_entry_clear(_z_transport_peer_entry_t *src) {
     _z_wbuf_clear(&src->_dbuf_reliable);
     _z_wbuf_clear(&src->_dbuf_best_effort);
+#if Z_RX_REORDER_WINDOW > 0
+    _z_transport_reorder_clear(&src->_reorder_reliable);
+    _z_transport_reorder_clear(&src->_reorder_best_effort);
+#endif  // Z_RX_REORDER_WINDOW > 0
 
     _z_bytes_clear(&src->_remote_pid);
     _z_bytes_clear(&src->_remote_addr);
@@ -26,6 +30,12 @@ void _z_transport_peer_entry_clear(_z_transport_peer_entry_t *src) {
 void _z_transport_peer_entry_copy(_z_transport_peer_entry_t *dst, const _z_transport_peer_entry_t *src) {
     _z_wbuf_copy(&dst->_dbuf_reliable, &src->_dbuf_reliable);
     _z_wbuf_copy(&dst->_dbuf_best_effort, &src->_dbuf_best_effort);
+    dst->_dbuf_reliable_dropping = src->_dbuf_reliable_dropping;
+    dst->_dbuf_best_effort_dropping = src->_dbuf_best_effort_dropping;
+#if Z_RX_REORDER_WINDOW > 0
+    _z_transport_reorder_copy(&dst->_reorder_reliable, &src->_reorder_reliable);
+    _z_transport_reorder_copy(&dst->_reorder_best_effort, &src->_reorder_best_effort);
+#endif  // Z_RX_REORDER_WINDOW > 0
 
     dst->_sn_resolution = src->_sn_resolution;
     dst->_sn_resolution_half = src->_sn_resolution_half;
@@ -56,3 +66,183 @@ _Bool _z_transport_peer_entry_eq(const _z_transport_peer_entry_t *left, const _z
 
     return ret;
 }
+
+/*------------------ Peer table ------------------*/
+#define _Z_TRANSPORT_PEER_TABLE_MIN_CAPACITY 8
+
+// FNV-1a hash of the remote address of a peer
+static size_t __z_transport_peer_addr_hash(const _z_bytes_t *remote_addr) {
+    uint32_t h = 2166136261U;
+    for (size_t i = 0; i < remote_addr->len; i++) {
+        h = (h ^ remote_addr->start[i]) * 16777619U;
+    }
+    return (size_t)h;
+}
+
+// Puts an entry in the first free slot of its probing sequence, the table is expected to have one
+static void __z_transport_peer_table_place(_z_transport_peer_table_t *table, _z_transport_peer_entry_t *entry) {
+    size_t mask = table->_capacity - (size_t)1;
+    size_t i = __z_transport_peer_addr_hash(&entry->_remote_addr) & mask;
+    while (table->_slots[i] != NULL) {
+        i = (i + (size_t)1) & mask;
+    }
+    table->_slots[i] = entry;
+}
+
+static int8_t __z_transport_peer_table_resize(_z_transport_peer_table_t *table, size_t capacity) {
+    int8_t ret = _Z_RES_OK;
+
+    _z_transport_peer_entry_t **slots =
+        (_z_transport_peer_entry_t **)z_malloc(capacity * sizeof(_z_transport_peer_entry_t *));
+    if (slots != NULL) {
+        (void)memset(slots, 0, capacity * sizeof(_z_transport_peer_entry_t *));
+
+        _z_transport_peer_entry_t **old_slots = table->_slots;
+        size_t old_capacity = table->_capacity;
+        table->_slots = slots;
+        table->_capacity = capacity;
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (old_slots[i] != NULL) {
+                __z_transport_peer_table_place(table, old_slots[i]);
+            }
+        }
+        z_free(old_slots);
+    } else {
+        ret = _Z_ERR_GENERIC;
+    }
+
+    return ret;
+}
+
+// Returns the slot of an entry, or the capacity of the table if it is not found
+static size_t __z_transport_peer_table_find(const _z_transport_peer_table_t *table, const _z_bytes_t *remote_addr) {
+    size_t ret = table->_capacity;
+
+    if (table->_len > (size_t)0) {
+        size_t mask = table->_capacity - (size_t)1;
+        size_t i = __z_transport_peer_addr_hash(remote_addr) & mask;
+        while (table->_slots[i] != NULL) {
+            if (_z_bytes_eq(&table->_slots[i]->_remote_addr, remote_addr) == true) {
+                ret = i;
+                break;
+            }
+            i = (i + (size_t)1) & mask;
+        }
+    }
+
+    return ret;
+}
+
+_z_transport_peer_table_t _z_transport_peer_table_make(void) {
+    _z_transport_peer_table_t table;
+    table._slots = NULL;
+    table._capacity = 0;
+    table._len = 0;
+    return table;
+}
+
+size_t _z_transport_peer_table_len(const _z_transport_peer_table_t *table) { return table->_len; }
+
+_z_transport_peer_entry_t *_z_transport_peer_table_get(const _z_transport_peer_table_t *table,
+                                                       const _z_bytes_t *remote_addr) {
+    _z_transport_peer_entry_t *ret = NULL;
+
+    size_t i = __z_transport_peer_table_find(table, remote_addr);
+    if (i < table->_capacity) {
+        ret = table->_slots[i];
+    }
+
+    return ret;
+}
+
+int8_t _z_transport_peer_table_insert(_z_transport_peer_table_t *table, _z_transport_peer_entry_t *entry) {
+    int8_t ret = _Z_RES_OK;
+
+    // Keep the load factor under 3/4, so that probing sequences remain short
+    if (((table->_len + (size_t)1) * (size_t)4) > (table->_capacity * (size_t)3)) {
+        size_t capacity = (table->_capacity == (size_t)0) ? (size_t)_Z_TRANSPORT_PEER_TABLE_MIN_CAPACITY
+                                                          : (table->_capacity * (size_t)2);
+        ret = __z_transport_peer_table_resize(table, capacity);
+    }
+
+    if (ret == _Z_RES_OK) {
+        __z_transport_peer_table_place(table, entry);
+        table->_len = table->_len + (size_t)1;
+    }
+
+    return ret;
+}
+
+void _z_transport_peer_table_remove(_z_transport_peer_table_t *table, _z_transport_peer_entry_t *entry) {
+    size_t i = __z_transport_peer_table_find(table, &entry->_remote_addr);
+    if ((i < table->_capacity) && (table->_slots[i] == entry)) {
+        _z_transport_peer_entry_elem_free((void **)&table->_slots[i]);
+        table->_len = table->_len - (size_t)1;
+
+        // Shift back the following entries of the cluster that cannot be reached anymore through the freed slot
+        size_t mask = table->_capacity - (size_t)1;
+        size_t hole = i;
+        size_t j = (i + (size_t)1) & mask;
+        while (table->_slots[j] != NULL) {
+            size_t home = __z_transport_peer_addr_hash(&table->_slots[j]->_remote_addr) & mask;
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                table->_slots[hole] = table->_slots[j];
+                table->_slots[j] = NULL;
+                hole = j;
+            }
+            j = (j + (size_t)1) & mask;
+        }
+    }
+}
+
+void _z_transport_peer_table_retain(_z_transport_peer_table_t *table, _z_transport_peer_entry_keep_f keep) {
+    // Visit each entry exactly once and free those not to be kept, then reinsert the remaining ones so that
+    // no probing sequence goes through the freed slots
+    size_t removed = 0;
+    for (size_t i = 0; i < table->_capacity; i++) {
+        if ((table->_slots[i] != NULL) && (keep(table->_slots[i]) == false)) {
+            _z_transport_peer_entry_elem_free((void **)&table->_slots[i]);
+            removed = removed + (size_t)1;
+        }
+    }
+
+    if (removed > (size_t)0) {
+        table->_len = table->_len - removed;
+
+        // Start right after a free slot, so that every cluster is walked from its beginning
+        size_t mask = table->_capacity - (size_t)1;
+        size_t start = 0;
+        while (table->_slots[start] != NULL) {
+            start = start + (size_t)1;
+        }
+        for (size_t k = 1; k <= table->_capacity; k++) {
+            size_t j = (start + k) & mask;
+            _z_transport_peer_entry_t *entry = table->_slots[j];
+            if (entry != NULL) {
+                table->_slots[j] = NULL;
+                __z_transport_peer_table_place(table, entry);
+            }
+        }
+    }
+}
+
+_z_transport_peer_entry_t *_z_transport_peer_table_next(const _z_transport_peer_table_t *table, size_t *pos) {
+    _z_transport_peer_entry_t *ret = NULL;
+
+    while ((ret == NULL) && (*pos < table->_capacity)) {
+        ret = table->_slots[*pos];
+        *pos = *pos + (size_t)1;
+    }
+
+    return ret;
+}
+
+void _z_transport_peer_table_clear(_z_transport_peer_table_t *table) {
+    for (size_t i = 0; i < table->_capacity; i++) {
+        if (table->_slots[i] != NULL) {
+            _z_transport_peer_entry_elem_free((void **)&table->_slots[i]);
+        }
+    }
+    z_free(table->_slots);
+    *table = _z_transport_peer_table_make();
+}
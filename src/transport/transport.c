@@ -18,7 +18,9 @@
 #include <stdlib.h>
 
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/protocol/msgcodec.h"
 #include "zenoh-pico/transport/link/rx.h"
+#include "zenoh-pico/transport/link/task/write.h"
 #include "zenoh-pico/transport/link/tx.h"
 #include "zenoh-pico/transport/utils.h"
 #include "zenoh-pico/utils/logging.h"
@@ -31,6 +33,8 @@ int8_t _z_unicast_send_close(_z_transport_unicast_t *ztu, uint8_t reason, _Bool
                                    ((_z_session_t *)ztu->_session)->_tp_manager->_local_pid.len);
     _z_transport_message_t cm = _z_t_msg_make_close(reason, pid, link_only);
 
+    // Send the messages handed over to the write task first, nothing is sent after the CLOSE
+    _zp_unicast_stop_write_task(ztu);
     ret = _z_unicast_send_t_msg(ztu, &cm);
     _z_t_msg_clear(&cm);
 
@@ -74,6 +78,14 @@ int8_t _z_send_close(_z_transport_t *zt, uint8_t reason, _Bool link_only) {
 }
 
 #if Z_UNICAST_TRANSPORT == 1
+size_t _z_transport_unicast_conduits_num(const _z_transport_unicast_t *ztu) {
+    return (ztu->_is_qos == true) ? (size_t)_Z_TRANSPORT_CONDUITS_NUM : (size_t)1;
+}
+
+size_t _z_transport_unicast_conduit_idx(const _z_transport_unicast_t *ztu, z_priority_t priority) {
+    return (ztu->_is_qos == true) ? (size_t)priority : (size_t)0;
+}
+
 _z_transport_t *_z_transport_unicast_new(_z_link_t *link, _z_transport_unicast_establish_param_t param) {
     _z_transport_t *zt = (_z_transport_t *)z_malloc(sizeof(_z_transport_t));
     zt->_type = _Z_TRANSPORT_UNICAST_TYPE;
@@ -84,31 +96,53 @@ _z_transport_t *_z_transport_unicast_new(_z_link_t *link, _z_transport_unicast_e
     _z_mutex_init(&zt->_transport._unicast._mutex_rx);
 #endif  // Z_MULTI_THREAD == 1
 
-    // Initialize the read and write buffers
-    uint16_t mtu = (link->_mtu < Z_BATCH_SIZE_TX) ? link->_mtu : Z_BATCH_SIZE_TX;
-    zt->_transport._unicast._wbuf = _z_wbuf_make(mtu, false);
+    // Initialize the read buffer, the transport messages buffer and the decoding arena
     zt->_transport._unicast._zbuf = _z_zbuf_make(Z_BATCH_SIZE_RX);
-
-    // Initialize the defragmentation buffers
-#if Z_DYNAMIC_MEMORY_ALLOCATION == 1
-    zt->_transport._unicast._dbuf_reliable = _z_wbuf_make(0, true);
-    zt->_transport._unicast._dbuf_best_effort = _z_wbuf_make(0, true);
-#else
-    zt->_transport._unicast._dbuf_reliable = _z_wbuf_make(Z_FRAG_MAX_SIZE, false);
-    zt->_transport._unicast._dbuf_best_effort = _z_wbuf_make(Z_FRAG_MAX_SIZE, false);
-#endif
+    zt->_transport._unicast._wbuf_t_msg = _z_wbuf_make(_Z_TRANSPORT_UNICAST_T_MSG_SIZE, false);
+    zt->_transport._unicast._arena = _z_zenoh_message_arena_make(_ZENOH_PICO_FRAME_ARENA_SIZE);
 
     // Set default SN resolution
     zt->_transport._unicast._sn_resolution = param._sn_resolution;
     zt->_transport._unicast._sn_resolution_half = param._sn_resolution / 2;
 
-    // The initial SN at TX side
-    zt->_transport._unicast._sn_tx_reliable = param._initial_sn_tx;
-    zt->_transport._unicast._sn_tx_best_effort = param._initial_sn_tx;
-
-    // The initial SN at RX side
-    zt->_transport._unicast._sn_rx_reliable = param._initial_sn_rx;
-    zt->_transport._unicast._sn_rx_best_effort = param._initial_sn_rx;
+    // Initialize one conduit per priority if QoS has been negotiated, a single one otherwise
+    zt->_transport._unicast._is_qos = param._is_qos;
+    uint16_t mtu = (link->_mtu < Z_BATCH_SIZE_TX) ? link->_mtu : Z_BATCH_SIZE_TX;
+    for (size_t i = 0; i < _z_transport_unicast_conduits_num(&zt->_transport._unicast); i++) {
+        _z_transport_tx_conduit_t *ztc = &zt->_transport._unicast._tx_conduits[i];
+#if Z_MULTI_THREAD == 1
+        _z_mutex_init(&ztc->_mutex);
+#endif  // Z_MULTI_THREAD == 1
+        // The initial SN at TX side
+        ztc->_sn_reliable = param._initial_sn_tx;
+        ztc->_sn_best_effort = param._initial_sn_tx;
+        // Initialize the write buffers
+        ztc->_wbuf = _z_wbuf_make(mtu, false);
+        ztc->_fbuf = _z_wbuf_make(Z_IOSLICE_SIZE, true);
+#if Z_TX_BATCHING == 1
+        ztc->_batch_is_open = false;
+#endif  // Z_TX_BATCHING == 1
+
+        _z_transport_rx_conduit_t *zrc = &zt->_transport._unicast._rx_conduits[i];
+        // The initial SN at RX side
+        zrc->_sn_reliable = param._initial_sn_rx;
+        zrc->_sn_best_effort = param._initial_sn_rx;
+#if Z_DYNAMIC_MEMORY_ALLOCATION == 1
+        // Initialize the defragmentation buffers, grown on demand by the fragments
+        zrc->_dbuf_reliable = _z_wbuf_make(0, false);
+        zrc->_dbuf_best_effort = _z_wbuf_make(0, false);
+#else
+        // Initialize the defragmentation buffers for the largest message, so that they are never grown
+        zrc->_dbuf_reliable = _z_wbuf_make(Z_FRAG_MAX_SIZE, false);
+        zrc->_dbuf_best_effort = _z_wbuf_make(Z_FRAG_MAX_SIZE, false);
+#endif
+        zrc->_dbuf_reliable_dropping = false;
+        zrc->_dbuf_best_effort_dropping = false;
+#if Z_RX_REORDER_WINDOW > 0
+        _z_transport_reorder_init(&zrc->_reorder_reliable);
+        _z_transport_reorder_init(&zrc->_reorder_best_effort);
+#endif  // Z_RX_REORDER_WINDOW > 0
+    }
 
 #if Z_MULTI_THREAD == 1
     // Tasks
@@ -116,7 +150,34 @@ _z_transport_t *_z_transport_unicast_new(_z_link_t *link, _z_transport_unicast_e
     zt->_transport._unicast._read_task = NULL;
     zt->_transport._unicast._lease_task_running = false;
     zt->_transport._unicast._lease_task = NULL;
+#if defined(_Z_SYS_WAKER)
+    // Without wakers, the tasks are stopped on the timeouts of their reads and sleeps
+    (void)_z_waker_init(&zt->_transport._unicast._read_waker);
+    (void)_z_waker_init(&zt->_transport._unicast._lease_waker);
+#endif  // defined(_Z_SYS_WAKER)
+#if Z_TX_BATCHING == 1
+    zt->_transport._unicast._batch_pending = false;
+#if !defined(_Z_SYS_WAKER)
+    _z_mutex_init(&zt->_transport._unicast._lease_mutex);
+    _z_condvar_init(&zt->_transport._unicast._lease_cv);
+    zt->_transport._unicast._lease_signaled = false;
+#endif  // !defined(_Z_SYS_WAKER)
+#endif  // Z_TX_BATCHING == 1
 #endif  // Z_MULTI_THREAD == 1
+#if Z_REACTOR == 1
+    zt->_transport._unicast._read_source = _Z_REACTOR_SOURCE_NONE;
+    zt->_transport._unicast._lease_source = _Z_REACTOR_SOURCE_NONE;
+#endif  // Z_REACTOR == 1
+
+#if Z_TX_QUEUE == 1
+    // TX queue, only used once the write task is started
+    zt->_transport._unicast._tx_queue._slots = NULL;
+    zt->_transport._unicast._write_task_running = false;
+    zt->_transport._unicast._write_task = NULL;
+    atomic_init(&zt->_transport._unicast._tx_producers, 0);
+    atomic_init(&zt->_transport._unicast._tx_dropped, 0);
+    atomic_init(&zt->_transport._unicast._tx_timed_out, 0);
+#endif  // Z_TX_QUEUE == 1
 
     // Notifiers
     zt->_transport._unicast._received = 0;
@@ -151,6 +212,26 @@ _z_transport_t *_z_transport_multicast_new(_z_link_t *link, _z_transport_multica
     uint16_t mtu = (link->_mtu < Z_BATCH_SIZE_TX) ? link->_mtu : Z_BATCH_SIZE_TX;
     zt->_transport._multicast._wbuf = _z_wbuf_make(mtu, false);
     zt->_transport._multicast._zbuf = _z_zbuf_make(Z_BATCH_SIZE_RX);
+    zt->_transport._multicast._fbuf = _z_wbuf_make(Z_IOSLICE_SIZE, true);
+    zt->_transport._multicast._arena = _z_zenoh_message_arena_make(_ZENOH_PICO_FRAME_ARENA_SIZE);
+    zt->_transport._multicast._wbuf_burst = NULL;
+    if (_Z_LINK_IS_BURST(link->_capabilities) == true) {
+        zt->_transport._multicast._wbuf_burst = (_z_wbuf_t *)z_malloc(Z_TX_BURST_SIZE * sizeof(_z_wbuf_t));
+        for (size_t i = 0; i < (size_t)Z_TX_BURST_SIZE; i++) {
+            zt->_transport._multicast._wbuf_burst[i] = _z_wbuf_make(mtu, false);
+        }
+    }
+    zt->_transport._multicast._zbuf_burst = NULL;
+    zt->_transport._multicast._addr_burst = NULL;
+    zt->_transport._multicast._addr_burst_buf = NULL;
+    if (link->_read_burst_f != NULL) {
+        zt->_transport._multicast._zbuf_burst = (_z_zbuf_t *)z_malloc(Z_RX_BURST_SIZE * sizeof(_z_zbuf_t));
+        zt->_transport._multicast._addr_burst = (_z_bytes_t *)z_malloc(Z_RX_BURST_SIZE * sizeof(_z_bytes_t));
+        zt->_transport._multicast._addr_burst_buf = (uint8_t *)z_malloc(Z_RX_BURST_SIZE * _Z_LINK_ADDR_MAX_SIZE);
+        for (size_t i = 0; i < (size_t)Z_RX_BURST_SIZE; i++) {
+            zt->_transport._multicast._zbuf_burst[i] = _z_zbuf_make(link->_mtu);
+        }
+    }
 
     // Set default SN resolution
     zt->_transport._multicast._sn_resolution = param._sn_resolution;
@@ -160,7 +241,7 @@ _z_transport_t *_z_transport_multicast_new(_z_link_t *link, _z_transport_multica
     zt->_transport._multicast._sn_tx_best_effort = param._initial_sn_tx;
 
     // Initialize peer list
-    zt->_transport._multicast._peers = _z_transport_peer_entry_list_new();
+    zt->_transport._multicast._peers = _z_transport_peer_table_make();
 
 #if Z_MULTI_THREAD == 1
     // Tasks
@@ -168,7 +249,16 @@ _z_transport_t *_z_transport_multicast_new(_z_link_t *link, _z_transport_multica
     zt->_transport._multicast._read_task = NULL;
     zt->_transport._multicast._lease_task_running = false;
     zt->_transport._multicast._lease_task = NULL;
+#if defined(_Z_SYS_WAKER)
+    // Without wakers, the tasks are stopped on the timeouts of their reads and sleeps
+    (void)_z_waker_init(&zt->_transport._multicast._read_waker);
+    (void)_z_waker_init(&zt->_transport._multicast._lease_waker);
+#endif  // defined(_Z_SYS_WAKER)
 #endif  // Z_MULTI_THREAD == 1
+#if Z_REACTOR == 1
+    zt->_transport._multicast._read_source = _Z_REACTOR_SOURCE_NONE;
+    zt->_transport._multicast._lease_source = _Z_REACTOR_SOURCE_NONE;
+#endif  // Z_REACTOR == 1
 
     zt->_transport._multicast._lease = Z_TRANSPORT_LEASE;
 
@@ -192,11 +282,12 @@ _z_transport_unicast_establish_param_result_t _z_transport_unicast_open_client(c
     uint8_t version = Z_PROTO_VERSION;
     z_whatami_t whatami = Z_WHATAMI_CLIENT;
     _z_zint_t sn_resolution = Z_SN_RESOLUTION;
-    _Bool is_qos = false;
+    _Bool is_qos = Z_TRANSPORT_QOS == 1;
 
     _z_bytes_t pid = _z_bytes_wrap(local_pid.start, local_pid.len);
     _z_transport_message_t ism = _z_t_msg_make_init_syn(version, whatami, sn_resolution, pid, is_qos);
     param._sn_resolution = ism._body._init._sn_resolution;  // The announced sn resolution
+    param._is_qos = is_qos;                                  // The announced QoS support
 
     // Encode and send the message
     _Z_INFO("Sending Z_INIT(Syn)\n");
@@ -221,6 +312,11 @@ _z_transport_unicast_establish_param_result_t _z_transport_unicast_open_client(c
                         }
                     }
 
+                    // QoS is only enabled if both the InitSyn and the InitAck have announced it
+                    if (_Z_HAS_FLAG(iam._body._init._options, _Z_OPT_INIT_QOS) == false) {
+                        param._is_qos = false;
+                    }
+
                     if (err == _Z_RES_OK) {
                         // The initial SN at TX side
                         z_random_fill(&param._initial_sn_tx, sizeof(param._initial_sn_tx));
@@ -357,6 +453,10 @@ int8_t _z_transport_close(_z_transport_t *zt, uint8_t reason) { return _z_send_c
 void _z_transport_unicast_clear(_z_transport_unicast_t *ztu) {
 #if Z_MULTI_THREAD == 1
     // Clean up tasks
+#if Z_REACTOR == 1
+    _z_reactor_detach(&ztu->_read_source);
+    _z_reactor_detach(&ztu->_lease_source);
+#endif  // Z_REACTOR == 1
     if (ztu->_read_task != NULL) {
         _z_task_join(ztu->_read_task);
         _z_task_free(&ztu->_read_task);
@@ -365,17 +465,43 @@ void _z_transport_unicast_clear(_z_transport_unicast_t *ztu) {
         _z_task_join(ztu->_lease_task);
         _z_task_free(&ztu->_lease_task);
     }
+#if defined(_Z_SYS_WAKER)
+    _z_waker_free(&ztu->_read_waker);
+    _z_waker_free(&ztu->_lease_waker);
+#endif  // defined(_Z_SYS_WAKER)
+#if (Z_TX_BATCHING == 1) && !defined(_Z_SYS_WAKER)
+    _z_condvar_free(&ztu->_lease_cv);
+    _z_mutex_free(&ztu->_lease_mutex);
+#endif  // (Z_TX_BATCHING == 1) && !defined(_Z_SYS_WAKER)
+#if Z_TX_QUEUE == 1
+    _zp_unicast_stop_write_task(ztu);
+    _z_tx_queue_clear(&ztu->_tx_queue);
+#endif  // Z_TX_QUEUE == 1
 
     // Clean up the mutexes
     _z_mutex_free(&ztu->_mutex_tx);
     _z_mutex_free(&ztu->_mutex_rx);
 #endif  // Z_MULTI_THREAD == 1
 
+    // Clean up the conduits
+    for (size_t i = 0; i < _z_transport_unicast_conduits_num(ztu); i++) {
+#if Z_MULTI_THREAD == 1
+        _z_mutex_free(&ztu->_tx_conduits[i]._mutex);
+#endif  // Z_MULTI_THREAD == 1
+        _z_wbuf_clear(&ztu->_tx_conduits[i]._wbuf);
+        _z_wbuf_clear(&ztu->_tx_conduits[i]._fbuf);
+        _z_wbuf_clear(&ztu->_rx_conduits[i]._dbuf_reliable);
+        _z_wbuf_clear(&ztu->_rx_conduits[i]._dbuf_best_effort);
+#if Z_RX_REORDER_WINDOW > 0
+        _z_transport_reorder_clear(&ztu->_rx_conduits[i]._reorder_reliable);
+        _z_transport_reorder_clear(&ztu->_rx_conduits[i]._reorder_best_effort);
+#endif  // Z_RX_REORDER_WINDOW > 0
+    }
+
     // Clean up the buffers
-    _z_wbuf_clear(&ztu->_wbuf);
     _z_zbuf_clear(&ztu->_zbuf);
-    _z_wbuf_clear(&ztu->_dbuf_reliable);
-    _z_wbuf_clear(&ztu->_dbuf_best_effort);
+    _z_wbuf_clear(&ztu->_wbuf_t_msg);
+    _z_zenoh_message_arena_clear(&ztu->_arena);
 
     // Clean up PIDs
     _z_bytes_clear(&ztu->_remote_pid);
@@ -390,6 +516,10 @@ void _z_transport_unicast_clear(_z_transport_unicast_t *ztu) {
 void _z_transport_multicast_clear(_z_transport_multicast_t *ztm) {
 #if Z_MULTI_THREAD == 1
     // Clean up tasks
+#if Z_REACTOR == 1
+    _z_reactor_detach(&ztm->_read_source);
+    _z_reactor_detach(&ztm->_lease_source);
+#endif  // Z_REACTOR == 1
     if (ztm->_read_task != NULL) {
         _z_task_join(ztm->_read_task);
         _z_task_free(&ztm->_read_task);
@@ -398,6 +528,10 @@ void _z_transport_multicast_clear(_z_transport_multicast_t *ztm) {
         _z_task_join(ztm->_lease_task);
         _z_task_free(&ztm->_lease_task);
     }
+#if defined(_Z_SYS_WAKER)
+    _z_waker_free(&ztm->_read_waker);
+    _z_waker_free(&ztm->_lease_waker);
+#endif  // defined(_Z_SYS_WAKER)
 
     // Clean up the mutexes
     _z_mutex_free(&ztm->_mutex_tx);
@@ -408,9 +542,29 @@ void _z_transport_multicast_clear(_z_transport_multicast_t *ztm) {
     // Clean up the buffers
     _z_wbuf_clear(&ztm->_wbuf);
     _z_zbuf_clear(&ztm->_zbuf);
+    _z_wbuf_clear(&ztm->_fbuf);
+    _z_zenoh_message_arena_clear(&ztm->_arena);
+    if (ztm->_wbuf_burst != NULL) {
+        for (size_t i = 0; i < (size_t)Z_TX_BURST_SIZE; i++) {
+            _z_wbuf_clear(&ztm->_wbuf_burst[i]);
+        }
+        z_free(ztm->_wbuf_burst);
+        ztm->_wbuf_burst = NULL;
+    }
+    if (ztm->_zbuf_burst != NULL) {
+        for (size_t i = 0; i < (size_t)Z_RX_BURST_SIZE; i++) {
+            _z_zbuf_clear(&ztm->_zbuf_burst[i]);
+        }
+        z_free(ztm->_zbuf_burst);
+        ztm->_zbuf_burst = NULL;
+        z_free(ztm->_addr_burst);
+        ztm->_addr_burst = NULL;
+        z_free(ztm->_addr_burst_buf);
+        ztm->_addr_burst_buf = NULL;
+    }
 
     // Clean up peer list
-    _z_transport_peer_entry_list_free(&ztm->_peers);
+    _z_transport_peer_table_clear(&ztm->_peers);
 
     if (ztm->_link != NULL) {
         _z_link_free((_z_link_t **)&ztm->_link);
@@ -64,7 +64,7 @@ void _z_unicast_recv_t_msg_na(_z_transport_unicast_t *ztu, _z_transport_message_
 
     // Mark the session that we have received data
     if (r->_tag == _Z_RES_OK) {
-        _z_transport_message_decode_na(&ztu->_zbuf, r);
+        _z_transport_message_decode_ar(&ztu->_zbuf, &ztu->_arena, r);
         if (r->_tag == _Z_RES_OK) {
             ztu->_received = true;
         }
@@ -84,6 +84,23 @@ _z_transport_message_result_t _z_unicast_recv_t_msg(_z_transport_unicast_t *ztu)
     return r;
 }
 
+// Returns the reception state of the frames sent on the conduit with the given reliability
+static _z_transport_rx_channel_t __z_unicast_rx_channel(_z_transport_unicast_t *ztu, _z_transport_rx_conduit_t *zrc,
+                                                        _Bool is_reliable) {
+    _z_transport_rx_channel_t ch;
+    ch._session = ztu->_session;
+    ch._arena = &ztu->_arena;
+    ch._sn_resolution = ztu->_sn_resolution;
+    ch._sn_resolution_half = ztu->_sn_resolution_half;
+    ch._sn = (is_reliable == true) ? &zrc->_sn_reliable : &zrc->_sn_best_effort;
+    ch._dbuf = (is_reliable == true) ? &zrc->_dbuf_reliable : &zrc->_dbuf_best_effort;
+    ch._dbuf_dropping = (is_reliable == true) ? &zrc->_dbuf_reliable_dropping : &zrc->_dbuf_best_effort_dropping;
+#if Z_RX_REORDER_WINDOW > 0
+    ch._reorder = (is_reliable == true) ? &zrc->_reorder_reliable : &zrc->_reorder_best_effort;
+#endif  // Z_RX_REORDER_WINDOW > 0
+    return ch;
+}
+
 int8_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_transport_message_t *t_msg) {
     switch (_Z_MID(t_msg->_header)) {
         case _Z_MID_SCOUT: {
@@ -123,6 +140,15 @@ int8_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_trans
 
         case _Z_MID_KEEP_ALIVE: {
             _Z_INFO("Received Z_KEEP_ALIVE message\n");
+#if Z_RX_REORDER_WINDOW > 0
+            // Handle the frames held back for too long, in case no frame has been received since
+            for (size_t i = 0; i < _z_transport_unicast_conduits_num(ztu); i++) {
+                _z_transport_rx_channel_t ch = __z_unicast_rx_channel(ztu, &ztu->_rx_conduits[i], true);
+                _z_transport_rx_channel_expire(&ch);
+                ch = __z_unicast_rx_channel(ztu, &ztu->_rx_conduits[i], false);
+                _z_transport_rx_channel_expire(&ch);
+            }
+#endif  // Z_RX_REORDER_WINDOW > 0
             break;
         }
 
@@ -133,83 +159,17 @@ int8_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_trans
 
         case _Z_MID_FRAME: {
             _Z_INFO("Received Z_FRAME message\n");
-            // Check if the SN is correct
-            if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_R) == true) {
-                // @TODO: amend once reliability is in place. For the time being only
-                //        monothonic SNs are ensured
-                if (_z_sn_precedes(ztu->_sn_resolution_half, ztu->_sn_rx_reliable, t_msg->_body._frame._sn) == true) {
-                    ztu->_sn_rx_reliable = t_msg->_body._frame._sn;
-                } else {
-                    _z_wbuf_clear(&ztu->_dbuf_reliable);
-                    _Z_INFO("Reliable message dropped because it is out of order\n");
-                    break;
-                }
-            } else {
-                if (_z_sn_precedes(ztu->_sn_resolution_half, ztu->_sn_rx_best_effort, t_msg->_body._frame._sn) ==
-                    true) {
-                    ztu->_sn_rx_best_effort = t_msg->_body._frame._sn;
-                } else {
-                    _z_wbuf_clear(&ztu->_dbuf_best_effort);
-                    _Z_INFO("Best effort message dropped because it is out of order\n");
-                    break;
-                }
-            }
-
-            if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_F) == true) {
-                // Select the right defragmentation buffer
-                _z_wbuf_t *dbuf =
-                    _Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_R) ? &ztu->_dbuf_reliable : &ztu->_dbuf_best_effort;
-
-                _Bool drop = false;
-                if ((_z_wbuf_len(dbuf) + t_msg->_body._frame._payload._fragment.len) > Z_FRAG_MAX_SIZE) {
-                    // Filling the wbuf capacity as a way to signling the last fragment to reset the dbuf
-                    // Otherwise, last (smaller) fragments can be understood as a complete message
-                    _z_wbuf_write_bytes(dbuf, t_msg->_body._frame._payload._fragment.start, 0,
-                                        _z_wbuf_space_left(dbuf));
-                    drop = true;
-                } else {
-                    // Add the fragment to the defragmentation buffer
-                    _z_wbuf_write_bytes(dbuf, t_msg->_body._frame._payload._fragment.start, 0,
-                                        t_msg->_body._frame._payload._fragment.len);
-                }
-
-                // Check if this is the last fragment
-                if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_E) == true) {
-                    // Drop message if it is bigger the max buffer size
-                    if (drop == true) {
-                        _z_wbuf_reset(dbuf);
-                        break;
-                    }
-
-                    // Convert the defragmentation buffer into a decoding buffer
-                    _z_zbuf_t zbf = _z_wbuf_to_zbuf(dbuf);
-
-                    // Decode the zenoh message
-                    _z_zenoh_message_result_t r_zm = _z_zenoh_message_decode(&zbf);
-                    if (r_zm._tag == _Z_RES_OK) {
-                        _z_zenoh_message_t d_zm = r_zm._value;
-                        _z_handle_zenoh_message(ztu->_session, &d_zm);
-
-                        // Clear must be explicitly called for fragmented zenoh messages.
-                        // Non-fragmented zenoh messages are released when their transport message is released.
-                        _z_msg_clear(&d_zm);
-                    }
-
-                    // Free the decoding buffer
-                    _z_zbuf_clear(&zbf);
-                    // Reset the defragmentation buffer
-                    _z_wbuf_reset(dbuf);
-                }
-
-                break;
-            } else {
-                // Handle all the zenoh message, one by one
-                size_t len = _z_vec_len(&t_msg->_body._frame._payload._messages);
-                for (size_t i = 0; i < len; i++) {
-                    _z_handle_zenoh_message(
-                        ztu->_session, (_z_zenoh_message_t *)_z_vec_get(&t_msg->_body._frame._payload._messages, i));
-                }
-            }
+            // Select the conduit the frame has been sent on
+            _z_transport_rx_conduit_t *zrc =
+                &ztu->_rx_conduits[_z_transport_unicast_conduit_idx(ztu, t_msg->_body._frame._priority)];
+
+            _z_transport_rx_channel_t ch =
+                __z_unicast_rx_channel(ztu, zrc, _Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_R));
+            _z_transport_rx_channel_handle_frame(&ch, t_msg->_header, &t_msg->_body._frame);
+#if Z_RX_REORDER_WINDOW > 0
+            // Only once the frame has been handled, as the frames held back are decoded on the same arena
+            _z_transport_rx_channel_expire(&ch);
+#endif  // Z_RX_REORDER_WINDOW > 0
             break;
         }
 
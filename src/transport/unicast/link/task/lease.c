@@ -32,6 +32,105 @@ int8_t _zp_unicast_send_keep_alive(_z_transport_unicast_t *ztu) {
     return ret;
 }
 
+#if Z_MULTI_THREAD == 1
+#if Z_TX_BATCHING == 1
+void _zp_unicast_wake_lease(_z_transport_unicast_t *ztu) {
+    _Bool is_woken = false;
+#if Z_REACTOR == 1
+    if (ztu->_lease_source != _Z_REACTOR_SOURCE_NONE) {
+        _z_reactor_fire_timer(&ztu->_lease_source);
+        is_woken = true;
+    }
+#endif  // Z_REACTOR == 1
+
+    if (is_woken == false) {
+#if defined(_Z_SYS_WAKER)
+        _z_waker_signal(&ztu->_lease_waker);
+#else
+        _z_mutex_lock(&ztu->_lease_mutex);
+        ztu->_lease_signaled = true;
+        _z_condvar_signal(&ztu->_lease_cv);
+        _z_mutex_unlock(&ztu->_lease_mutex);
+#endif  // defined(_Z_SYS_WAKER)
+    }
+}
+#endif  // Z_TX_BATCHING == 1
+
+// Accounts for the elapsed time since the last step, runs the lease and keep alive checks that are due, and returns
+// the interval in milliseconds until the next step. The lease task stops once the transport has expired.
+// The step may run before the end of the previous interval, when woken up to be stopped or to send a batch.
+static _z_zint_t __z_unicast_lease_step(_z_transport_unicast_t *ztu, z_clock_t *last_step, _z_zint_t interval,
+                                        _z_zint_t *next_lease, _z_zint_t *next_keep_alive) {
+    _z_zint_t elapsed = (_z_zint_t)z_clock_elapsed_ms(last_step);
+    if (elapsed > interval) {
+        elapsed = interval;  // Also covers the platforms without a clock
+    }
+    *last_step = z_clock_now();
+    *next_lease = *next_lease - elapsed;
+    *next_keep_alive = *next_keep_alive - elapsed;
+
+    if (*next_lease == 0) {
+        // Check if received data
+        if (ztu->_received == true) {
+            // Reset the lease parameters
+            ztu->_received = false;
+        } else {
+            _Z_INFO("Closing session because it has expired after %zums\n", ztu->_lease);
+            ztu->_lease_task_running = false;
+            _z_transport_unicast_close(ztu, _Z_CLOSE_EXPIRED);
+        }
+
+        *next_lease = ztu->_lease;
+    }
+
+    if ((ztu->_lease_task_running == true) && (*next_keep_alive <= 0)) {
+        // Check if need to send a keep alive
+        if (ztu->_transmitted == false) {
+            if (_zp_unicast_send_keep_alive(ztu) < 0) {
+                // TODO: Handle retransmission or error
+            }
+        }
+
+        // Reset the keep alive parameters
+        ztu->_transmitted = false;
+        *next_keep_alive = ztu->_lease / Z_TRANSPORT_LEASE_EXPIRE_FACTOR;
+    }
+
+    // Compute the target interval
+    if (*next_lease == 0) {
+        interval = *next_keep_alive;
+    } else {
+        interval = *next_lease;
+        if (*next_keep_alive < interval) {
+            interval = *next_keep_alive;
+        }
+    }
+
+#if Z_TX_BATCHING == 1
+    // Send the batches left open by the last writes once they are due, and only wake up for their deadline while some
+    // remain open. The writer opening the next batch wakes the task up.
+    if (ztu->_lease_task_running == true) {
+        _z_mutex_lock(&ztu->_mutex_tx);
+        _Bool is_pending = ztu->_batch_pending;
+        ztu->_batch_pending = false;  // A batch opened from now on is either seen open below or signaled again
+        _z_mutex_unlock(&ztu->_mutex_tx);
+
+        if (is_pending == true) {
+            _Bool is_open = false;
+            (void)_z_unicast_flush_expired(ztu, &interval, &is_open);
+            if (is_open == true) {
+                _z_mutex_lock(&ztu->_mutex_tx);
+                ztu->_batch_pending = true;
+                _z_mutex_unlock(&ztu->_mutex_tx);
+            }
+        }
+    }
+#endif  // Z_TX_BATCHING == 1
+
+    return interval;
+}
+#endif  // Z_MULTI_THREAD == 1
+
 void *_zp_unicast_lease_task(void *ztu_arg) {
 #if Z_MULTI_THREAD == 1
     _z_transport_unicast_t *ztu = (_z_transport_unicast_t *)ztu_arg;
@@ -40,57 +139,66 @@ void *_zp_unicast_lease_task(void *ztu_arg) {
     ztu->_received = false;
     ztu->_transmitted = false;
 
+    z_clock_t last_step = z_clock_now();
     _z_zint_t next_lease = ztu->_lease;
     _z_zint_t next_keep_alive = ztu->_lease / Z_TRANSPORT_LEASE_EXPIRE_FACTOR;
+    _z_zint_t interval = 0;
     while (ztu->_lease_task_running == true) {
-        if (next_lease == 0) {
-            // Check if received data
-            if (ztu->_received == true) {
-                // Reset the lease parameters
-                ztu->_received = false;
-            } else {
-                _Z_INFO("Closing session because it has expired after %zums\n", ztu->_lease);
-                ztu->_lease_task_running = false;
-                _z_transport_unicast_close(ztu, _Z_CLOSE_EXPIRED);
-                break;
+        interval = __z_unicast_lease_step(ztu, &last_step, interval, &next_lease, &next_keep_alive);
+        if (ztu->_lease_task_running == true) {
+            // The keep alive and lease intervals are expressed in milliseconds
+#if defined(_Z_SYS_WAKER)
+            (void)_z_waker_sleep_ms(&ztu->_lease_waker, (unsigned int)interval);
+#elif Z_TX_BATCHING == 1
+            _z_mutex_lock(&ztu->_lease_mutex);
+            if (ztu->_lease_signaled == false) {
+                (void)_z_condvar_timedwait(&ztu->_lease_cv, &ztu->_lease_mutex, (unsigned int)interval);
             }
-
-            next_lease = ztu->_lease;
+            ztu->_lease_signaled = false;
+            _z_mutex_unlock(&ztu->_lease_mutex);
+#else
+            z_sleep_ms(interval);
+#endif  // defined(_Z_SYS_WAKER)
         }
+    }
+#endif  // Z_MULTI_THREAD == 1
 
-        if (next_keep_alive <= 0) {
-            // Check if need to send a keep alive
-            if (ztu->_transmitted == false) {
-                if (_zp_unicast_send_keep_alive(ztu) < 0) {
-                    // TODO: Handle retransmission or error
-                }
-            }
+    return 0;
+}
 
-            // Reset the keep alive parameters
-            ztu->_transmitted = false;
-            next_keep_alive = ztu->_lease / Z_TRANSPORT_LEASE_EXPIRE_FACTOR;
-        }
+#if Z_REACTOR == 1
+static uint32_t __z_unicast_lease_expired(void *ztu_arg) {
+    _z_transport_unicast_t *ztu = (_z_transport_unicast_t *)ztu_arg;
 
-        // Compute the target interval
-        _z_zint_t interval;
-        if (next_lease == 0) {
-            interval = next_keep_alive;
-        } else {
-            interval = next_lease;
-            if (next_keep_alive < interval) {
-                interval = next_keep_alive;
-            }
+    uint32_t ret = _Z_REACTOR_TIMER_STOP;
+    if (ztu->_lease_task_running == true) {
+        ztu->_lease_interval = __z_unicast_lease_step(ztu, &ztu->_lease_step, ztu->_lease_interval, &ztu->_next_lease,
+                                                      &ztu->_next_keep_alive);
+        if (ztu->_lease_task_running == true) {
+            ret = (uint32_t)ztu->_lease_interval;
         }
+    }
 
-        // The keep alive and lease intervals are expressed in milliseconds
-        z_sleep_ms(interval);
+    return ret;
+}
 
-        next_lease = next_lease - interval;
-        next_keep_alive = next_keep_alive - interval;
+int8_t _zp_unicast_attach_lease(_z_transport_unicast_t *ztu) {
+    ztu->_lease_task_running = true;
+    ztu->_received = false;
+    ztu->_transmitted = false;
+
+    // The first step runs right away, as the lease task does
+    ztu->_lease_interval = 0;
+    ztu->_lease_step = z_clock_now();
+    ztu->_next_lease = ztu->_lease;
+    ztu->_next_keep_alive = ztu->_lease / Z_TRANSPORT_LEASE_EXPIRE_FACTOR;
+    int8_t ret = _z_reactor_attach_timer(0, __z_unicast_lease_expired, ztu, &ztu->_lease_source);
+    if (ret != _Z_RES_OK) {
+        ztu->_lease_task_running = false;
     }
-#endif  // Z_MULTI_THREAD == 1
 
-    return 0;
+    return ret;
 }
+#endif  // Z_REACTOR == 1
 
 #endif  // Z_UNICAST_TRANSPORT == 1
@@ -28,7 +28,7 @@ int8_t _zp_unicast_read(_z_transport_unicast_t *ztu) {
     _z_transport_message_result_t r_s = _z_unicast_recv_t_msg(ztu);
     if (r_s._tag == _Z_RES_OK) {
         ret = _z_unicast_handle_transport_message(ztu, &r_s._value);
-        _z_t_msg_clear(&r_s._value);
+        _z_t_msg_clear_ar(&r_s._value, &ztu->_arena);
     } else {
         ret = r_s._tag;
     }
@@ -36,46 +36,63 @@ int8_t _zp_unicast_read(_z_transport_unicast_t *ztu) {
     return ret;
 }
 
-void *_zp_unicast_read_task(void *ztu_arg) {
 #if Z_MULTI_THREAD == 1
-    _z_transport_unicast_t *ztu = (_z_transport_unicast_t *)ztu_arg;
-    ztu->_read_task_running = true;
-
-    _z_transport_message_result_t r;
-
-    // Acquire and keep the lock
-    _z_mutex_lock(&ztu->_mutex_rx);
+// Returns the size of the next message of a stream including its length, or the size of the length itself if it has
+// not been received yet
+static size_t __z_unicast_next_msg_size(const _z_zbuf_t *zbf) {
+    size_t size = _Z_MSG_LEN_ENC_SIZE;
+    if (_z_zbuf_len(zbf) >= _Z_MSG_LEN_ENC_SIZE) {
+        size_t r_pos = _z_zbuf_get_rpos(zbf);
+        for (uint8_t i = 0; i < _Z_MSG_LEN_ENC_SIZE; i++) {
+            size = size + ((size_t)_z_zbuf_get(zbf, r_pos + i) << (i * (uint8_t)8));
+        }
+    }
+    return size;
+}
+#endif  // Z_MULTI_THREAD == 1
 
-    // Prepare the buffer
-    _z_zbuf_reset(&ztu->_zbuf);
+#if Z_MULTI_THREAD == 1
+// Reads once from the link and handles all the complete messages received so far, the RX mutex being held.
+// Returns _Z_ERR_TRANSPORT_RX_FAILED if nothing could be read, or another error if the transport must not be read
+// anymore.
+static int8_t __z_unicast_read_once(_z_transport_unicast_t *ztu) {
+    int8_t ret = _Z_RES_OK;
 
-    while (ztu->_read_task_running == true) {
-        // Read bytes from socket to the main buffer
-        size_t to_read = 0;
-        if (_Z_LINK_IS_STREAMED(ztu->_link->_capabilities) == true) {
-            if (_z_zbuf_len(&ztu->_zbuf) < _Z_MSG_LEN_ENC_SIZE) {
-                _z_link_recv_zbuf(ztu->_link, &ztu->_zbuf, NULL);
-                if (_z_zbuf_len(&ztu->_zbuf) < _Z_MSG_LEN_ENC_SIZE) {
-                    continue;
-                }
-            }
+    _z_transport_message_result_t r;
+    _Bool is_streamed = _Z_LINK_IS_STREAMED(ztu->_link->_capabilities);
+
+    if (_z_zbuf_len(&ztu->_zbuf) == (size_t)0) {
+        // Nothing is pending, read from the start of the main buffer
+        _z_zbuf_reset(&ztu->_zbuf);
+    } else if (is_streamed == true) {
+        size_t size = __z_unicast_next_msg_size(&ztu->_zbuf);
+        if (size > _z_zbuf_capacity(&ztu->_zbuf)) {
+            _Z_ERROR("Connection closed due to a message larger than the read buffer\n");
+            ret = _Z_ERR_IOBUF_NO_SPACE;
+        } else if ((_z_zbuf_len(&ztu->_zbuf) + _z_zbuf_space_left(&ztu->_zbuf)) < size) {
+            // Move the pending bytes to the front of the main buffer only if the next message does not fit
+            _z_zbuf_compact(&ztu->_zbuf);
+        }
+    }
 
-            for (uint8_t i = 0; i < _Z_MSG_LEN_ENC_SIZE; i++) {
-                to_read |= _z_zbuf_read(&ztu->_zbuf) << (i * (uint8_t)8);
-            }
+    // Read bytes from socket to the main buffer
+    if (ret == _Z_RES_OK) {
+        size_t rb = _z_link_recv_zbuf(ztu->_link, &ztu->_zbuf, NULL);
+        if ((rb == SIZE_MAX) || (rb == (size_t)0)) {
+            ret = _Z_ERR_TRANSPORT_RX_FAILED;
+        }
+    }
 
-            if (_z_zbuf_len(&ztu->_zbuf) < to_read) {
-                _z_link_recv_zbuf(ztu->_link, &ztu->_zbuf, NULL);
-                if (_z_zbuf_len(&ztu->_zbuf) < to_read) {
-                    _z_zbuf_set_rpos(&ztu->_zbuf, _z_zbuf_get_rpos(&ztu->_zbuf) - _Z_MSG_LEN_ENC_SIZE);
-                    continue;
-                }
-            }
-        } else {
-            to_read = _z_link_recv_zbuf(ztu->_link, &ztu->_zbuf, NULL);
-            if (to_read == SIZE_MAX) {
-                continue;
+    // Decode and handle all the complete messages of the main buffer before reading from the socket again
+    while ((ret == _Z_RES_OK) && (ztu->_read_task_running == true) && (_z_zbuf_len(&ztu->_zbuf) > (size_t)0)) {
+        size_t to_read = _z_zbuf_len(&ztu->_zbuf);
+        if (is_streamed == true) {
+            size_t size = __z_unicast_next_msg_size(&ztu->_zbuf);
+            if (_z_zbuf_len(&ztu->_zbuf) < size) {
+                break;
             }
+            _z_zbuf_set_rpos(&ztu->_zbuf, _z_zbuf_get_rpos(&ztu->_zbuf) + _Z_MSG_LEN_ENC_SIZE);
+            to_read = size - _Z_MSG_LEN_ENC_SIZE;
         }
 
         // Wrap the main buffer for to_read bytes
@@ -85,25 +102,49 @@ void *_zp_unicast_read_task(void *ztu_arg) {
         ztu->_received = true;
 
         // Decode one session message
-        _z_transport_message_decode_na(&zbuf, &r);
+        _z_transport_message_decode_ar(&zbuf, &ztu->_arena, &r);
 
         if (r._tag == _Z_RES_OK) {
-            int8_t res = _z_unicast_handle_transport_message(ztu, &r._value);
-            if (res == _Z_RES_OK) {
-                _z_t_msg_clear(&r._value);
-            } else {
-                ztu->_read_task_running = false;
-                continue;
+            ret = _z_unicast_handle_transport_message(ztu, &r._value);
+            if (ret == _Z_RES_OK) {
+                _z_t_msg_clear_ar(&r._value, &ztu->_arena);
             }
         } else {
             _Z_ERROR("Connection closed due to malformed message\n\n\n");
-            ztu->_read_task_running = false;
-            continue;
+            ret = r._tag;
         }
 
         // Move the read position of the read buffer
         _z_zbuf_set_rpos(&ztu->_zbuf, _z_zbuf_get_rpos(&ztu->_zbuf) + to_read);
-        _z_zbuf_compact(&ztu->_zbuf);
+    }
+
+    return ret;
+}
+#endif  // Z_MULTI_THREAD == 1
+
+void *_zp_unicast_read_task(void *ztu_arg) {
+#if Z_MULTI_THREAD == 1
+    _z_transport_unicast_t *ztu = (_z_transport_unicast_t *)ztu_arg;
+    ztu->_read_task_running = true;
+
+    // Acquire and keep the lock
+    _z_mutex_lock(&ztu->_mutex_rx);
+
+    // Prepare the buffer
+    _z_zbuf_reset(&ztu->_zbuf);
+
+    while (ztu->_read_task_running == true) {
+#if defined(_Z_SYS_WAKER)
+        // Sleep until data is received, or until the task is stopped
+        if (_z_link_wait_readable(ztu->_link, &ztu->_read_waker) == true) {
+            continue;
+        }
+#endif  // defined(_Z_SYS_WAKER)
+
+        int8_t ret = __z_unicast_read_once(ztu);
+        if ((ret != _Z_RES_OK) && (ret != _Z_ERR_TRANSPORT_RX_FAILED)) {
+            ztu->_read_task_running = false;
+        }
     }
 
     _z_mutex_unlock(&ztu->_mutex_rx);
@@ -112,4 +153,35 @@ void *_zp_unicast_read_task(void *ztu_arg) {
     return NULL;
 }
 
+#if Z_REACTOR == 1
+static _Bool __z_unicast_read_ready(void *ztu_arg) {
+    _z_transport_unicast_t *ztu = (_z_transport_unicast_t *)ztu_arg;
+
+    _z_mutex_lock(&ztu->_mutex_rx);
+    if ((ztu->_read_task_running == true) && (__z_unicast_read_once(ztu) != _Z_RES_OK)) {
+        // The link has been closed, or cannot be read anymore
+        ztu->_read_task_running = false;
+    }
+    _z_mutex_unlock(&ztu->_mutex_rx);
+
+    return ztu->_read_task_running;
+}
+
+int8_t _zp_unicast_attach_read(_z_transport_unicast_t *ztu) {
+    int8_t ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+
+    const _z_sys_net_socket_t *sock = _z_link_get_rx_socket(ztu->_link);
+    if (sock != NULL) {
+        _z_zbuf_reset(&ztu->_zbuf);
+        ztu->_read_task_running = true;
+        ret = _z_reactor_attach_socket(sock, __z_unicast_read_ready, ztu, &ztu->_read_source);
+        if (ret != _Z_RES_OK) {
+            ztu->_read_task_running = false;
+        }
+    }
+
+    return ret;
+}
+#endif  // Z_REACTOR == 1
+
 #endif  // Z_UNICAST_TRANSPORT == 1
@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/transport/link/task/write.h"
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/transport/link/tx.h"
+#include "zenoh-pico/utils/logging.h"
+
+#if Z_UNICAST_TRANSPORT == 1
+
+void *_zp_unicast_write_task(void *ztu_arg) {
+#if Z_TX_QUEUE == 1
+    _z_transport_unicast_t *ztu = (_z_transport_unicast_t *)ztu_arg;
+
+    // The running flag is set when starting the task, so that no message can be enqueued without being sent
+    while (true) {
+        _z_tx_queue_slot_t *slot = _z_tx_queue_pop_begin(&ztu->_tx_queue);
+        if (slot != NULL) {
+            if (slot->_is_valid == true) {
+                _z_bytes_t bs = _z_tx_queue_slot_bytes(slot);
+                if (_z_unicast_send_encoded_z_msg(ztu, &bs, slot->_reliability, slot->_priority, slot->_is_express) !=
+                    _Z_RES_OK) {
+                    _Z_ERROR("Dropping zenoh message because of a transmission error\n");
+                }
+            }
+            _z_tx_queue_pop_end(&ztu->_tx_queue, slot);
+        } else {
+            // Nothing left to batch: send the open batches
+            if (_z_unicast_flush(ztu) != _Z_RES_OK) {
+                _Z_ERROR("Failed to flush the pending batches\n");
+            }
+
+            if (ztu->_write_task_running == true) {
+                _z_tx_queue_wait_not_empty(&ztu->_tx_queue, &ztu->_write_task_running);
+            } else {
+                // Once stopped, return when the producers that have seen the task running are done and their
+                // messages have been sent. A message being encoded is not seen in the queue until then.
+                atomic_thread_fence(memory_order_seq_cst);
+                if ((atomic_load_explicit(&ztu->_tx_producers, memory_order_acquire) == (size_t)0) &&
+                    (_z_tx_queue_is_empty(&ztu->_tx_queue) == true)) {
+                    break;
+                }
+                // Woken up by the last producer, the publishers blocked on a full queue having been woken up by
+                // _zp_unicast_stop_write_task
+                _z_tx_queue_wait_producers(&ztu->_tx_queue, &ztu->_tx_producers);
+            }
+        }
+    }
+#else
+    (void)(ztu_arg);
+#endif  // Z_TX_QUEUE == 1
+
+    return 0;
+}
+
+void _zp_unicast_stop_write_task(_z_transport_unicast_t *ztu) {
+#if Z_TX_QUEUE == 1
+    if (ztu->_write_task != NULL) {
+        ztu->_write_task_running = false;
+        _z_tx_queue_notify(&ztu->_tx_queue);  // Wake up the write task and the blocked publishers
+        _z_task_join(ztu->_write_task);
+        _z_task_free(&ztu->_write_task);
+    }
+#else
+    (void)(ztu);
+#endif  // Z_TX_QUEUE == 1
+}
+
+#endif  // Z_UNICAST_TRANSPORT == 1
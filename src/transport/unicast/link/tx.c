@@ -16,6 +16,7 @@
 
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/msgcodec.h"
+#include "zenoh-pico/transport/link/task/lease.h"
 #include "zenoh-pico/transport/utils.h"
 #include "zenoh-pico/utils/logging.h"
 
@@ -24,134 +25,501 @@
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
- *  - ztu->_mutex_inner
+ *  - ztc->_mutex
  */
-_z_zint_t __unsafe_z_unicast_get_sn(_z_transport_unicast_t *ztu, z_reliability_t reliability) {
+_z_zint_t __unsafe_z_unicast_get_sn(_z_transport_unicast_t *ztu, _z_transport_tx_conduit_t *ztc,
+                                    z_reliability_t reliability) {
     _z_zint_t sn;
     if (reliability == Z_RELIABILITY_RELIABLE) {
-        sn = ztu->_sn_tx_reliable;
-        ztu->_sn_tx_reliable = _z_sn_increment(ztu->_sn_resolution, ztu->_sn_tx_reliable);
+        sn = ztc->_sn_reliable;
+        ztc->_sn_reliable = _z_sn_increment(ztu->_sn_resolution, ztc->_sn_reliable);
     } else {
-        sn = ztu->_sn_tx_best_effort;
-        ztu->_sn_tx_best_effort = _z_sn_increment(ztu->_sn_resolution, ztu->_sn_tx_best_effort);
+        sn = ztc->_sn_best_effort;
+        ztc->_sn_best_effort = _z_sn_increment(ztu->_sn_resolution, ztc->_sn_best_effort);
     }
     return sn;
 }
 
-int8_t _z_unicast_send_t_msg(_z_transport_unicast_t *ztu, const _z_transport_message_t *t_msg) {
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - the mutex of the conduit owning wbf
+ * The link is only held, via ztu->_mutex_tx, for the time of the write.
+ */
+int8_t __unsafe_z_unicast_send_wbuf(_z_transport_unicast_t *ztu, _z_wbuf_t *wbf) {
     int8_t ret = _Z_RES_OK;
-    _Z_DEBUG(">> send session message\n");
+
+    // Write the message length in the reserved space if needed
+    __unsafe_z_finalize_wbuf(wbf, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
 
 #if Z_MULTI_THREAD == 1
-    // Acquire the lock
     _z_mutex_lock(&ztu->_mutex_tx);
 #endif  // Z_MULTI_THREAD == 1
 
+    ret = _z_link_send_wbuf(ztu->_link, wbf);  // Send the wbuf on the socket
+    if (ret == _Z_RES_OK) {
+        ztu->_transmitted = true;  // Mark the session that we have transmitted data
+    }
+
+#if Z_MULTI_THREAD == 1
+    _z_mutex_unlock(&ztu->_mutex_tx);
+#endif  // Z_MULTI_THREAD == 1
+
+    return ret;
+}
+
+/**
+ * Encodes a zenoh message, or copies it if it has already been encoded (i.e. z_msg is NULL).
+ */
+static int8_t __z_unicast_encode_z_msg(_z_wbuf_t *wbf, const _z_zenoh_message_t *z_msg, const _z_bytes_t *z_msg_bytes) {
+    int8_t ret = _Z_RES_OK;
+
+    if (z_msg != NULL) {
+        ret = _z_zenoh_message_encode(wbf, z_msg);
+    } else if ((wbf->_is_expandable == true) && (z_msg_bytes->len > Z_TSID_LENGTH)) {
+        ret = _z_wbuf_wrap_bytes(wbf, z_msg_bytes->start, 0, z_msg_bytes->len);
+    } else {
+        ret = _z_wbuf_write_bytes(wbf, z_msg_bytes->start, 0, z_msg_bytes->len);
+    }
+
+    return ret;
+}
+
+#if Z_TX_BATCHING == 1
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztc->_mutex
+ */
+int8_t __unsafe_z_unicast_flush(_z_transport_unicast_t *ztu, _z_transport_tx_conduit_t *ztc) {
+    int8_t ret = _Z_RES_OK;
+
+    if (ztc->_batch_is_open == true) {
+        ztc->_batch_is_open = false;
+        ret = __unsafe_z_unicast_send_wbuf(ztu, &ztc->_wbuf);
+    }
+
+    return ret;
+}
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztc->_mutex
+ */
+int8_t __unsafe_z_unicast_batch_z_msg(_z_transport_unicast_t *ztu, _z_transport_tx_conduit_t *ztc,
+                                      const _z_zenoh_message_t *z_msg, const _z_bytes_t *z_msg_bytes,
+                                      z_reliability_t reliability, _Bool *is_batched) {
+    int8_t ret = _Z_RES_OK;
+    *is_batched = false;
+
+    if (ztc->_batch_is_open == true) {
+        if (ztc->_batch_reliability == reliability) {
+            size_t w_pos = _z_wbuf_get_wpos(&ztc->_wbuf);  // Mark the buffer for the writing operation
+            if (__z_unicast_encode_z_msg(&ztc->_wbuf, z_msg, z_msg_bytes) == _Z_RES_OK) {
+                *is_batched = true;
+            } else {
+                // The message does not fit in the open frame: revert the buffer and send the batch
+                _z_wbuf_set_wpos(&ztc->_wbuf, w_pos);
+                ret = __unsafe_z_unicast_flush(ztu, ztc);
+            }
+        } else {
+            // A frame carries messages of a single reliability: send the batch
+            ret = __unsafe_z_unicast_flush(ztu, ztc);
+        }
+    }
+
+    return ret;
+}
+#endif  // Z_TX_BATCHING == 1
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztc->_mutex
+ */
+int8_t __unsafe_z_unicast_frame_z_msg(_z_transport_unicast_t *ztu, _z_transport_tx_conduit_t *ztc,
+                                      const _z_zenoh_message_t *z_msg, const _z_bytes_t *z_msg_bytes,
+                                      z_reliability_t reliability, z_priority_t priority) {
+    int8_t ret = _Z_RES_OK;
+
     // Prepare the buffer eventually reserving space for the message length
-    __unsafe_z_prepare_wbuf(&ztu->_wbuf, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
+    __unsafe_z_prepare_wbuf(&ztc->_wbuf, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
+
+    _z_zint_t sn = __unsafe_z_unicast_get_sn(ztu, ztc, reliability);  // Get the next sequence number
 
-    // Encode the session message
-    ret = _z_transport_message_encode(&ztu->_wbuf, t_msg);
+    _z_transport_message_t t_msg = _z_frame_header(priority, reliability, 0, 0, sn);
+    ret = _z_transport_message_encode(&ztc->_wbuf, &t_msg);  // Encode the frame header
     if (ret == _Z_RES_OK) {
-        // Write the message legnth in the reserved space if needed
-        __unsafe_z_finalize_wbuf(&ztu->_wbuf, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
-        // Send the wbuf on the socket
-        ret = _z_link_send_wbuf(ztu->_link, &ztu->_wbuf);
+        ret = __z_unicast_encode_z_msg(&ztc->_wbuf, z_msg, z_msg_bytes);  // Encode the zenoh message
         if (ret == _Z_RES_OK) {
-            ztu->_transmitted = true;  // Mark the session that we have transmitted data
+#if Z_TX_BATCHING == 1
+            // Keep the frame open so that the following messages can be appended to it
+            ztc->_batch_is_open = true;
+            ztc->_batch_reliability = reliability;
+            ztc->_batch_start = z_clock_now();
+#else
+            ret = __unsafe_z_unicast_send_wbuf(ztu, &ztc->_wbuf);
+#endif  // Z_TX_BATCHING == 1
+        } else {
+            // The message does not fit in the current batch, let's fragment it
+            // Encode the message on the fragmentation buffer, which only wraps the payload
+            _z_wbuf_t *fbf = &ztc->_fbuf;
+            _z_wbuf_reset(fbf);
+            ret = __z_unicast_encode_z_msg(fbf, z_msg, z_msg_bytes);
+
+            if (ret == _Z_RES_OK) {
+                _Bool is_first = true;  // Fragment and send the message
+                while ((_z_wbuf_len(fbf) > 0) && (ret == _Z_RES_OK)) {
+                    if (is_first == false) {  // Get the fragment sequence number
+                        sn = __unsafe_z_unicast_get_sn(ztu, ztc, reliability);
+                    }
+                    is_first = false;
+
+                    // Clear the buffer for serialization
+                    __unsafe_z_prepare_wbuf(&ztc->_wbuf, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
+
+                    // Serialize one fragment
+                    ret = __unsafe_z_serialize_zenoh_fragment(&ztc->_wbuf, fbf, priority, reliability, sn,
+                                                              _z_link_is_scatter_gather(ztu->_link));
+                    if (ret == _Z_RES_OK) {
+                        // Send the fragment, letting other conduits use the link in between fragments
+                        ret = __unsafe_z_unicast_send_wbuf(ztu, &ztc->_wbuf);
+                    }
+                }
+            }
+
+            _z_wbuf_reset(&ztc->_wbuf);  // Drop any reference to the fragmentation buffer memory
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * Transport messages are sent on the link right away, under ztu->_mutex_tx only, so that a KEEP_ALIVE is not held back
+ * by the zenoh messages being sent on the conduits.
+ *
+ * A CLOSE is the exception: it is sent once the batches left open on the conduits have been sent, and while holding
+ * their locks, so that no zenoh message that has been handed over to the transport is lost nor sent after it.
+ */
+int8_t _z_unicast_send_t_msg(_z_transport_unicast_t *ztu, const _z_transport_message_t *t_msg) {
+    int8_t ret = _Z_RES_OK;
+    _Z_DEBUG(">> send session message\n");
+
+    _Bool is_close = (_Z_MID(t_msg->_header) == _Z_MID_CLOSE);
+    if (is_close == true) {
+        // Acquire the locks of every conduit, in order
+        for (size_t i = 0; i < _z_transport_unicast_conduits_num(ztu); i++) {
+#if Z_MULTI_THREAD == 1
+            _z_mutex_lock(&ztu->_tx_conduits[i]._mutex);
+#endif  // Z_MULTI_THREAD == 1
+
+#if Z_TX_BATCHING == 1
+            int8_t res = __unsafe_z_unicast_flush(ztu, &ztu->_tx_conduits[i]);
+            if (res != _Z_RES_OK) {
+                ret = res;
+            }
+#endif  // Z_TX_BATCHING == 1
         }
     }
 
+    if (ret == _Z_RES_OK) {
 #if Z_MULTI_THREAD == 1
-    _z_mutex_unlock(&ztu->_mutex_tx);
+        _z_mutex_lock(&ztu->_mutex_tx);
 #endif  // Z_MULTI_THREAD == 1
 
+        // Prepare the buffer eventually reserving space for the message length
+        __unsafe_z_prepare_wbuf(&ztu->_wbuf_t_msg, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
+
+        // Encode the session message
+        ret = _z_transport_message_encode(&ztu->_wbuf_t_msg, t_msg);
+        if (ret == _Z_RES_OK) {
+            // Write the message length in the reserved space if needed
+            __unsafe_z_finalize_wbuf(&ztu->_wbuf_t_msg, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
+
+            ret = _z_link_send_wbuf(ztu->_link, &ztu->_wbuf_t_msg);  // Send the wbuf on the socket
+            if (ret == _Z_RES_OK) {
+                ztu->_transmitted = true;  // Mark the session that we have transmitted data
+            }
+        }
+
+#if Z_MULTI_THREAD == 1
+        _z_mutex_unlock(&ztu->_mutex_tx);
+#endif  // Z_MULTI_THREAD == 1
+    }
+
+#if Z_MULTI_THREAD == 1
+    if (is_close == true) {
+        for (size_t i = _z_transport_unicast_conduits_num(ztu); i > (size_t)0; i--) {
+            _z_mutex_unlock(&ztu->_tx_conduits[i - (size_t)1]._mutex);
+        }
+    }
+#endif  // Z_MULTI_THREAD == 1
+
+    return ret;
+}
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztc->_mutex
+ *
+ * An express message is sent right away, together with the batch it has been appended to.
+ */
+int8_t __unsafe_z_unicast_send_z_msg(_z_transport_unicast_t *ztu, _z_transport_tx_conduit_t *ztc,
+                                     const _z_zenoh_message_t *z_msg, const _z_bytes_t *z_msg_bytes,
+                                     z_reliability_t reliability, z_priority_t priority, _Bool is_express) {
+    int8_t ret = _Z_RES_OK;
+
+#if Z_TX_BATCHING == 1
+    _Bool is_batched = false;
+    // Append to the open frame
+    ret = __unsafe_z_unicast_batch_z_msg(ztu, ztc, z_msg, z_msg_bytes, reliability, &is_batched);
+    if ((ret == _Z_RES_OK) && (is_batched == false)) {
+        // Open a new frame
+        ret = __unsafe_z_unicast_frame_z_msg(ztu, ztc, z_msg, z_msg_bytes, reliability, priority);
+    }
+
+    // Send the batch if it carries an express message or if it has been open for too long
+    if ((ret == _Z_RES_OK) && (ztc->_batch_is_open == true) &&
+        ((is_express == true) || (z_clock_elapsed_ms(&ztc->_batch_start) >= (unsigned long)Z_TX_BATCHING_DEADLINE))) {
+        ret = __unsafe_z_unicast_flush(ztu, ztc);
+    }
+#else
+    (void)(is_express);  // Every message is sent right away
+    ret = __unsafe_z_unicast_frame_z_msg(ztu, ztc, z_msg, z_msg_bytes, reliability, priority);
+#endif  // Z_TX_BATCHING == 1
+
+    return ret;
+}
+
+#if Z_TX_QUEUE == 1
+/**
+ * Enqueues a zenoh message for the write task, applying the congestion control if the queue is full:
+ *  - a droppable message is dropped, or makes room by dropping the oldest message if the drop policy allows it,
+ *  - a blocking message waits for a free slot, and is discarded if none is released in time.
+ * The message is encoded in the slot, so that the caller does not need to keep it alive.
+ */
+static int8_t __z_unicast_enqueue_z_msg(_z_transport_unicast_t *ztu, const _z_zenoh_message_t *z_msg,
+                                        z_reliability_t reliability, z_congestion_control_t cong_ctrl,
+                                        z_priority_t priority, _Bool is_express, _Bool *is_enqueued) {
+    int8_t ret = _Z_RES_OK;
+    *is_enqueued = false;
+
+    _z_tx_queue_slot_t *slot = _z_tx_queue_push_begin(&ztu->_tx_queue);
+    if ((slot == NULL) && (cong_ctrl == Z_CONGESTION_CONTROL_DROP) && (ztu->_tx_drop_policy == Z_DROP_POLICY_OLDEST)) {
+        _z_tx_queue_slot_t *oldest = _z_tx_queue_pop_droppable_begin(&ztu->_tx_queue);
+        while ((slot == NULL) && (oldest != NULL)) {
+            _z_tx_queue_pop_end(&ztu->_tx_queue, oldest);
+            _Z_INFO("Dropping the oldest zenoh message because of congestion control\n");
+            atomic_fetch_add_explicit(&ztu->_tx_dropped, 1, memory_order_relaxed);
+
+            // The released slot may have been taken by another producer in the meantime
+            slot = _z_tx_queue_push_begin(&ztu->_tx_queue);
+            if (slot == NULL) {
+                oldest = _z_tx_queue_pop_droppable_begin(&ztu->_tx_queue);
+            }
+        }
+    } else if ((slot == NULL) && (cong_ctrl == Z_CONGESTION_CONTROL_BLOCK)) {
+        z_clock_t start = z_clock_now();
+        unsigned long elapsed = 0;
+        while ((slot == NULL) && (ztu->_write_task_running == true) &&
+               ((ztu->_tx_block_timeout == 0U) || (elapsed < ztu->_tx_block_timeout))) {
+            unsigned int timeout = 0U;  // Wait indefinitely
+            if (ztu->_tx_block_timeout > 0U) {
+                timeout = (unsigned int)(ztu->_tx_block_timeout - elapsed);
+            }
+            _z_tx_queue_wait_not_full(&ztu->_tx_queue, &ztu->_write_task_running, timeout);
+            slot = _z_tx_queue_push_begin(&ztu->_tx_queue);
+            elapsed = z_clock_elapsed_ms(&start);
+        }
+    } else {
+        // Either a free slot has been found, or the message is dropped below
+    }
+
+    if (slot != NULL) {
+        slot->_reliability = reliability;
+        slot->_priority = priority;
+        slot->_is_droppable = cong_ctrl == Z_CONGESTION_CONTROL_DROP;
+        slot->_is_express = is_express;
+        ret = _z_tx_queue_slot_encode(slot, z_msg);
+        _z_tx_queue_push_end(&ztu->_tx_queue, slot);  // An invalid slot is skipped by the write task
+        *is_enqueued = true;
+    } else if (cong_ctrl == Z_CONGESTION_CONTROL_DROP) {
+        _Z_INFO("Dropping zenoh message because of congestion control\n");
+        atomic_fetch_add_explicit(&ztu->_tx_dropped, 1, memory_order_relaxed);
+        *is_enqueued = true;  // The queue is full, drop the message
+    } else if (ztu->_write_task_running == true) {
+        _Z_INFO("Discarding zenoh message after waiting %ums for the TX queue\n", (unsigned int)ztu->_tx_block_timeout);
+        atomic_fetch_add_explicit(&ztu->_tx_timed_out, 1, memory_order_relaxed);
+        ret = _Z_ERR_TRANSPORT_TX_FAILED;
+        *is_enqueued = true;
+    } else {
+        // The write task has been stopped, fall back to sending the message directly
+    }
+
+    return ret;
+}
+
+int8_t _z_unicast_send_encoded_z_msg(_z_transport_unicast_t *ztu, const _z_bytes_t *z_msg_bytes,
+                                     z_reliability_t reliability, z_priority_t priority, _Bool is_express) {
+    int8_t ret = _Z_RES_OK;
+
+    _z_transport_tx_conduit_t *ztc = &ztu->_tx_conduits[_z_transport_unicast_conduit_idx(ztu, priority)];
+    if (ztu->_is_qos == false) {
+        priority = Z_PRIORITY_DEFAULT;
+    }
+
+    _z_mutex_lock(&ztc->_mutex);
+    ret = __unsafe_z_unicast_send_z_msg(ztu, ztc, NULL, z_msg_bytes, reliability, priority, is_express);
+    _z_mutex_unlock(&ztc->_mutex);
+
     return ret;
 }
+#endif  // Z_TX_QUEUE == 1
 
 int8_t _z_unicast_send_z_msg(_z_session_t *zn, _z_zenoh_message_t *z_msg, z_reliability_t reliability,
-                             z_congestion_control_t cong_ctrl) {
+                             z_congestion_control_t cong_ctrl, z_priority_t priority, _Bool is_express) {
     int8_t ret = _Z_RES_OK;
     _Z_DEBUG(">> send zenoh message\n");
 
     _z_transport_unicast_t *ztu = &zn->_tp->_transport._unicast;
 
-    // Acquire the lock and drop the message if needed
-    _Bool drop = false;
-    if (cong_ctrl == Z_CONGESTION_CONTROL_BLOCK) {
+    // Hand over the message to the write task if it is running
+    _Bool is_enqueued = false;
+#if Z_TX_QUEUE == 1
+    if (ztu->_write_task_running == true) {
+        // Check the flag again once accounted for, the write task being stopped in the meantime either waits for the
+        // message to be enqueued or has already returned, and the message is then sent directly
+        atomic_fetch_add_explicit(&ztu->_tx_producers, 1, memory_order_seq_cst);
+        if (ztu->_write_task_running == true) {
+            ret = __z_unicast_enqueue_z_msg(ztu, z_msg, reliability, cong_ctrl, priority, is_express, &is_enqueued);
+        }
+        if (atomic_fetch_sub_explicit(&ztu->_tx_producers, 1, memory_order_seq_cst) == (size_t)1) {
+            _z_tx_queue_wake_consumer(&ztu->_tx_queue);  // A stopped write task waits for the last producer
+        }
+    }
+#endif  // Z_TX_QUEUE == 1
+
+    if (is_enqueued == false) {
+        // Select the conduit: the priority is only signaled on the wire if QoS has been negotiated
+        _z_transport_tx_conduit_t *ztc = &ztu->_tx_conduits[_z_transport_unicast_conduit_idx(ztu, priority)];
+        if (ztu->_is_qos == false) {
+            priority = Z_PRIORITY_DEFAULT;
+        }
+
+        // Acquire the lock and drop the message if needed
+        _Bool drop = false;
+        if (cong_ctrl == Z_CONGESTION_CONTROL_BLOCK) {
 #if Z_MULTI_THREAD == 1
-        _z_mutex_lock(&ztu->_mutex_tx);
+            _z_mutex_lock(&ztc->_mutex);
 #endif  // Z_MULTI_THREAD == 1
-    } else {
+        } else {
 #if Z_MULTI_THREAD == 1
-        int locked = _z_mutex_trylock(&ztu->_mutex_tx);
-        if (locked != 0) {
-            _Z_INFO("Dropping zenoh message because of congestion control\n");
-            // We failed to acquire the lock, drop the message
-            drop = true;
+            int locked = _z_mutex_trylock(&ztc->_mutex);
+            if (locked != 0) {
+                _Z_INFO("Dropping zenoh message because of congestion control\n");
+                // We failed to acquire the lock, drop the message
+                drop = true;
+#if Z_TX_QUEUE == 1
+                atomic_fetch_add_explicit(&ztu->_tx_dropped, 1, memory_order_relaxed);
+#endif  // Z_TX_QUEUE == 1
+            }
+#endif  // Z_MULTI_THREAD == 1
         }
+
+        if (drop == false) {
+#if (Z_MULTI_THREAD == 1) && (Z_TX_BATCHING == 1)
+            _Bool was_open = ztc->_batch_is_open;
+#endif  // (Z_MULTI_THREAD == 1) && (Z_TX_BATCHING == 1)
+            ret = __unsafe_z_unicast_send_z_msg(ztu, ztc, z_msg, NULL, reliability, priority, is_express);
+
+#if Z_MULTI_THREAD == 1
+#if Z_TX_BATCHING == 1
+            // A batch that was already open has been seen by the lease task, or signaled to it by its opener
+            _Bool is_opened = (was_open == false) && (ztc->_batch_is_open == true);
+#endif  // Z_TX_BATCHING == 1
+            _z_mutex_unlock(&ztc->_mutex);
+#if Z_TX_BATCHING == 1
+            if (is_opened == true) {
+                // Have the lease task send the batch left open once its deadline has passed
+                _z_mutex_lock(&ztu->_mutex_tx);
+                _Bool wake_lease = (ztu->_batch_pending == false);
+                ztu->_batch_pending = true;
+                _z_mutex_unlock(&ztu->_mutex_tx);
+                if (wake_lease == true) {
+                    _zp_unicast_wake_lease(ztu);
+                }
+            }
+#endif  // Z_TX_BATCHING == 1
 #endif  // Z_MULTI_THREAD == 1
+        }
     }
 
-    if (drop == false) {
-        // Prepare the buffer eventually reserving space for the message length
-        __unsafe_z_prepare_wbuf(&ztu->_wbuf, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
+    return ret;
+}
 
-        _z_zint_t sn = __unsafe_z_unicast_get_sn(ztu, reliability);  // Get the next sequence number
+int8_t _z_unicast_flush(_z_transport_unicast_t *ztu) {
+    int8_t ret = _Z_RES_OK;
 
-        _z_transport_message_t t_msg = _z_frame_header(reliability, 0, 0, sn);
-        ret = _z_transport_message_encode(&ztu->_wbuf, &t_msg);  // Encode the frame header
-        if (ret == _Z_RES_OK) {
-            ret = _z_zenoh_message_encode(&ztu->_wbuf, z_msg);  // Encode the zenoh message
-            if (ret == _Z_RES_OK) {
-                // Write the message legnth in the reserved space if needed
-                __unsafe_z_finalize_wbuf(&ztu->_wbuf, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
+#if Z_TX_BATCHING == 1
+    for (size_t i = 0; i < _z_transport_unicast_conduits_num(ztu); i++) {
+        _z_transport_tx_conduit_t *ztc = &ztu->_tx_conduits[i];
+#if Z_MULTI_THREAD == 1
+        _z_mutex_lock(&ztc->_mutex);
+#endif  // Z_MULTI_THREAD == 1
+
+        int8_t res = __unsafe_z_unicast_flush(ztu, ztc);
+        if (res != _Z_RES_OK) {
+            ret = res;
+        }
+
+#if Z_MULTI_THREAD == 1
+        _z_mutex_unlock(&ztc->_mutex);
+#endif  // Z_MULTI_THREAD == 1
+    }
+#else
+    (void)(ztu);
+#endif  // Z_TX_BATCHING == 1
 
-                ret = _z_link_send_wbuf(ztu->_link, &ztu->_wbuf);  // Send the wbuf on the socket
-                if (ret == _Z_RES_OK) {
-                    ztu->_transmitted = true;  // Mark the session that we have transmitted data
+    return ret;
+}
+
+#if Z_TX_BATCHING == 1
+int8_t _z_unicast_flush_expired(_z_transport_unicast_t *ztu, _z_zint_t *next, _Bool *is_open) {
+    int8_t ret = _Z_RES_OK;
+    *is_open = false;
+
+    for (size_t i = 0; i < _z_transport_unicast_conduits_num(ztu); i++) {
+        _z_transport_tx_conduit_t *ztc = &ztu->_tx_conduits[i];
+#if Z_MULTI_THREAD == 1
+        _z_mutex_lock(&ztc->_mutex);
+#endif  // Z_MULTI_THREAD == 1
+
+        if (ztc->_batch_is_open == true) {
+            unsigned long elapsed = z_clock_elapsed_ms(&ztc->_batch_start);
+            if (elapsed >= (unsigned long)Z_TX_BATCHING_DEADLINE) {
+                int8_t res = __unsafe_z_unicast_flush(ztu, ztc);
+                if (res != _Z_RES_OK) {
+                    ret = res;
                 }
             } else {
-                // The message does not fit in the current batch, let's fragment it
-                // Create an expandable wbuf for fragmentation
-                _z_wbuf_t fbf = _z_wbuf_make(Z_IOSLICE_SIZE, true);
-
-                ret = _z_zenoh_message_encode(&fbf, z_msg);  // Encode the message on the expandable wbuf
-                if (ret == _Z_RES_OK) {
-                    _Bool is_first = true;  // Fragment and send the message
-                    while (_z_wbuf_len(&fbf) > 0) {
-                        if (is_first == false) {  // Get the fragment sequence number
-                            sn = __unsafe_z_unicast_get_sn(ztu, reliability);
-                        }
-                        is_first = false;
-
-                        // Clear the buffer for serialization
-                        __unsafe_z_prepare_wbuf(&ztu->_wbuf, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
-
-                        // Serialize one fragment
-                        ret = __unsafe_z_serialize_zenoh_fragment(&ztu->_wbuf, &fbf, reliability, sn);
-                        if (ret == _Z_RES_OK) {
-                            // Write the message length in the reserved space if needed
-                            __unsafe_z_finalize_wbuf(&ztu->_wbuf, _Z_LINK_IS_STREAMED(ztu->_link->_capabilities));
-
-                            ret = _z_link_send_wbuf(ztu->_link, &ztu->_wbuf);  // Send the wbuf on the socket
-                            if (ret == _Z_RES_OK) {
-                                ztu->_transmitted = true;  // Mark the session that we have transmitted data
-                            }
-                        }
-                    }
+                *is_open = true;
+                _z_zint_t left = (_z_zint_t)((unsigned long)Z_TX_BATCHING_DEADLINE - elapsed);
+                if (left < *next) {
+                    *next = left;
                 }
-
-                _z_wbuf_clear(&fbf);  // Free the fragmentation buffer memory
             }
         }
 
 #if Z_MULTI_THREAD == 1
-        _z_mutex_unlock(&ztu->_mutex_tx);
+        _z_mutex_unlock(&ztc->_mutex);
 #endif  // Z_MULTI_THREAD == 1
     }
 
     return ret;
 }
+#endif  // Z_TX_BATCHING == 1
 
 #endif  // Z_UNICAST_TRANSPORT == 1
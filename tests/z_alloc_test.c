@@ -0,0 +1,359 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/net/resource.h"
+#include "zenoh-pico/protocol/msgcodec.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/link/rx.h"
+#include "zenoh-pico/transport/transport.h"
+#include "zenoh-pico/utils/pointers.h"
+
+#define RUNS 10000
+#define WARMUP 10
+#define MTU 1500
+#define MSG_LEN 64
+#define FRAG_MSG_LEN (8 * MTU)
+#define LARGE_MSG_LEN (Z_FRAG_MAX_SIZE + 1)  // Only bounds the reassembly, not the transmission
+#define BATCH_MSGS 100
+#define DEFRAG_MSG_LEN (256 * 1024)
+#define DEFRAG_RUNS 100
+
+// The allocation functions of the platform are overridden to count the allocations done by the library
+volatile size_t allocs = 0;
+volatile size_t largest_alloc = 0;
+
+void *z_malloc(size_t size) {
+    allocs++;
+    largest_alloc = (size > largest_alloc) ? size : largest_alloc;
+    return malloc(size);
+}
+
+void *z_realloc(void *ptr, size_t size) {
+    allocs++;
+    largest_alloc = (size > largest_alloc) ? size : largest_alloc;
+    return realloc(ptr, size);
+}
+
+void z_free(void *ptr) { free(ptr); }
+
+/*=============================*/
+/*          Dummy link         */
+/*=============================*/
+size_t sent = 0;
+
+void dummy_close(_z_link_t *self) { (void)(self); }
+
+void dummy_free(_z_link_t *self) { (void)(self); }
+
+size_t dummy_write(const _z_link_t *self, const uint8_t *ptr, size_t len) {
+    (void)(self);
+    (void)(ptr);
+    sent = sent + len;
+    return len;
+}
+
+size_t dummy_writev(const _z_link_t *self, const _z_wbuf_t *wbf) {
+    (void)(self);
+    size_t len = _z_wbuf_len(wbf);
+    sent = sent + len;
+    return len;
+}
+
+size_t dummy_write_burst(const _z_link_t *self, const _z_wbuf_t *wbfs, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        (void)dummy_writev(self, &wbfs[i]);
+    }
+    return n;
+}
+
+_z_link_t *dummy_link_new(uint8_t capabilities) {
+    _z_link_t *zl = (_z_link_t *)z_malloc(sizeof(_z_link_t));
+    (void)memset(zl, 0, sizeof(_z_link_t));
+    zl->_close_f = dummy_close;
+    zl->_free_f = dummy_free;
+    zl->_write_f = dummy_write;
+    zl->_write_all_f = dummy_write;
+    zl->_writev_f = dummy_writev;
+    if (_Z_LINK_IS_BURST(capabilities) == true) {
+        zl->_write_burst_f = dummy_write_burst;
+    }
+    zl->_mtu = MTU;
+    zl->_capabilities = capabilities;
+    return zl;
+}
+
+/*=============================*/
+/*       Dummy sessions        */
+/*=============================*/
+_z_session_t *unicast_session_new(uint8_t capabilities) {
+    _z_session_t *zn = _z_session_init();
+
+    _z_transport_unicast_establish_param_t param;
+    (void)memset(&param, 0, sizeof(param));
+    param._remote_pid = _z_bytes_make(Z_ZID_LENGTH);
+    param._whatami = Z_WHATAMI_ROUTER;
+    param._sn_resolution = Z_SN_RESOLUTION;
+    param._is_qos = false;
+    param._lease = Z_TRANSPORT_LEASE;
+
+    zn->_tp = _z_transport_unicast_new(dummy_link_new(capabilities), param);
+    zn->_tp->_transport._unicast._session = zn;
+    zn->_tp->_transport._unicast._remote_pid = param._remote_pid;
+
+    return zn;
+}
+
+_z_session_t *multicast_session_new(uint8_t capabilities) {
+    _z_session_t *zn = _z_session_init();
+
+    _z_transport_multicast_establish_param_t param;
+    (void)memset(&param, 0, sizeof(param));
+    param._sn_resolution = Z_SN_RESOLUTION;
+    param._is_qos = false;
+
+    zn->_tp = _z_transport_multicast_new(dummy_link_new(capabilities), param);
+    zn->_tp->_transport._multicast._session = zn;
+
+    return zn;
+}
+
+/*=============================*/
+/*            Tests            */
+/*=============================*/
+void publish(z_session_t zs, z_publisher_t pub, const uint8_t *payload, size_t len) {
+    z_put_options_t opt = z_put_options_default();
+    opt.congestion_control = Z_CONGESTION_CONTROL_BLOCK;
+
+    int8_t ret = z_put(zs, z_keyexpr("demo/example/put"), payload, len, &opt);
+    assert(ret == _Z_RES_OK);
+    ret = z_publisher_put(pub, payload, len, NULL);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+}
+
+void steady_state_no_alloc(const char *name, _z_session_t *zn) {
+    printf("\n>>> Testing allocations on %s\n", name);
+
+    uint8_t *payload = (uint8_t *)malloc(LARGE_MSG_LEN);
+    (void)memset(payload, 'A', LARGE_MSG_LEN);
+
+    z_session_t zs = {._val = zn};
+    z_owned_publisher_t pub = z_declare_publisher(zs, z_keyexpr("demo/example/pub"), NULL);
+    assert(z_publisher_check(&pub));
+
+    // Let the transport allocate its buffers, both for plain and fragmented messages. The payload of the fragmented
+    // messages is only wrapped, so no buffer of their size is ever allocated.
+    largest_alloc = 0;
+    for (size_t i = 0; i < WARMUP; i++) {
+        publish(zs, z_publisher_loan(&pub), payload, MSG_LEN);
+        publish(zs, z_publisher_loan(&pub), payload, FRAG_MSG_LEN);
+        publish(zs, z_publisher_loan(&pub), payload, LARGE_MSG_LEN);
+    }
+    (void)zp_send_keep_alive(zs, NULL);
+    printf("  - Largest allocation of %zu bytes while warming up\n", largest_alloc);
+    assert(largest_alloc < (size_t)FRAG_MSG_LEN);
+
+    size_t before = allocs;
+    size_t bytes = sent;
+    for (size_t i = 0; i < RUNS; i++) {
+        publish(zs, z_publisher_loan(&pub), payload, MSG_LEN);
+        if ((i % (size_t)100) == (size_t)0) {
+            publish(zs, z_publisher_loan(&pub), payload, FRAG_MSG_LEN);
+            publish(zs, z_publisher_loan(&pub), payload, LARGE_MSG_LEN);
+            int8_t ret = zp_send_keep_alive(zs, NULL);
+            assert(ret == _Z_RES_OK);
+            (void)(ret);
+        }
+    }
+    int8_t ret = zp_flush(zs, NULL);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+    size_t after = allocs;
+
+    printf("  - Sent %zu bytes with %zu allocations\n", sent - bytes, after - before);
+    assert(sent - bytes >= (size_t)RUNS * (size_t)MSG_LEN);
+    assert(after == before);
+    (void)(before);
+    (void)(after);
+    (void)(bytes);
+
+    z_undeclare_publisher(z_publisher_move(&pub));
+    _z_session_free(&zn);
+    free(payload);
+}
+
+// Only the keys made of a resource ID alone are decoded without allocating: the suffix of a key is still allocated by
+// _z_str_decode, as it is owned and released by the decoded _z_keyexpr_t, so expect one allocation per suffixed key
+void decode_no_alloc(const char *name, _z_zenoh_message_arena_t *arena, const char *suffix) {
+    printf("\n>>> Testing allocations when decoding on %s, with keys %s suffix\n", name,
+           (suffix != NULL) ? "with a" : "without");
+    size_t expected = (suffix != NULL) ? (size_t)RUNS * (size_t)BATCH_MSGS : (size_t)0;
+
+    // Encode a frame carrying a batch of data messages
+    uint8_t payload[MSG_LEN];
+    (void)memset(payload, 'A', sizeof(payload));
+    _z_wbuf_t wbf = _z_wbuf_make(Z_BATCH_SIZE_RX, false);
+    _z_transport_message_t t_msg = _z_t_msg_make_frame_header(0, true, false, false);
+    int8_t ret = _z_transport_message_encode(&wbf, &t_msg);
+    assert(ret == _Z_RES_OK);
+    _z_data_info_t info;
+    (void)memset(&info, 0, sizeof(info));
+    for (size_t i = 0; i < (size_t)BATCH_MSGS; i++) {
+        _z_zenoh_message_t z_msg =
+            _z_msg_make_data(_z_rid_with_suffix(1, suffix), info, _z_bytes_wrap(payload, sizeof(payload)), false);
+        ret = _z_zenoh_message_encode(&wbf, &z_msg);
+        assert(ret == _Z_RES_OK);
+        _z_keyexpr_clear(&z_msg._body._data._key);
+    }
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+
+    // Let the arena grow to the size of the batch
+    _z_transport_message_result_t r;
+    for (size_t i = 0; i < WARMUP; i++) {
+        _z_zbuf_set_rpos(&zbf, 0);
+        _z_transport_message_decode_ar(&zbf, arena, &r);
+        assert(r._tag == _Z_RES_OK);
+        _z_t_msg_clear_ar(&r._value, arena);
+    }
+
+    size_t before = allocs;
+    size_t decoded = 0;
+    for (size_t i = 0; i < RUNS; i++) {
+        _z_zbuf_set_rpos(&zbf, 0);
+        _z_transport_message_decode_ar(&zbf, arena, &r);
+        assert(r._tag == _Z_RES_OK);
+#if Z_RX_STREAMING == 1
+        while (_z_frame_decode_next(&r._value._body._frame, arena) != NULL) {
+            decoded = decoded + (size_t)1;
+        }
+#else
+        decoded = decoded + _z_zenoh_message_vec_len(&r._value._body._frame._payload._messages);
+#endif  // Z_RX_STREAMING == 1
+        _z_t_msg_clear_ar(&r._value, arena);
+    }
+    size_t after = allocs;
+
+    printf("  - Decoded %zu messages with %zu allocations\n", decoded, after - before);
+    assert(decoded == (size_t)RUNS * (size_t)BATCH_MSGS);
+    assert(after - before == expected);
+    (void)(ret);
+    (void)(before);
+    (void)(after);
+    (void)(decoded);
+    (void)(expected);
+
+    _z_zbuf_clear(&zbf);
+    _z_wbuf_clear(&wbf);
+}
+
+size_t received = 0;
+
+void on_sample(const z_sample_t *sample, void *arg) {
+    size_t *len = (size_t *)arg;
+    *len = sample->payload.len;
+    received++;
+}
+
+void defrag_no_copy(const char *name, _z_session_t *zn) {
+    printf("\n>>> Testing copies when reassembling fragments on %s\n", name);
+
+    size_t len = 0;
+    z_session_t zs = {._val = zn};
+    z_owned_closure_sample_t callback = z_closure(on_sample, NULL, &len);
+    z_owned_subscriber_t sub = z_declare_subscriber(zs, z_keyexpr("demo/example/defrag"), z_move(callback), NULL);
+    assert(z_subscriber_check(&sub));
+
+    // Encode a large data message, to be split in fragments of one MTU
+    uint8_t *payload = (uint8_t *)malloc(DEFRAG_MSG_LEN);
+    (void)memset(payload, 'A', DEFRAG_MSG_LEN);
+    _z_data_info_t info;
+    (void)memset(&info, 0, sizeof(info));
+    _z_zenoh_message_t z_msg = _z_msg_make_data(_z_rid_with_suffix(Z_RESOURCE_ID_NONE, "demo/example/defrag"), info,
+                                                _z_bytes_wrap(payload, DEFRAG_MSG_LEN), false);
+    _z_wbuf_t wbf = _z_wbuf_make(Z_IOSLICE_SIZE, true);
+    int8_t ret = _z_zenoh_message_encode(&wbf, &z_msg);
+    assert(ret == _Z_RES_OK);
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+
+    _z_transport_unicast_t *ztu = &zn->_tp->_transport._unicast;
+    _z_zint_t sn = 0;
+    for (size_t i = 0; i < (WARMUP + DEFRAG_RUNS); i++) {
+        // Once the defragmentation buffer has grown, messages must be decoded from it without being copied
+        if (i == (size_t)WARMUP) {
+            largest_alloc = 0;
+        }
+        for (size_t pos = 0; pos < _z_zbuf_len(&zbf); pos = pos + MTU) {
+            size_t frag_len = ((_z_zbuf_len(&zbf) - pos) < MTU) ? (_z_zbuf_len(&zbf) - pos) : MTU;
+            _z_frame_payload_t frame;
+            frame._fragment = _z_bytes_wrap(_z_cptr_u8_offset(_z_zbuf_get_rptr(&zbf), (ptrdiff_t)pos), frag_len);
+            sn = (sn + (_z_zint_t)1) % ztu->_sn_resolution;
+            _z_transport_message_t t_msg =
+                _z_t_msg_make_frame(sn, frame, true, true, (pos + frag_len) == _z_zbuf_len(&zbf));
+            ret = _z_unicast_handle_transport_message(ztu, &t_msg);
+            assert(ret == _Z_RES_OK);
+        }
+    }
+
+    printf("  - Reassembled %zu messages of %zu bytes, largest allocation of %zu bytes\n", received, len,
+           largest_alloc);
+    assert(received == (size_t)(WARMUP + DEFRAG_RUNS));
+    assert(len == (size_t)DEFRAG_MSG_LEN);
+    assert(largest_alloc < (size_t)MTU);
+    (void)(ret);
+
+    _z_zbuf_clear(&zbf);
+    _z_wbuf_clear(&wbf);
+    free(payload);
+    z_undeclare_subscriber(z_move(sub));
+}
+
+int main(void) {
+    setvbuf(stdout, NULL, _IOLBF, 1024);
+
+    // Make sure that the allocations of the library are seen by this test, otherwise there is nothing to check
+    size_t before = allocs;
+    _z_wbuf_t wbf = _z_wbuf_make(MTU, false);
+    _z_wbuf_clear(&wbf);
+    if (allocs == before) {
+        printf("Allocations done by the library cannot be counted on this platform, skipping\n");
+        return 0;
+    }
+
+#if Z_UNICAST_TRANSPORT == 1
+    _z_session_t *zn = unicast_session_new(Z_LINK_CAPABILITY_NONE);
+    decode_no_alloc("unicast transport", &zn->_tp->_transport._unicast._arena, NULL);
+    decode_no_alloc("unicast transport", &zn->_tp->_transport._unicast._arena, "/suffix");
+    defrag_no_copy("unicast transport", zn);
+    steady_state_no_alloc("unicast datagram link", zn);
+    steady_state_no_alloc("unicast streamed link",
+                          unicast_session_new(Z_LINK_CAPABILITY_RELIEABLE | Z_LINK_CAPABILITY_STREAMED));
+#endif  // Z_UNICAST_TRANSPORT == 1
+#if Z_MULTICAST_TRANSPORT == 1
+    _z_session_t *zm = multicast_session_new(Z_LINK_CAPABILITY_MULTICAST);
+    decode_no_alloc("multicast transport", &zm->_tp->_transport._multicast._arena, NULL);
+    decode_no_alloc("multicast transport", &zm->_tp->_transport._multicast._arena, "/suffix");
+    steady_state_no_alloc("multicast link", zm);
+    steady_state_no_alloc("multicast burst link",
+                          multicast_session_new(Z_LINK_CAPABILITY_MULTICAST | Z_LINK_CAPABILITY_BURST));
+#endif  // Z_MULTICAST_TRANSPORT == 1
+
+    return 0;
+}
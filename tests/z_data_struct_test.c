@@ -110,5 +110,31 @@ int main(void) {
     _z_str_intmap_clear(&map);
     assert(_z_str_intmap_is_empty(&map) == true);
 
+    // Sparse keys, growing the map and removing entries in the middle of colliding runs
+    size_t many = 5000;
+    for (size_t i = 0; i < many; i++) {
+        snprintf(s, 64, "%zu", i * 64);
+        _z_str_intmap_insert(&map, i * 64, _z_str_clone(s));
+    }
+    assert(_z_str_intmap_len(&map) == many);
+
+    for (size_t i = 0; i < many; i += 3) {
+        _z_str_intmap_remove(&map, i * 64);
+    }
+    for (size_t i = 0; i < many; i++) {
+        char *e = _z_str_intmap_get(&map, i * 64);
+        if ((i % 3) == 0) {
+            assert(e == NULL);
+        } else {
+            snprintf(s, 64, "%zu", i * 64);
+            assert(_z_str_eq(s, e) == true);
+        }
+        assert(_z_str_intmap_get(&map, (i * 64) + 1) == NULL);
+    }
+    assert(_z_str_intmap_len(&map) == many - ((many + 2) / 3));
+
+    _z_str_intmap_clear(&map);
+    assert(_z_str_intmap_is_empty(&map) == true);
+
     return 0;
 }
@@ -0,0 +1,383 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/net/resource.h"
+#include "zenoh-pico/session/executor.h"
+#include "zenoh-pico/session/subscription.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/transport.h"
+
+#if Z_EXECUTOR == 1
+
+#define KEY "demo/example/executor"
+#define INLINE_KEY "demo/example/inline"
+#define MTU 1500
+#define STRANDS 4
+#define WORKERS 4
+#define JOBS 200
+
+/*=============================*/
+/*            Gate             */
+/*=============================*/
+// Holds the jobs back until it is opened, so that they pile up in the queues
+_z_mutex_t gate_mutex;
+_z_condvar_t gate_cv;
+_Bool gate_is_open = true;
+
+void gate_close(void) {
+    _z_mutex_lock(&gate_mutex);
+    gate_is_open = false;
+    _z_mutex_unlock(&gate_mutex);
+}
+
+void gate_open(void) {
+    _z_mutex_lock(&gate_mutex);
+    gate_is_open = true;
+    _z_condvar_signal(&gate_cv);
+    _z_mutex_unlock(&gate_mutex);
+}
+
+void gate_pass(void) {
+    _z_mutex_lock(&gate_mutex);
+    while (gate_is_open == false) {
+        _z_condvar_wait(&gate_cv, &gate_mutex);
+    }
+    _z_condvar_signal(&gate_cv);  // Wake up the next one waiting for the gate
+    _z_mutex_unlock(&gate_mutex);
+}
+
+void *gate_open_later(void *arg) {
+    (void)(arg);
+    z_sleep_ms(50);
+    gate_open();
+    return NULL;
+}
+
+/*=============================*/
+/*            Jobs             */
+/*=============================*/
+typedef struct {
+    _z_executor_job_t _job;  // Must be the first member
+    size_t _strand;
+    size_t _seq;
+} test_job_t;
+
+// The sequence numbers of the jobs run on each strand, in order
+_z_mutex_t log_mutex;
+size_t run_seq[STRANDS][JOBS];
+size_t run_num[STRANDS];
+size_t running[STRANDS];
+size_t freed = 0;
+
+void job_run(_z_executor_job_t *job) {
+    test_job_t *tjob = (test_job_t *)job;
+
+    _z_mutex_lock(&log_mutex);
+    running[tjob->_strand] = running[tjob->_strand] + (size_t)1;
+    assert(running[tjob->_strand] == (size_t)1);  // The jobs of a strand are never run concurrently
+    _z_mutex_unlock(&log_mutex);
+
+    gate_pass();
+
+    _z_mutex_lock(&log_mutex);
+    assert(run_num[tjob->_strand] < (size_t)JOBS);
+    run_seq[tjob->_strand][run_num[tjob->_strand]] = tjob->_seq;
+    run_num[tjob->_strand] = run_num[tjob->_strand] + (size_t)1;
+    running[tjob->_strand] = running[tjob->_strand] - (size_t)1;
+    _z_mutex_unlock(&log_mutex);
+}
+
+void job_free(_z_executor_job_t *job) {
+    _z_mutex_lock(&log_mutex);
+    freed = freed + (size_t)1;
+    _z_mutex_unlock(&log_mutex);
+    z_free(job);
+}
+
+void push(_z_executor_t *ex, _z_executor_strand_t *strands, size_t strand, size_t seq) {
+    test_job_t *tjob = (test_job_t *)z_malloc(sizeof(test_job_t));
+    assert(tjob != NULL);
+    tjob->_job._run = job_run;
+    tjob->_job._free = job_free;
+    tjob->_strand = strand;
+    tjob->_seq = seq;
+    int8_t ret = _z_executor_push(ex, &strands[strand], &tjob->_job);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+}
+
+void reset(_z_executor_strand_t *strands) {
+    for (size_t i = 0; i < (size_t)STRANDS; i++) {
+        _z_executor_strand_init(&strands[i]);
+        run_num[i] = 0;
+        running[i] = 0;
+    }
+    freed = 0;
+}
+
+/*=============================*/
+/*            Tests            */
+/*=============================*/
+void fifo_order(void) {
+    printf(">>> Jobs run in order on each strand\n");
+    _z_executor_t ex;
+    _z_executor_strand_t strands[STRANDS];
+    _z_executor_init(&ex);
+    reset(strands);
+
+    int8_t ret = _z_executor_start(&ex, WORKERS);
+    assert(ret == _Z_RES_OK);
+    for (size_t seq = 0; seq < (size_t)JOBS; seq++) {
+        for (size_t i = 0; i < (size_t)STRANDS; i++) {
+            push(&ex, strands, i, seq);
+        }
+    }
+    ret = _z_executor_stop(&ex);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+
+    assert(freed == (size_t)(STRANDS * JOBS));
+    for (size_t i = 0; i < (size_t)STRANDS; i++) {
+        assert(run_num[i] == (size_t)JOBS);
+        for (size_t seq = 0; seq < (size_t)JOBS; seq++) {
+            assert(run_seq[i][seq] == seq);
+        }
+    }
+    _z_executor_clear(&ex);
+}
+
+void stop_drains(void) {
+    printf(">>> Stopping runs the queued jobs first\n");
+    _z_executor_t ex;
+    _z_executor_strand_t strands[STRANDS];
+    _z_executor_init(&ex);
+    reset(strands);
+
+    int8_t ret = _z_executor_start(&ex, 1);
+    assert(ret == _Z_RES_OK);
+    gate_close();
+    for (size_t i = 0; i < (size_t)STRANDS; i++) {
+        push(&ex, strands, i, 0);
+        push(&ex, strands, i, 1);
+    }
+
+    _z_task_t opener;
+    int res = _z_task_init(&opener, NULL, gate_open_later, NULL);
+    assert(res == 0);
+    (void)(res);
+    ret = _z_executor_stop(&ex);  // Only returns once the gate is open and all the jobs are run
+    assert(ret == _Z_RES_OK);
+    _z_task_join(&opener);
+
+    assert(freed == (size_t)(STRANDS * 2));
+    for (size_t i = 0; i < (size_t)STRANDS; i++) {
+        assert(run_num[i] == (size_t)2);
+    }
+    size_t queued = 0;
+    size_t high_water_mark = 0;
+    _z_executor_stats(&ex, &queued, &high_water_mark);
+    assert(queued == (size_t)0);
+
+    // No more jobs are accepted once stopped
+    test_job_t tjob;
+    ret = _z_executor_push(&ex, &strands[0], &tjob._job);
+    assert(ret != _Z_RES_OK);
+    (void)(ret);
+    _z_executor_clear(&ex);
+}
+
+void depth_and_high_water_mark(void) {
+    printf(">>> Queue depths and high water mark\n");
+    _z_executor_t ex;
+    _z_executor_strand_t strands[STRANDS];
+    _z_executor_init(&ex);
+    reset(strands);
+
+    size_t queued = 0;
+    size_t high_water_mark = 0;
+    int8_t ret = _z_executor_start(&ex, WORKERS);
+    assert(ret == _Z_RES_OK);
+    gate_close();
+    // The jobs being run are accounted for along with the ones waiting to be run
+    for (size_t seq = 0; seq < (size_t)4; seq++) {
+        push(&ex, strands, 0, seq);
+    }
+    push(&ex, strands, 1, 0);
+    push(&ex, strands, 1, 1);
+    assert(_z_executor_strand_depth(&ex, &strands[0]) == (size_t)4);
+    assert(_z_executor_strand_depth(&ex, &strands[1]) == (size_t)2);
+    assert(_z_executor_strand_depth(&ex, &strands[2]) == (size_t)0);
+    _z_executor_stats(&ex, &queued, &high_water_mark);
+    assert(queued == (size_t)6);
+    assert(high_water_mark == (size_t)6);
+
+    gate_open();
+    ret = _z_executor_stop(&ex);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+
+    // The high water mark is kept once the queues are drained
+    assert(_z_executor_strand_depth(&ex, &strands[0]) == (size_t)0);
+    assert(_z_executor_strand_depth(&ex, &strands[1]) == (size_t)0);
+    _z_executor_stats(&ex, &queued, &high_water_mark);
+    assert(queued == (size_t)0);
+    assert(high_water_mark == (size_t)6);
+    _z_executor_clear(&ex);
+}
+
+/*=============================*/
+/*         Dummy link          */
+/*=============================*/
+void dummy_close(_z_link_t *self) { (void)(self); }
+
+void dummy_free(_z_link_t *self) { (void)(self); }
+
+size_t dummy_write(const _z_link_t *self, const uint8_t *ptr, size_t len) {
+    (void)(self);
+    (void)(ptr);
+    return len;
+}
+
+size_t dummy_writev(const _z_link_t *self, const _z_wbuf_t *wbf) {
+    (void)(self);
+    return _z_wbuf_len(wbf);
+}
+
+_z_link_t *dummy_link_new(void) {
+    _z_link_t *zl = (_z_link_t *)z_malloc(sizeof(_z_link_t));
+    (void)memset(zl, 0, sizeof(_z_link_t));
+    zl->_close_f = dummy_close;
+    zl->_free_f = dummy_free;
+    zl->_write_f = dummy_write;
+    zl->_write_all_f = dummy_write;
+    zl->_writev_f = dummy_writev;
+    zl->_mtu = MTU;
+    zl->_capabilities = Z_LINK_CAPABILITY_RELIEABLE;
+    return zl;
+}
+
+/*=============================*/
+/*         Subscribers         */
+/*=============================*/
+size_t samples = 0;
+
+void on_sample(const z_sample_t *sample, void *arg) {
+    (void)(sample);
+    if (arg != NULL) {
+        gate_pass();  // Only on the executor, as the read task would be blocked otherwise
+    }
+    _z_mutex_lock(&log_mutex);
+    samples = samples + (size_t)1;
+    _z_mutex_unlock(&log_mutex);
+}
+
+void trigger(_z_session_t *zn, const char *key) {
+    uint8_t payload = 0;
+    _z_timestamp_t timestamp;
+    (void)memset(&timestamp, 0, sizeof(timestamp));
+    int8_t ret = _z_trigger_subscriptions(zn, _z_rname(key), _z_bytes_wrap(&payload, 1), z_encoding_default(),
+                                          Z_SAMPLE_KIND_PUT, timestamp);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+}
+
+void session_stats(void) {
+    printf(">>> Session executor statistics\n");
+    _z_session_t *zn = _z_session_init();
+    _z_transport_unicast_establish_param_t param;
+    (void)memset(&param, 0, sizeof(param));
+    param._remote_pid = _z_bytes_make(Z_ZID_LENGTH);
+    param._whatami = Z_WHATAMI_ROUTER;
+    param._sn_resolution = Z_SN_RESOLUTION;
+    param._is_qos = false;
+    param._lease = Z_TRANSPORT_LEASE;
+    zn->_tp = _z_transport_unicast_new(dummy_link_new(), param);
+    zn->_tp->_transport._unicast._session = zn;
+    zn->_tp->_transport._unicast._remote_pid = param._remote_pid;
+
+    z_session_t zs = {._val = zn};
+    z_subscriber_options_t opts = z_subscriber_options_default();
+    opts.executor = true;
+    z_owned_closure_sample_t callback = z_closure(on_sample, NULL, &gate_mutex);
+    z_owned_subscriber_t sub = z_declare_subscriber(zs, z_keyexpr(KEY), z_move(callback), &opts);
+    assert(z_subscriber_check(&sub));
+    z_owned_closure_sample_t inline_callback = z_closure(on_sample, NULL, NULL);
+    z_owned_subscriber_t inline_sub = z_declare_subscriber(zs, z_keyexpr(INLINE_KEY), z_move(inline_callback), NULL);
+    assert(z_subscriber_check(&inline_sub));
+
+    zp_task_executor_options_t ex_opts = zp_task_executor_options_default();
+    ex_opts.workers = 1;
+    int8_t ret = zp_start_executor_task(zs, &ex_opts);
+    assert(ret == _Z_RES_OK);
+
+    gate_close();
+    samples = 0;
+    for (size_t i = 0; i < (size_t)3; i++) {
+        trigger(zn, KEY);
+        trigger(zn, INLINE_KEY);
+    }
+    assert(zp_subscriber_queue_depth(z_subscriber_loan(&sub)) == (size_t)3);
+    assert(zp_subscriber_queue_depth(z_subscriber_loan(&inline_sub)) == (size_t)0);
+    zp_executor_stats_t stats;
+    ret = zp_executor_stats(zs, &stats);
+    assert(ret == _Z_RES_OK);
+    assert(stats.queued == (size_t)3);
+    assert(stats.high_water_mark == (size_t)3);
+
+    gate_open();
+    ret = zp_stop_executor_task(zs);
+    assert(ret == _Z_RES_OK);
+    assert(samples == (size_t)6);
+    assert(zp_subscriber_queue_depth(z_subscriber_loan(&sub)) == (size_t)0);
+    ret = zp_executor_stats(zs, &stats);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+    assert(stats.queued == (size_t)0);
+    assert(stats.high_water_mark == (size_t)3);
+
+    z_undeclare_subscriber(z_move(sub));
+    z_undeclare_subscriber(z_move(inline_sub));
+    _z_session_free(&zn);
+}
+
+int main(void) {
+    setvbuf(stdout, NULL, _IOLBF, 1024);
+    _z_mutex_init(&gate_mutex);
+    _z_condvar_init(&gate_cv);
+    _z_mutex_init(&log_mutex);
+
+    fifo_order();
+    stop_drains();
+    depth_and_high_water_mark();
+    session_stats();
+
+    _z_mutex_free(&log_mutex);
+    _z_condvar_free(&gate_cv);
+    _z_mutex_free(&gate_mutex);
+
+    return 0;
+}
+#else
+int main(void) {
+    printf("Callbacks are not executed (Z_EXECUTOR is 0), skipping\n");
+    return 0;
+}
+#endif  // Z_EXECUTOR == 1
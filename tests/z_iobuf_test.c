@@ -18,6 +18,7 @@
 #include <string.h>
 
 #include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/utils/result.h"
 
 #define RUNS 1000
 
@@ -548,6 +549,94 @@ void wbuf_add_iosli(void) {
     _z_wbuf_clear(&wbf);
 }
 
+void wbuf_siphon(void) {
+    size_t len = 1 + (gen_size_t() % 1024);
+    uint8_t *payload = (uint8_t *)malloc(len);
+    for (size_t i = 0; i < len; i++) {
+        payload[i] = (uint8_t)(i % 255);
+    }
+
+    _Bool is_wrap = gen_bool();
+    printf("\n>>> WBuf => Siphon (wrap: %u) %zu bytes\n", is_wrap, len);
+
+    // Source made of a small header, a wrapped payload and a trailer, as when encoding a zenoh message
+    _z_wbuf_t src = _z_wbuf_make(Z_IOSLICE_SIZE, true);
+    _z_wbuf_write(&src, 0xAA);
+    _z_wbuf_wrap_bytes(&src, payload, 0, len);
+    _z_wbuf_write(&src, 0xBB);
+    size_t total = _z_wbuf_len(&src);
+    assert(total == len + 2);
+
+    _z_wbuf_t dst = _z_wbuf_make(128, false);
+    size_t read = 0;
+    while (_z_wbuf_len(&src) > 0) {
+        _z_wbuf_reset(&dst);
+        assert(_z_wbuf_space_left(&dst) == 128);
+        _z_wbuf_write(&dst, 0xCC);  // Fragment header
+        size_t to_siphon = _z_wbuf_len(&src) < (size_t)127 ? _z_wbuf_len(&src) : (size_t)127;
+        int8_t res = is_wrap ? _z_wbuf_siphon_wrap(&dst, &src, to_siphon) : _z_wbuf_siphon(&dst, &src, to_siphon);
+        assert(res == _Z_RES_OK);
+        assert(_z_wbuf_len(&dst) == to_siphon + 1);
+        assert(_z_wbuf_get_wpos(&dst) == to_siphon + 1);
+        printf("    IOSlices: %zu, Siphoned: %zu\n", _z_wbuf_len_iosli(&dst), to_siphon);
+
+        _z_zbuf_t zbf = _z_wbuf_to_zbuf(&dst);
+        assert(_z_zbuf_read(&zbf) == 0xCC);
+        for (size_t i = 0; i < to_siphon; i++) {
+            uint8_t r = _z_zbuf_read(&zbf);
+            size_t pos = read + i;
+            if (pos == 0) {
+                assert(r == 0xAA);
+            } else if (pos == total - 1) {
+                assert(r == 0xBB);
+            } else {
+                assert(r == payload[pos - 1]);
+            }
+        }
+        _z_zbuf_clear(&zbf);
+        read = read + to_siphon;
+    }
+    assert(read == total);
+
+    // Resetting drops the wrapped ioslices and restores the full capacity
+    _z_wbuf_reset(&dst);
+    assert(_z_wbuf_len_iosli(&dst) == 1);
+    assert(_z_wbuf_space_left(&dst) == 128);
+
+    _z_wbuf_clear(&dst);
+    _z_wbuf_clear(&src);
+    free(payload);
+}
+
+void wbuf_reserve_zbuf_view(void) {
+    printf("\n>>> WBuf => Reserve and view as ZBuf\n");
+    _z_wbuf_t wbf = _z_wbuf_make(0, false);
+    assert(_z_wbuf_capacity(&wbf) == 0);
+
+    // Grow the wbuf while writing, keeping what has been written so far
+    size_t len = 1024;
+    for (size_t i = 0; i < len; i++) {
+        if (_z_wbuf_len(&wbf) == _z_wbuf_capacity(&wbf)) {
+            int8_t ret = _z_wbuf_reserve(&wbf, (_z_wbuf_capacity(&wbf) * 2) + 1);
+            assert(ret == _Z_RES_OK);
+            (void)(ret);
+        }
+        _z_wbuf_write(&wbf, (uint8_t)(i % 255));
+    }
+    assert(_z_wbuf_len_iosli(&wbf) == 1);
+    assert(_z_wbuf_len(&wbf) == len);
+
+    // The zbuf reads the content of the wbuf in place
+    _z_zbuf_t zbf = _z_wbuf_as_zbuf(&wbf);
+    assert(_z_zbuf_get_rptr(&zbf) == _z_wbuf_get_iosli(&wbf, 0)->_buf);
+    assert(_z_zbuf_len(&zbf) == len);
+    for (size_t i = 0; i < len; i++) {
+        assert(_z_zbuf_read(&zbf) == (uint8_t)(i % 255));
+    }
+
+    _z_wbuf_clear(&wbf);
+}
+
 /*=============================*/
 /*            Main             */
 /*=============================*/
@@ -564,10 +653,12 @@ int main(void) {
         wbuf_writable_readable();
         wbuf_set_pos_wbuf_get_pos();
         wbuf_add_iosli();
+        wbuf_siphon();
         // WBuf and ZBuf
         wbuf_write_zbuf_read();
         wbuf_write_zbuf_read_bytes();
         wbuf_put_zbuf_get();
+        wbuf_reserve_zbuf_view();
 
         // Reusable WBuf
         wbuf_reusable_write_zbuf_read();
@@ -67,6 +67,13 @@ int main(void) {
     assert(_z_keyexpr_intersects("x/a$*d$*e", strlen("x/a$*d$*e"), "x/ade", strlen("x/ade")));
     assert(!_z_keyexpr_intersects("x/c$*", strlen("x/c$*"), "x/abc$*", strlen("x/abc$*")));
     assert(!_z_keyexpr_intersects("x/$*d", strlen("x/$*d"), "x/$*e", strlen("x/$*e")));
+    assert(!_z_keyexpr_intersects("$*b/a/**/b", strlen("$*b/a/**/b"), "b/ab/abb", strlen("b/ab/abb")));
+    assert(!_z_keyexpr_intersects("b/ab/abb", strlen("b/ab/abb"), "$*b/a/**/b", strlen("$*b/a/**/b")));
+    assert(_z_keyexpr_intersects("$*b/a/**/b", strlen("$*b/a/**/b"), "b/a/abb/b", strlen("b/a/abb/b")));
+    assert(!_z_keyexpr_intersects("**/b/**", strlen("**/b/**"), "ab/abb", strlen("ab/abb")));
+    assert(!_z_keyexpr_intersects("b/ab", strlen("b/ab"), "**/a$*b/**/ab", strlen("**/a$*b/**/ab")));
+    assert(_z_keyexpr_intersects("**/a/**", strlen("**/a/**"), "*", strlen("*")));
+    assert(_z_keyexpr_intersects("a$*", strlen("a$*"), "**/ab/**", strlen("**/ab/**")));
     assert(_z_keyexpr_intersects("a", strlen("a"), "a", strlen("a")));
     assert(_z_keyexpr_intersects("a/b", strlen("a/b"), "a/b", strlen("a/b")));
     assert(_z_keyexpr_intersects("*", strlen("*"), "a", strlen("a")));
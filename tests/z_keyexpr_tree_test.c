@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/protocol/keyexpr.h"
+#include "zenoh-pico/protocol/keyexpr_tree.h"
+
+#define KEYS_NUM 300
+#define LOOKUPS_NUM 2000
+#define KEY_MAX_LEN 64
+
+static const char *sub_chunks[] = {"a", "b", "ab", "demo", "*", "**", "a$*", "$*b", "d$*o"};
+static const char *query_chunks[] = {"a", "b", "ab", "abb", "demo", "do", "c"};
+
+static char keys[KEYS_NUM][KEY_MAX_LEN];
+static size_t keys_len[KEYS_NUM];
+static _Bool is_inserted[KEYS_NUM];
+static size_t visits[KEYS_NUM];
+
+static size_t make_key(char *key, const char **chunks, size_t chunks_num) {
+    size_t len = 0;
+    size_t n = 1 + ((size_t)rand() % 4);
+    for (size_t i = 0; i < n; i++) {
+        const char *chunk = chunks[(size_t)rand() % chunks_num];
+        if (i > 0) {
+            key[len++] = '/';
+        }
+        (void)memcpy(&key[len], chunk, strlen(chunk));
+        len += strlen(chunk);
+    }
+    key[len] = '\0';
+    return len;
+}
+
+static void count_visit(void *value, void *arg) {
+    (void)(arg);
+    visits[(char(*)[KEY_MAX_LEN])value - keys]++;
+}
+
+static _Bool is_same_key(const void *value, const void *arg) { return value == arg; }
+
+static void check_lookups(_z_keyexpr_tree_t *tree) {
+    for (size_t l = 0; l < LOOKUPS_NUM; l++) {
+        char query[KEY_MAX_LEN];
+        size_t len = make_key(query, query_chunks, sizeof(query_chunks) / sizeof(query_chunks[0]));
+        assert(_z_keyexpr_tree_is_literal(query, len) == true);
+
+        (void)memset(visits, 0, sizeof(visits));
+        _z_keyexpr_tree_intersecting_readonly(tree, query, len, count_visit, NULL);
+        size_t readonly_visits[KEYS_NUM];
+        (void)memcpy(readonly_visits, visits, sizeof(visits));
+        (void)memset(visits, 0, sizeof(visits));
+        _z_keyexpr_tree_intersecting(tree, query, len, count_visit, NULL);
+        for (size_t i = 0; i < KEYS_NUM; i++) {
+            size_t expected = 0;
+            if ((is_inserted[i] == true) && (_z_keyexpr_intersects(keys[i], keys_len[i], query, len) == true)) {
+                expected = 1;
+            }
+            if (visits[i] != expected) {
+                printf("%s on %s: visited %zu times, expected %zu\n", keys[i], query, visits[i], expected);
+                assert(false);
+            }
+            // The read-only lookup may visit a value several times, but visits the same ones
+            assert((readonly_visits[i] > 0) == (expected > 0));
+        }
+    }
+}
+
+int main(void) {
+    srand(42);
+
+    _z_keyexpr_tree_t tree = _z_keyexpr_tree_make();
+    size_t inserted = 0;
+    for (size_t i = 0; i < KEYS_NUM; i++) {
+        keys_len[i] = make_key(keys[i], sub_chunks, sizeof(sub_chunks) / sizeof(sub_chunks[0]));
+        // Only canon key expressions are declared, e.g. not ``**/**`` nor ``**/*``
+        if (_z_keyexpr_is_canon(keys[i], keys_len[i]) == Z_KEYEXPR_CANON_SUCCESS) {
+            assert(_z_keyexpr_tree_insert(&tree, keys[i], keys_len[i], keys[i]) == 0);
+            is_inserted[i] = true;
+            inserted++;
+        }
+    }
+    assert(tree._len == inserted);
+    printf("Looking up %zu keys among %zu key expressions\n", (size_t)LOOKUPS_NUM, inserted);
+    check_lookups(&tree);
+
+    // Remove every other key expression, some of them being duplicates of the remaining ones
+    for (size_t i = 0; i < KEYS_NUM; i += 2) {
+        if (is_inserted[i] == true) {
+            _z_keyexpr_tree_remove(&tree, keys[i], keys_len[i], is_same_key, keys[i]);
+            is_inserted[i] = false;
+            inserted--;
+        }
+    }
+    assert(tree._len == inserted);
+    printf("Looking up %zu keys among %zu key expressions\n", (size_t)LOOKUPS_NUM, inserted);
+    check_lookups(&tree);
+
+    // Removing what is not in the tree has no effect
+    _z_keyexpr_tree_remove(&tree, "not/inserted", strlen("not/inserted"), is_same_key, keys[0]);
+    _z_keyexpr_tree_remove(&tree, keys[1], keys_len[1], is_same_key, keys[0]);
+    assert(tree._len == inserted);
+
+    for (size_t i = 1; i < KEYS_NUM; i += 2) {
+        if (is_inserted[i] == true) {
+            _z_keyexpr_tree_remove(&tree, keys[i], keys_len[i], is_same_key, keys[i]);
+            is_inserted[i] = false;
+        }
+    }
+    assert(tree._len == 0);
+    check_lookups(&tree);
+
+    _z_keyexpr_tree_clear(&tree);
+
+    return 0;
+}
@@ -1266,6 +1266,42 @@ void data_message(void) {
     _z_wbuf_clear(&wbf);
 }
 
+void data_message_prefix(void) {
+    printf("\n>> Data message with encoded prefix\n");
+    _z_wbuf_t wbf = gen_wbuf(65535);
+
+    // Initialize
+    _z_zenoh_message_t z_msg = gen_data_message();
+    _z_msg_data_t e_da = z_msg._body._data;
+
+    // Encode the prefix apart, then the message from it
+    _z_wbuf_t pbf = gen_wbuf(65535);
+    int8_t res = _z_data_prefix_encode(&pbf, z_msg._header, &e_da);
+    assert(res == _Z_RES_OK);
+    _z_zbuf_t prefix = _z_wbuf_to_zbuf(&pbf);
+    e_da._prefix = _z_bytes_wrap(_z_zbuf_get_rptr(&prefix), _z_zbuf_len(&prefix));
+
+    res = _z_data_encode(&wbf, z_msg._header, &e_da);
+    assert(res == _Z_RES_OK);
+    (void)(res);
+
+    // Decode
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+    _z_data_result_t r_da = _z_data_decode(&zbf, z_msg._header);
+    assert(r_da._tag == _Z_RES_OK);
+
+    _z_msg_data_t d_da = r_da._value;
+    assert_eq_data_message(&e_da, &d_da, z_msg._header);
+
+    // Free
+    _z_msg_clear_data(&d_da);
+    _z_msg_clear(&z_msg);
+    _z_zbuf_clear(&zbf);
+    _z_zbuf_clear(&prefix);
+    _z_wbuf_clear(&pbf);
+    _z_wbuf_clear(&wbf);
+}
+
 /*------------------ Pull message ------------------*/
 _z_zenoh_message_t gen_pull_message(void) {
     _z_keyexpr_t key = gen_res_key();
@@ -2179,7 +2215,9 @@ _z_transport_message_t gen_frame_message(_Bool can_be_fragment) {
         }
     }
 
-    return _z_t_msg_make_frame(sn, payload, is_reliable, is_fragment, is_final);
+    _z_transport_message_t t_msg = _z_t_msg_make_frame(sn, payload, is_reliable, is_fragment, is_final);
+    t_msg._body._frame._priority = (z_priority_t)(gen_uint8() % Z_PRIORITIES_NUM);
+    return t_msg;
 }
 
 void assert_eq_frame_message(_z_t_msg_frame_t *left, _z_t_msg_frame_t *right, uint8_t header) {
@@ -2336,6 +2374,9 @@ void assert_eq_transport_message(_z_transport_message_t *left, _z_transport_mess
             assert_eq_ping_pong_message(&left->_body._ping_pong, &right->_body._ping_pong);
             break;
         case _Z_MID_FRAME:
+            // The priority is carried by a decorator, hence only checked at transport message level
+            printf("   Priority (%u:%u)\n", left->_body._frame._priority, right->_body._frame._priority);
+            assert(left->_body._frame._priority == right->_body._frame._priority);
             assert_eq_frame_message(&left->_body._frame, &right->_body._frame, left->_header);
             break;
         default:
@@ -2439,6 +2480,7 @@ _z_transport_message_t _z_frame_header(_Bool is_reliable, _Bool is_fragment, _Bo
     t_msg._attachment = NULL;
     t_msg._header = _Z_MID_FRAME;
     t_msg._body._frame._sn = sn;
+    t_msg._body._frame._priority = Z_PRIORITY_DEFAULT;
 
     if (is_reliable == true) {
         _Z_SET_FLAG(t_msg._header, _Z_FLAG_T_R);
@@ -2618,6 +2660,7 @@ int main(void) {
         // Zenoh messages
         declare_message();
         data_message();
+        data_message_prefix();
         pull_message();
         query_message();
         zenoh_message();
@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/transport/transport.h"
+
+#define PEERS_NUM 1000
+#define ADDR_LEN 6  // An IPv4 address and a port
+
+// Synthetic peers: 10.0.x.y, all on the same port, as when they share a multicast group
+static _z_bytes_t make_addr(size_t i) {
+    _z_bytes_t addr = _z_bytes_make(ADDR_LEN);
+    uint8_t *p = (uint8_t *)addr.start;
+    p[0] = 10;
+    p[1] = 0;
+    p[2] = (uint8_t)(i >> 8);
+    p[3] = (uint8_t)i;
+    p[4] = 0x1d;
+    p[5] = 0x27;
+    return addr;
+}
+
+static _z_transport_peer_entry_t *make_peer(size_t i) {
+    _z_transport_peer_entry_t *entry = (_z_transport_peer_entry_t *)z_malloc(sizeof(_z_transport_peer_entry_t));
+    (void)memset(entry, 0, sizeof(_z_transport_peer_entry_t));
+    entry->_dbuf_reliable = _z_wbuf_make(0, false);
+    entry->_dbuf_best_effort = _z_wbuf_make(0, false);
+    entry->_remote_addr = make_addr(i);
+    entry->_remote_pid = _z_bytes_make(sizeof(size_t));
+    (void)memcpy((uint8_t *)entry->_remote_pid.start, &i, sizeof(size_t));
+    entry->_lease = i;
+    return entry;
+}
+
+static size_t peer_index(const _z_transport_peer_entry_t *entry) {
+    size_t i;
+    (void)memcpy(&i, entry->_remote_pid.start, sizeof(size_t));
+    return i;
+}
+
+static _Bool is_present(size_t i) { return ((i % 3) != 0) && ((i % 2) != 0); }
+
+static _Bool keep_odd(_z_transport_peer_entry_t *entry) { return (peer_index(entry) % 2) != 0; }
+
+static void check_peers(const _z_transport_peer_table_t *table, _Bool (*present)(size_t)) {
+    size_t expected = 0;
+    for (size_t i = 0; i < PEERS_NUM; i++) {
+        _z_bytes_t addr = make_addr(i);
+        _z_transport_peer_entry_t *entry = _z_transport_peer_table_get(table, &addr);
+        if (present(i) == true) {
+            assert(entry != NULL);
+            assert(peer_index(entry) == i);
+            expected++;
+        } else {
+            assert(entry == NULL);
+        }
+        _z_bytes_clear(&addr);
+    }
+    assert(_z_transport_peer_table_len(table) == expected);
+
+    size_t visited = 0;
+    size_t pos = 0;
+    for (_z_transport_peer_entry_t *entry = _z_transport_peer_table_next(table, &pos); entry != NULL;
+         entry = _z_transport_peer_table_next(table, &pos)) {
+        assert(present(peer_index(entry)) == true);
+        visited++;
+    }
+    assert(visited == expected);
+}
+
+static _Bool all(size_t i) {
+    (void)(i);
+    return true;
+}
+
+static _Bool none(size_t i) {
+    (void)(i);
+    return false;
+}
+
+static _Bool not_third(size_t i) { return (i % 3) != 0; }
+
+int main(void) {
+    _z_transport_peer_table_t table = _z_transport_peer_table_make();
+    check_peers(&table, none);
+
+    printf(">>> insert %d peers\n", PEERS_NUM);
+    for (size_t i = 0; i < PEERS_NUM; i++) {
+        int8_t res = _z_transport_peer_table_insert(&table, make_peer(i));
+        assert(res == _Z_RES_OK);
+        (void)(res);
+    }
+    assert(table._len * 4 <= table._capacity * 3);
+    check_peers(&table, all);
+
+    printf(">>> remove a third of them\n");
+    for (size_t i = 0; i < PEERS_NUM; i += 3) {
+        _z_bytes_t addr = make_addr(i);
+        _z_transport_peer_table_remove(&table, _z_transport_peer_table_get(&table, &addr));
+        _z_bytes_clear(&addr);
+    }
+    check_peers(&table, not_third);
+
+    printf(">>> expire the even ones\n");
+    _z_transport_peer_table_retain(&table, keep_odd);
+    check_peers(&table, is_present);
+
+    printf(">>> insert them again\n");
+    for (size_t i = 0; i < PEERS_NUM; i++) {
+        if (is_present(i) == false) {
+            int8_t res = _z_transport_peer_table_insert(&table, make_peer(i));
+        assert(res == _Z_RES_OK);
+        (void)(res);
+        }
+    }
+    check_peers(&table, all);
+
+    _z_transport_peer_table_clear(&table);
+    check_peers(&table, none);
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Measures the throughput of large, hence fragmented, payloads over a multicast transport.
+// Usage: z_perf_multicast_fragment <locator> [payload size in bytes] [number of messages]
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "zenoh-pico.h"
+
+#define PAYLOAD_LEN 262144
+#define MSG 1000
+#define SLEEP 1
+
+const char *keyexpr = "test/perf/fragment";
+
+volatile size_t received_bytes = 0;
+volatile unsigned int received = 0;
+void data_handler(const z_sample_t *sample, void *arg) {
+    (void)(arg);
+    received_bytes = received_bytes + sample->payload.len;
+    received++;
+}
+
+int main(int argc, char **argv) {
+    setvbuf(stdout, NULL, _IOLBF, 1024);
+
+    assert(argc >= 2);
+    size_t len = (argc > 2) ? (size_t)strtoul(argv[2], NULL, 10) : PAYLOAD_LEN;
+    unsigned int msgs = (argc > 3) ? (unsigned int)strtoul(argv[3], NULL, 10) : MSG;
+
+    z_owned_config_t config = z_config_default();
+    zp_config_insert(z_loan(config), Z_CONFIG_MODE_KEY, z_string_make("peer"));
+    zp_config_insert(z_loan(config), Z_CONFIG_PEER_KEY, z_string_make(argv[1]));
+    z_owned_session_t s1 = z_open(z_move(config));
+    assert(z_check(s1));
+    zp_start_read_task(z_loan(s1), NULL);
+    zp_start_lease_task(z_loan(s1), NULL);
+
+    config = z_config_default();
+    zp_config_insert(z_loan(config), Z_CONFIG_MODE_KEY, z_string_make("peer"));
+    zp_config_insert(z_loan(config), Z_CONFIG_PEER_KEY, z_string_make(argv[1]));
+    z_owned_session_t s2 = z_open(z_move(config));
+    assert(z_check(s2));
+    zp_start_read_task(z_loan(s2), NULL);
+    zp_start_lease_task(z_loan(s2), NULL);
+
+    z_owned_closure_sample_t callback = z_closure(data_handler, NULL, NULL);
+    z_owned_subscriber_t sub = z_declare_subscriber(z_loan(s2), z_keyexpr(keyexpr), z_move(callback), NULL);
+    assert(z_check(sub));
+
+    z_sleep_s(SLEEP * 3);
+
+    uint8_t *payload = (uint8_t *)z_malloc(len);
+    memset(payload, 1, len);
+    z_put_options_t opt = z_put_options_default();
+    opt.congestion_control = Z_CONGESTION_CONTROL_BLOCK;
+
+    printf("Sending %u messages of %zu bytes on %s\n", msgs, len, argv[1]);
+    z_clock_t start = z_clock_now();
+    for (unsigned int n = 0; n < msgs; n++) {
+        int8_t res = z_put(z_loan(s1), z_keyexpr(keyexpr), payload, len, &opt);
+        if (res < 0) {
+            printf("Put %u of %zu bytes failed with %d\n", n, len, res);
+            abort();
+        }
+    }
+    unsigned long elapsed = z_clock_elapsed_us(&start);
+
+    z_sleep_s(SLEEP);
+
+    double sent_mb = ((double)len * (double)msgs) / (1024.0 * 1024.0);
+    double received_mb = (double)received_bytes / (1024.0 * 1024.0);
+    double secs = (double)elapsed / 1000000.0;
+    printf("TX: %.2f MB in %.3f s => %.2f MB/s\n", sent_mb, secs, sent_mb / secs);
+    printf("RX: %u/%u messages, %.2f MB => %.2f MB/s\n", received, msgs, received_mb, received_mb / secs);
+
+    z_undeclare_subscriber(z_move(sub));
+
+    zp_stop_read_task(z_loan(s1));
+    zp_stop_lease_task(z_loan(s1));
+    zp_stop_read_task(z_loan(s2));
+    zp_stop_lease_task(z_loan(s2));
+
+    z_close(z_move(s1));
+    z_close(z_move(s2));
+
+    z_free(payload);
+
+    return 0;
+}
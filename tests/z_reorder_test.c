@@ -0,0 +1,356 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/net/resource.h"
+#include "zenoh-pico/protocol/msgcodec.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/link/rx.h"
+#include "zenoh-pico/transport/transport.h"
+#include "zenoh-pico/utils/pointers.h"
+
+#if (Z_RX_REORDER_WINDOW > 0) && (Z_UNICAST_TRANSPORT == 1)
+
+#define KEY "demo/example/reorder"
+#define MTU 1500
+#define FRAG_MSG_LEN (2 * MTU)
+#define RECEIVED_MAX 64
+
+/*=============================*/
+/*         Dummy link          */
+/*=============================*/
+void dummy_close(_z_link_t *self) { (void)(self); }
+
+void dummy_free(_z_link_t *self) { (void)(self); }
+
+size_t dummy_write(const _z_link_t *self, const uint8_t *ptr, size_t len) {
+    (void)(self);
+    (void)(ptr);
+    return len;
+}
+
+size_t dummy_writev(const _z_link_t *self, const _z_wbuf_t *wbf) {
+    (void)(self);
+    return _z_wbuf_len(wbf);
+}
+
+_z_link_t *dummy_link_new(void) {
+    _z_link_t *zl = (_z_link_t *)z_malloc(sizeof(_z_link_t));
+    (void)memset(zl, 0, sizeof(_z_link_t));
+    zl->_close_f = dummy_close;
+    zl->_free_f = dummy_free;
+    zl->_write_f = dummy_write;
+    zl->_write_all_f = dummy_write;
+    zl->_writev_f = dummy_writev;
+    zl->_mtu = MTU;
+    zl->_capabilities = Z_LINK_CAPABILITY_RELIEABLE;
+    return zl;
+}
+
+/*=============================*/
+/*         Reception           */
+/*=============================*/
+_z_transport_unicast_t *ztu = NULL;
+
+// The first payload byte and the length of the samples received, in order
+uint8_t received[RECEIVED_MAX];
+size_t received_len[RECEIVED_MAX];
+size_t received_num = 0;
+
+void on_sample(const z_sample_t *sample, void *arg) {
+    (void)(arg);
+    assert(received_num < (size_t)RECEIVED_MAX);
+    received[received_num] = sample->payload.start[0];
+    received_len[received_num] = sample->payload.len;
+    received_num++;
+}
+
+// Checks that the samples received since the last check carry the given IDs, in this order
+void expect(const uint8_t *ids, size_t n) {
+    if ((received_num != n) || ((n > (size_t)0) && (memcmp(received, ids, n) != 0))) {
+        printf("  - Received %zu samples:", received_num);
+        for (size_t i = 0; i < received_num; i++) {
+            printf(" %u", received[i]);
+        }
+        printf(", expected %zu\n", n);
+        assert(false);
+    }
+    received_num = 0;
+}
+
+// Returns the SN following the last one handled on the reliable channel by the given offset
+_z_zint_t sn_after(_z_zint_t offset) {
+    return (ztu->_rx_conduits[0]._sn_reliable + offset) % ztu->_sn_resolution;
+}
+
+// Decodes and handles a transport message, as the read task does once it has been received from the link
+void receive(_z_wbuf_t *wbf) {
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(wbf);
+    _z_transport_message_result_t r;
+    _z_transport_message_decode_ar(&zbf, &ztu->_arena, &r);
+    assert(r._tag == _Z_RES_OK);
+    int8_t ret = _z_unicast_handle_transport_message(ztu, &r._value);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+    _z_t_msg_clear_ar(&r._value, &ztu->_arena);
+    _z_zbuf_clear(&zbf);
+}
+
+// Receives a reliable frame carrying a sample whose payload is the given ID
+void receive_frame(_z_zint_t sn, uint8_t id) {
+    _z_wbuf_t wbf = _z_wbuf_make(Z_BATCH_SIZE_RX, false);
+    _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, true, false, false);
+    int8_t ret = _z_transport_message_encode(&wbf, &t_msg);
+    assert(ret == _Z_RES_OK);
+    _z_data_info_t info;
+    (void)memset(&info, 0, sizeof(info));
+    _z_zenoh_message_t z_msg =
+        _z_msg_make_data(_z_rid_with_suffix(Z_RESOURCE_ID_NONE, KEY), info, _z_bytes_wrap(&id, 1), false);
+    ret = _z_zenoh_message_encode(&wbf, &z_msg);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+    receive(&wbf);
+    _z_wbuf_clear(&wbf);
+}
+
+// Receives the given fragment of a reliable message, its fragments being of one MTU
+void receive_fragment(_z_zint_t sn, const _z_zbuf_t *msg, size_t idx) {
+    size_t pos = idx * (size_t)MTU;
+    size_t len = ((_z_zbuf_len(msg) - pos) < (size_t)MTU) ? (_z_zbuf_len(msg) - pos) : (size_t)MTU;
+    _z_frame_payload_t payload;
+    payload._fragment = _z_bytes_wrap(_z_cptr_u8_offset(_z_zbuf_get_rptr(msg), (ptrdiff_t)pos), len);
+    _z_transport_message_t t_msg = _z_t_msg_make_frame(sn, payload, true, true, (pos + len) == _z_zbuf_len(msg));
+
+    _z_wbuf_t wbf = _z_wbuf_make(Z_BATCH_SIZE_RX, false);
+    int8_t ret = _z_transport_message_encode(&wbf, &t_msg);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+    receive(&wbf);
+    _z_wbuf_clear(&wbf);
+}
+
+// Receives a keep alive message, on which the frames held back for too long are handled
+void receive_keep_alive(void) {
+    _z_wbuf_t wbf = _z_wbuf_make(Z_BATCH_SIZE_RX, false);
+    _z_transport_message_t t_msg = _z_t_msg_make_keep_alive(_z_bytes_empty());
+    int8_t ret = _z_transport_message_encode(&wbf, &t_msg);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+    receive(&wbf);
+    _z_wbuf_clear(&wbf);
+}
+
+// Encodes a sample whose payload, made of the given ID, spans several fragments
+_z_zbuf_t fragmented_msg_make(uint8_t id) {
+    uint8_t *payload = (uint8_t *)malloc(FRAG_MSG_LEN);
+    (void)memset(payload, id, FRAG_MSG_LEN);
+    _z_data_info_t info;
+    (void)memset(&info, 0, sizeof(info));
+    _z_zenoh_message_t z_msg = _z_msg_make_data(_z_rid_with_suffix(Z_RESOURCE_ID_NONE, KEY), info,
+                                                _z_bytes_wrap(payload, FRAG_MSG_LEN), false);
+    _z_wbuf_t wbf = _z_wbuf_make(Z_IOSLICE_SIZE, true);
+    int8_t ret = _z_zenoh_message_encode(&wbf, &z_msg);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+    _z_wbuf_clear(&wbf);
+    free(payload);
+    return zbf;
+}
+
+// Encodes a message whose last fragment, of one MTU, would also be decoded as a complete sample with the given ID
+_z_zbuf_t tail_msg_make(uint8_t id) {
+    _z_data_info_t info;
+    (void)memset(&info, 0, sizeof(info));
+    _z_zenoh_message_t z_msg =
+        _z_msg_make_data(_z_rid_with_suffix(Z_RESOURCE_ID_NONE, KEY), info, _z_bytes_wrap(&id, 1), false);
+    _z_wbuf_t wbf = _z_wbuf_make(Z_IOSLICE_SIZE, true);
+    for (size_t i = 0; i < (size_t)(2 * MTU); i++) {
+        int8_t ret = _z_wbuf_write(&wbf, 0);
+        assert(ret == _Z_RES_OK);
+        (void)(ret);
+    }
+    int8_t ret = _z_zenoh_message_encode(&wbf, &z_msg);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+    _z_wbuf_clear(&wbf);
+    return zbf;
+}
+
+/*=============================*/
+/*            Tests            */
+/*=============================*/
+void in_order_release(void) {
+    printf(">>> In order release\n");
+    _z_zint_t sn1 = sn_after(1);
+    _z_zint_t sn2 = sn_after(2);
+    _z_zint_t sn3 = sn_after(3);
+
+    receive_frame(sn3, 3);
+    receive_frame(sn2, 2);
+    expect(NULL, 0);
+    receive_frame(sn1, 1);
+    expect((uint8_t[]){1, 2, 3}, 3);
+    assert(ztu->_rx_conduits[0]._sn_reliable == sn3);
+    assert(ztu->_rx_conduits[0]._reorder_reliable._len == (size_t)0);
+}
+
+void duplicates(void) {
+    printf(">>> Duplicates\n");
+    _z_zint_t sn1 = sn_after(1);
+    _z_zint_t sn2 = sn_after(2);
+
+    // Duplicates of a frame held back are ignored, as well as the ones of a frame already handled
+    receive_frame(sn2, 2);
+    receive_frame(sn2, 2);
+    assert(ztu->_rx_conduits[0]._reorder_reliable._len == (size_t)1);
+    receive_frame(sn1, 1);
+    receive_frame(sn1, 1);
+    receive_frame(sn2, 2);
+    expect((uint8_t[]){1, 2}, 2);
+}
+
+void overflow_skip(void) {
+    printf(">>> Overflow skip\n");
+    _z_zint_t missing = sn_after(1);
+    uint8_t ids[Z_RX_REORDER_WINDOW + 1];
+
+    // The window fills up with the frames following a missing one, which is given up on once it overflows
+    for (size_t i = 0; i < (size_t)Z_RX_REORDER_WINDOW; i++) {
+        ids[i] = (uint8_t)(i + 2);
+        receive_frame(sn_after((_z_zint_t)i + 2), ids[i]);
+    }
+    expect(NULL, 0);
+    ids[Z_RX_REORDER_WINDOW] = (uint8_t)(Z_RX_REORDER_WINDOW + 2);
+    receive_frame(sn_after(Z_RX_REORDER_WINDOW + 2), ids[Z_RX_REORDER_WINDOW]);
+    expect(ids, Z_RX_REORDER_WINDOW + 1);
+    assert(ztu->_rx_conduits[0]._reorder_reliable._len == (size_t)0);
+
+    // The missing frame is dropped if it is received afterwards
+    receive_frame(missing, 1);
+    expect(NULL, 0);
+}
+
+void timeout_expiry(void) {
+    printf(">>> Timeout expiry\n");
+    _z_zint_t missing = sn_after(1);
+    _z_zint_t sn2 = sn_after(2);
+
+    receive_frame(sn2, 2);
+    receive_keep_alive();
+    expect(NULL, 0);
+    z_sleep_ms(Z_RX_REORDER_TIMEOUT + 20);
+    receive_keep_alive();
+    expect((uint8_t[]){2}, 1);
+    assert(ztu->_rx_conduits[0]._sn_reliable == sn2);
+
+    receive_frame(missing, 1);
+    expect(NULL, 0);
+}
+
+void wraparound(void) {
+    printf(">>> SN wraparound\n");
+    ztu->_rx_conduits[0]._sn_reliable = ztu->_sn_resolution - (_z_zint_t)2;
+    _z_zint_t last = sn_after(1);  // The last SN before wrapping around
+    assert(last == ztu->_sn_resolution - (_z_zint_t)1);
+    assert(sn_after(2) == (_z_zint_t)0);
+
+    receive_frame(sn_after(3), 3);
+    receive_frame(sn_after(2), 2);
+    expect(NULL, 0);
+    receive_frame(last, 1);
+    expect((uint8_t[]){1, 2, 3}, 3);
+    assert(ztu->_rx_conduits[0]._sn_reliable == (_z_zint_t)1);
+}
+
+void fragments(void) {
+    printf(">>> Fragmented message spanning a reordered frame\n");
+    _z_zbuf_t msg = fragmented_msg_make(7);
+    assert(_z_zbuf_len(&msg) > (size_t)FRAG_MSG_LEN);
+    assert(_z_zbuf_len(&msg) <= (size_t)(3 * MTU));
+
+    // The second fragment is received after the last one, which waits for it
+    _z_zint_t sn1 = sn_after(1);
+    _z_zint_t sn2 = sn_after(2);
+    _z_zint_t sn3 = sn_after(3);
+    receive_fragment(sn1, &msg, 0);
+    receive_fragment(sn3, &msg, 2);
+    expect(NULL, 0);
+    receive_fragment(sn2, &msg, 1);
+    assert(received_len[0] == (size_t)FRAG_MSG_LEN);
+    expect((uint8_t[]){7}, 1);
+
+    // Once the second fragment is given up on, the last one must not be decoded as a complete message
+    _z_zbuf_t tail = tail_msg_make(9);
+    sn1 = sn_after(1);
+    sn3 = sn_after(3);
+    receive_fragment(sn1, &tail, 0);
+    receive_fragment(sn3, &tail, 2);
+    z_sleep_ms(Z_RX_REORDER_TIMEOUT + 20);
+    receive_keep_alive();
+    expect(NULL, 0);
+    _z_zbuf_clear(&tail);
+
+    // The following messages are received again
+    receive_frame(sn_after(1), 1);
+    expect((uint8_t[]){1}, 1);
+    _z_zbuf_clear(&msg);
+}
+
+int main(void) {
+    setvbuf(stdout, NULL, _IOLBF, 1024);
+
+    _z_session_t *zn = _z_session_init();
+    _z_transport_unicast_establish_param_t param;
+    (void)memset(&param, 0, sizeof(param));
+    param._remote_pid = _z_bytes_make(Z_ZID_LENGTH);
+    param._whatami = Z_WHATAMI_ROUTER;
+    param._sn_resolution = Z_SN_RESOLUTION;
+    param._is_qos = false;
+    param._lease = Z_TRANSPORT_LEASE;
+    zn->_tp = _z_transport_unicast_new(dummy_link_new(), param);
+    zn->_tp->_transport._unicast._session = zn;
+    zn->_tp->_transport._unicast._remote_pid = param._remote_pid;
+    ztu = &zn->_tp->_transport._unicast;
+
+    z_session_t zs = {._val = zn};
+    z_owned_closure_sample_t callback = z_closure(on_sample, NULL, NULL);
+    z_owned_subscriber_t sub = z_declare_subscriber(zs, z_keyexpr(KEY), z_move(callback), NULL);
+    assert(z_subscriber_check(&sub));
+
+    in_order_release();
+    duplicates();
+    overflow_skip();
+    timeout_expiry();
+    wraparound();
+    fragments();
+
+    z_undeclare_subscriber(z_move(sub));
+    _z_session_free(&zn);
+
+    return 0;
+}
+#else
+int main(void) {
+    printf("Frames are not reordered (Z_RX_REORDER_WINDOW is 0), skipping\n");
+    return 0;
+}
+#endif  // (Z_RX_REORDER_WINDOW > 0) && (Z_UNICAST_TRANSPORT == 1)
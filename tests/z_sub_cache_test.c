@@ -0,0 +1,232 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/net/resource.h"
+#include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/session/subscription.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/transport.h"
+
+#if (Z_SUBSCRIPTION_CACHE_SIZE > 0) && (Z_UNICAST_TRANSPORT == 1)
+
+#define KEY "demo/example/cache"
+#define OTHER_KEY "demo/example/other"
+#define PREFIX "demo/example"
+#define RID 1
+#define OTHER_RID 2
+#define PREFIX_RID 3
+#define MTU 1500
+
+/*=============================*/
+/*         Dummy link          */
+/*=============================*/
+void dummy_close(_z_link_t *self) { (void)(self); }
+
+void dummy_free(_z_link_t *self) { (void)(self); }
+
+size_t dummy_write(const _z_link_t *self, const uint8_t *ptr, size_t len) {
+    (void)(self);
+    (void)(ptr);
+    return len;
+}
+
+size_t dummy_writev(const _z_link_t *self, const _z_wbuf_t *wbf) {
+    (void)(self);
+    return _z_wbuf_len(wbf);
+}
+
+_z_link_t *dummy_link_new(void) {
+    _z_link_t *zl = (_z_link_t *)z_malloc(sizeof(_z_link_t));
+    (void)memset(zl, 0, sizeof(_z_link_t));
+    zl->_close_f = dummy_close;
+    zl->_free_f = dummy_free;
+    zl->_write_f = dummy_write;
+    zl->_write_all_f = dummy_write;
+    zl->_writev_f = dummy_writev;
+    zl->_mtu = MTU;
+    zl->_capabilities = Z_LINK_CAPABILITY_RELIEABLE;
+    return zl;
+}
+
+/*=============================*/
+/*           Helpers           */
+/*=============================*/
+_z_session_t *zn = NULL;
+
+// Counts the samples received by a subscriber, the counter being its argument
+void on_sample(const z_sample_t *sample, void *arg) {
+    (void)(sample);
+    size_t *received = (size_t *)arg;
+    *received = *received + (size_t)1;
+}
+
+z_owned_subscriber_t subscribe(const char *key, size_t *received) {
+    z_owned_closure_sample_t callback = z_closure(on_sample, NULL, received);
+    z_session_t zs = {._val = zn};
+    z_owned_subscriber_t sub = z_declare_subscriber(zs, z_keyexpr(key), z_move(callback), NULL);
+    assert(z_subscriber_check(&sub));
+    return sub;
+}
+
+void declare_resource(_z_zint_t rid, const char *key) {
+    _z_resource_t *res = (_z_resource_t *)z_malloc(sizeof(_z_resource_t));
+    res->_id = rid;
+    res->_key = _z_rname(_z_str_clone(key));
+    int8_t ret = _z_register_resource(zn, _Z_RESOURCE_IS_REMOTE, res);
+    assert(ret == _Z_RES_OK);
+    (void)(ret);
+}
+
+void undeclare_resource(_z_zint_t rid) {
+    _z_resource_t *res = _z_get_resource_by_id(zn, _Z_RESOURCE_IS_REMOTE, rid);
+    assert(res != NULL);
+    _z_unregister_resource(zn, _Z_RESOURCE_IS_REMOTE, res);
+}
+
+// Dispatches a sample keyed by the resource ID and the suffix, which fails if the resource ID is unknown
+void trigger_ret(_z_zint_t rid, const char *suffix, int8_t expected) {
+    uint8_t payload = 0;
+    _z_timestamp_t timestamp;
+    (void)memset(&timestamp, 0, sizeof(timestamp));
+    _z_keyexpr_t key = _z_rid_with_suffix(rid, suffix);
+    int8_t ret = _z_trigger_subscriptions(zn, key, _z_bytes_wrap(&payload, 1), z_encoding_default(),
+                                          Z_SAMPLE_KIND_PUT, timestamp);
+    assert(ret == expected);
+    _z_keyexpr_clear(&key);
+    (void)(ret);
+    (void)(expected);
+}
+
+void trigger(_z_zint_t rid, const char *suffix) { trigger_ret(rid, suffix, _Z_RES_OK); }
+
+// Checks that the key made of the resource ID is dispatched from a valid entry of the cache
+void assert_cached(_z_zint_t rid) {
+#if Z_SUBSCRIPTION_SNAPSHOTS == 0
+    _Bool is_cached = false;
+    for (size_t i = 0; i < (size_t)Z_SUBSCRIPTION_CACHE_SIZE; i++) {
+        _z_subscription_cache_entry_t *entry = &zn->_subscription_cache[i];
+        if ((entry->_match.ptr != NULL) && (entry->_rid == rid) && (entry->_gen == zn->_subscription_cache_gen)) {
+            is_cached = true;
+        }
+    }
+    assert(is_cached == true);
+#else
+    (void)(rid);  // Dispatched from the snapshot instead
+#endif  // Z_SUBSCRIPTION_SNAPSHOTS == 0
+}
+
+/*=============================*/
+/*            Tests            */
+/*=============================*/
+void cache_invalidation(void) {
+    size_t received = 0;
+    size_t other_received = 0;
+    size_t redeclared_received = 0;
+
+    printf(">>> Cached match\n");
+    declare_resource(RID, KEY);
+    declare_resource(OTHER_RID, OTHER_KEY);
+    declare_resource(PREFIX_RID, PREFIX);
+    z_owned_subscriber_t sub = subscribe(KEY, &received);
+    for (size_t i = 0; i < (size_t)3; i++) {
+        trigger(RID, NULL);
+        assert_cached(RID);
+    }
+    assert(received == (size_t)3);
+    trigger(PREFIX_RID, "/cache");
+    trigger(PREFIX_RID, "/other");
+    assert_cached(PREFIX_RID);
+    assert(received == (size_t)4);
+
+    printf(">>> Subscriber declared after its key got cached\n");
+    trigger(OTHER_RID, NULL);  // Caches a match without subscriptions
+    assert_cached(OTHER_RID);
+    z_owned_subscriber_t other_sub = subscribe(OTHER_KEY, &other_received);
+    trigger(OTHER_RID, NULL);
+    trigger(PREFIX_RID, "/other");
+    assert(other_received == (size_t)2);
+    assert(received == (size_t)4);
+
+    printf(">>> Subscriber undeclared after its key got cached\n");
+    trigger(RID, NULL);
+    assert_cached(RID);
+    assert(received == (size_t)5);
+    z_undeclare_subscriber(z_move(sub));
+    trigger(RID, NULL);
+    trigger(PREFIX_RID, "/cache");
+    assert(received == (size_t)5);
+
+    printf(">>> Subscriber redeclared after its key got cached\n");
+    assert_cached(RID);
+    sub = subscribe(KEY, &redeclared_received);
+    trigger(RID, NULL);
+    trigger(PREFIX_RID, "/cache");
+    assert(redeclared_received == (size_t)2);
+    assert(received == (size_t)5);
+
+    printf(">>> Resource undeclared after its key got cached\n");
+    trigger(RID, NULL);
+    assert_cached(RID);
+    assert(redeclared_received == (size_t)3);
+    undeclare_resource(RID);
+    trigger_ret(RID, NULL, _Z_ERR_DECLARE_KEYEXPR);
+    assert(redeclared_received == (size_t)3);
+
+    printf(">>> Resource redeclared with another key after its key got cached\n");
+    declare_resource(RID, OTHER_KEY);
+    trigger(RID, NULL);
+    assert_cached(RID);
+    assert(redeclared_received == (size_t)3);
+    assert(other_received == (size_t)3);
+
+    z_undeclare_subscriber(z_move(sub));
+    z_undeclare_subscriber(z_move(other_sub));
+    trigger(RID, NULL);
+    assert(other_received == (size_t)3);
+}
+
+int main(void) {
+    setvbuf(stdout, NULL, _IOLBF, 1024);
+
+    zn = _z_session_init();
+    _z_transport_unicast_establish_param_t param;
+    (void)memset(&param, 0, sizeof(param));
+    param._remote_pid = _z_bytes_make(Z_ZID_LENGTH);
+    param._whatami = Z_WHATAMI_ROUTER;
+    param._sn_resolution = Z_SN_RESOLUTION;
+    param._is_qos = false;
+    param._lease = Z_TRANSPORT_LEASE;
+    zn->_tp = _z_transport_unicast_new(dummy_link_new(), param);
+    zn->_tp->_transport._unicast._session = zn;
+    zn->_tp->_transport._unicast._remote_pid = param._remote_pid;
+
+    cache_invalidation();
+
+    _z_session_free(&zn);
+
+    return 0;
+}
+#else
+int main(void) {
+    printf("Subscriptions are not cached (Z_SUBSCRIPTION_CACHE_SIZE is 0), skipping\n");
+    return 0;
+}
+#endif  // (Z_SUBSCRIPTION_CACHE_SIZE > 0) && (Z_UNICAST_TRANSPORT == 1)